@@ -49,6 +49,15 @@ def mta(area):
 
 def debug(level):
 	GemRB.ConsoleWindowLog (level)
+
+def tlk():
+	print (GemRB.GetStringCacheStats())
+
+def prof(enable = 1):
+	GemRB.ProfileFrames (enable)
+
+def profdump(path, enable = 1):
+	GemRB.ProfileFrames (enable, path)
 	
 def cast(spellRes):
 	GemRB.SpellCast (GemRB.GameGetFirstSelectedPC (), -3, 0, spellRes)
@@ -0,0 +1,116 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "BenchCore.h"
+
+#include "../../core/Game.h"
+#include "../../core/GameData.h"
+#include "../../core/Interface.h"
+#include "../../core/InterfaceConfig.h"
+#include "../../core/Map.h"
+#include "../../core/PluginMgr.h"
+#include "../../core/SaveGameMgr.h"
+#include "../../core/TileMap.h"
+#include "../../core/Logging/Logging.h"
+#include "../../core/Video/Video.h"
+
+#include <benchmark/benchmark.h>
+#include <clocale>
+
+namespace GemRB {
+
+static Interface* benchCore = nullptr;
+
+void RequireCore()
+{
+	if (benchCore) return;
+
+	setlocale(LC_ALL, "");
+	// run from the directory of the core library, like the tests
+#if defined(WIN32) || defined(__APPLE__)
+	const char* argv[] = { "bench", "-c", "../demo/tester.cfg", "--headless" };
+#else
+	const char* argv[] = { "bench", "-c", "../../../demo/tester.cfg", "--headless" };
+#endif
+	auto cfg = LoadFromArgs(4, const_cast<char**>(argv));
+	// keep the loading chatter out of the results
+	ToggleLogging(false);
+	benchCore = new Interface(std::move(cfg));
+
+	auto gamStream = gamedata->GetResourceStream("gem-demo", IE_GAM_CLASS_ID);
+	auto gamMgr = GetImporter<SaveGameMgr>(IE_GAM_CLASS_ID, gamStream);
+	core->SetGame(gamMgr->LoadGame(new Game(), 0));
+}
+
+static void ShutdownCore()
+{
+	if (!benchCore) return;
+
+	delete core->GetGame();
+	core->SetGame(nullptr);
+	VideoDriver.reset();
+	delete benchCore;
+	benchCore = nullptr;
+}
+
+Map* MakeSyntheticArea(const Size& cells, bool maze)
+{
+	RequireCore();
+
+	TileMap* tm = new TileMap();
+	tm->XCellCount = cells.w;
+	tm->YCellCount = cells.h;
+
+	// same layout as the areas loaded by AREImporter
+	const Size propSize(cells.w * 4, CeilDiv(cells.h * 64, 12));
+	TileProps props(VideoDriver->CreateSprite(Region(Point(), propSize), nullptr, TileProps::pixelFormat));
+
+	// walls every 16 cells, with a gap at alternating ends
+	constexpr int spacing = 16;
+	constexpr int gap = 6;
+	SearchmapPoint p;
+	for (p.y = 0; p.y < propSize.h; ++p.y) {
+		for (p.x = 0; p.x < propSize.w; ++p.x) {
+			bool wall = false;
+			if (maze && p.x % spacing >= spacing - 2) {
+				bool gapAtTop = (p.x / spacing) % 2;
+				wall = gapAtTop ? p.y >= gap : p.y < propSize.h - gap;
+			}
+			PathMapFlags flags = wall ? PathMapFlags::IMPASSABLE : PathMapFlags::PASSABLE;
+			props.SetTileProp(p, TileProps::Property::SEARCH_MAP, uint8_t(flags));
+			props.SetTileProp(p, TileProps::Property::ELEVATION, TileProps::defaultElevation);
+		}
+	}
+
+	return new Map(tm, std::move(props), nullptr);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	GemRB::ShutdownCore();
+	return 0;
+}
@@ -0,0 +1,38 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#ifndef BENCHCORE_H
+#define BENCHCORE_H
+
+namespace GemRB {
+
+class Map;
+class Size;
+
+// Starts the core on the demo data the first time it is called, like the
+// map tests do. Only the benchmarks that need plugins or a game pay for it.
+void RequireCore();
+
+// An area with no overlays, only a searchmap of the given size in tiles.
+// With a maze, the walls force long detours between the left and the right.
+Map* MakeSyntheticArea(const Size& cells, bool maze);
+
+}
+
+#endif
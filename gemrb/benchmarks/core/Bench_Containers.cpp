@@ -0,0 +1,109 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "../../core/LRUCache.h"
+#include "../../core/Strings/StringMap.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace GemRB {
+
+// the size of a typical variable dictionary
+static constexpr int KEY_COUNT = 2000;
+
+static std::vector<std::string> MakeKeys(const char* prefix)
+{
+	std::vector<std::string> keys;
+	keys.reserve(KEY_COUNT);
+	for (int i = 0; i < KEY_COUNT; ++i) {
+		keys.push_back(fmt::format("{}{}", prefix, i));
+	}
+	return keys;
+}
+
+static void BM_StringMapLookup(benchmark::State& state)
+{
+	StringMap<int> map;
+	std::vector<std::string> keys = MakeKeys("GLOBALVAR_");
+	for (int i = 0; i < KEY_COUNT; ++i) {
+		map.Set(keys[i], i);
+	}
+	// half of them differ in case, half don't exist at all
+	std::vector<std::string> lookups = MakeKeys("globalvar_");
+	std::vector<std::string> misses = MakeKeys("LOCALVAR_");
+	lookups.insert(lookups.end(), misses.begin(), misses.end());
+
+	for (auto _ : state) {
+		for (const std::string& key : lookups) {
+			benchmark::DoNotOptimize(map.Get(key, -1));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * lookups.size());
+}
+BENCHMARK(BM_StringMapLookup);
+
+static void BM_StringMapSet(benchmark::State& state)
+{
+	std::vector<std::string> keys = MakeKeys("GLOBALVAR_");
+	for (auto _ : state) {
+		StringMap<int> map;
+		for (int i = 0; i < KEY_COUNT; ++i) {
+			map.Set(keys[i], i);
+		}
+		benchmark::DoNotOptimize(map);
+	}
+	state.SetItemsProcessed(state.iterations() * KEY_COUNT);
+}
+BENCHMARK(BM_StringMapSet);
+
+struct BenchCacheEntry {
+	int value;
+
+	explicit BenchCacheEntry(int value)
+		: value(value) {}
+	void evictionNotice() const {}
+};
+
+struct BenchCacheEvict {
+	bool operator()(const BenchCacheEntry&) const { return true; }
+};
+
+// a cache smaller than the working set, like the sound cache during battles
+static void BM_LRUCacheChurn(benchmark::State& state)
+{
+	LRUCache<BenchCacheEntry, BenchCacheEvict> cache(size_t(state.range(0)));
+	std::vector<std::string> keys = MakeKeys("SOUND");
+	std::mt19937 gen(1234);
+
+	for (auto _ : state) {
+		// half of the requests go to a few popular entries, so both hits and evictions happen
+		size_t idx = gen() % 2 ? gen() % 32 : gen() % KEY_COUNT;
+		const std::string& key = keys[idx];
+		if (!cache.Touch(key)) {
+			cache.SetAt(key, int(idx));
+		}
+		benchmark::DoNotOptimize(cache.Lookup(key));
+	}
+}
+BENCHMARK(BM_LRUCacheChurn)->Arg(64)->Arg(1024);
+
+}
@@ -0,0 +1,111 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "ie_types.h"
+
+#include "../../core/Streams/MemoryStream.h"
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+
+namespace GemRB {
+
+static constexpr size_t STREAM_SIZE = 64 * 1024;
+
+static std::unique_ptr<MemoryStream> MakeStream(bool text)
+{
+	std::mt19937 gen(1234);
+	char* data = static_cast<char*>(malloc(STREAM_SIZE));
+	for (size_t i = 0; i < STREAM_SIZE; ++i) {
+		if (text) {
+			// lines of 2da like fields
+			data[i] = i % 48 == 47 ? '\n' : (i % 8 == 7 ? ' ' : char('A' + gen() % 26));
+		} else {
+			data[i] = char(gen());
+		}
+	}
+	return std::make_unique<MemoryStream>("bench", data, STREAM_SIZE);
+}
+
+template<typename T>
+static void BM_ReadScalar(benchmark::State& state)
+{
+	auto stream = MakeStream(false);
+	T value;
+	for (auto _ : state) {
+		stream->Rewind();
+		for (size_t i = 0; i < STREAM_SIZE / sizeof(T); ++i) {
+			stream->ReadScalar(value);
+			benchmark::DoNotOptimize(value);
+		}
+	}
+	state.SetBytesProcessed(state.iterations() * STREAM_SIZE);
+}
+BENCHMARK_TEMPLATE(BM_ReadScalar, uint8_t);
+BENCHMARK_TEMPLATE(BM_ReadScalar, uint16_t);
+BENCHMARK_TEMPLATE(BM_ReadScalar, uint32_t);
+
+static void BM_ReadResRef(benchmark::State& state)
+{
+	auto stream = MakeStream(true);
+	ResRef ref;
+	for (auto _ : state) {
+		stream->Rewind();
+		for (size_t i = 0; i < STREAM_SIZE / 8; ++i) {
+			stream->ReadResRef(ref);
+			benchmark::DoNotOptimize(ref);
+		}
+	}
+	state.SetBytesProcessed(state.iterations() * STREAM_SIZE);
+}
+BENCHMARK(BM_ReadResRef);
+
+static void BM_ReadPoint(benchmark::State& state)
+{
+	auto stream = MakeStream(false);
+	Point point;
+	for (auto _ : state) {
+		stream->Rewind();
+		for (size_t i = 0; i < STREAM_SIZE / 4; ++i) {
+			stream->ReadPoint(point);
+			benchmark::DoNotOptimize(point);
+		}
+	}
+	state.SetBytesProcessed(state.iterations() * STREAM_SIZE);
+}
+BENCHMARK(BM_ReadPoint);
+
+static void BM_ReadLine(benchmark::State& state)
+{
+	auto stream = MakeStream(true);
+	std::string line;
+	for (auto _ : state) {
+		stream->Rewind();
+		while (stream->ReadLine(line) != DataStream::Error) {
+			benchmark::DoNotOptimize(line);
+		}
+	}
+	state.SetBytesProcessed(state.iterations() * STREAM_SIZE);
+}
+BENCHMARK(BM_ReadLine);
+
+}
@@ -0,0 +1,122 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "BenchCore.h"
+
+#include "../../core/Map.h"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace GemRB {
+
+// the argument is the area size in tiles, the demo areas are around 40x30
+static Size AreaSize(const benchmark::State& state)
+{
+	return Size(int(state.range(0)), int(state.range(0)) * 3 / 4);
+}
+
+// from the top left to the bottom right corner
+static void FindPathCorners(benchmark::State& state, bool maze, bool hierarchical = false)
+{
+	std::unique_ptr<Map> map(MakeSyntheticArea(AreaSize(state), maze));
+	// the cluster graph is built up front, so only the searches are timed
+	map->SetHierarchicalPathfinding(hierarchical);
+	const Size& size = map->tileProps.GetSize();
+	Point start = SearchmapPoint(2, 2).ToNavmapPoint();
+	Point goal = SearchmapPoint(size.w - 3, size.h - 3).ToNavmapPoint();
+
+	size_t steps = 0;
+	for (auto _ : state) {
+		Path path = map->FindPath(start, goal, 2, 0, PF_SIGHT);
+		steps = path.Size();
+		benchmark::DoNotOptimize(path);
+	}
+	if (!steps) {
+		state.SkipWithError("No path found");
+	}
+	state.counters["steps"] = double(steps);
+}
+
+static void BM_FindPathOpen(benchmark::State& state)
+{
+	FindPathCorners(state, false);
+}
+BENCHMARK(BM_FindPathOpen)->Arg(16)->Arg(48)->Unit(benchmark::kMicrosecond);
+
+static void BM_FindPathMaze(benchmark::State& state)
+{
+	FindPathCorners(state, true);
+}
+BENCHMARK(BM_FindPathMaze)->Arg(16)->Arg(48)->Unit(benchmark::kMicrosecond);
+
+// the same searches as above through the cluster graph, the steps show the detours it takes
+static void BM_FindPathOpenHierarchical(benchmark::State& state)
+{
+	FindPathCorners(state, false, true);
+}
+BENCHMARK(BM_FindPathOpenHierarchical)->Arg(16)->Arg(48)->Unit(benchmark::kMicrosecond);
+
+static void BM_FindPathMazeHierarchical(benchmark::State& state)
+{
+	FindPathCorners(state, true, true);
+}
+BENCHMARK(BM_FindPathMazeHierarchical)->Arg(16)->Arg(48)->Unit(benchmark::kMicrosecond);
+
+// GetBlockedInLine itself is private, so this goes through IsVisibleLOS. The
+// lines cycle through more pairs than the line cache holds, so nearly every
+// check is a cache miss and has to walk the searchmap.
+static void BM_GetBlockedInLine(benchmark::State& state)
+{
+	std::unique_ptr<Map> map(MakeSyntheticArea(AreaSize(state), state.range(1) != 0));
+	const Size& size = map->tileProps.GetSize();
+	std::vector<Point> starts;
+	std::vector<Point> ends;
+	for (int y = 1; y < size.h - 1; y += std::max(1, size.h / 96)) {
+		starts.push_back(SearchmapPoint(1, y).ToNavmapPoint());
+		ends.push_back(SearchmapPoint(size.w - 2, size.h - 1 - y).ToNavmapPoint());
+	}
+
+	size_t line = 0;
+	for (auto _ : state) {
+		const Point& start = starts[line % starts.size()];
+		const Point& end = ends[(line / starts.size()) % ends.size()];
+		benchmark::DoNotOptimize(map->IsVisibleLOS(start, end, nullptr));
+		++line;
+	}
+	state.counters["lines"] = double(starts.size() * ends.size());
+}
+BENCHMARK(BM_GetBlockedInLine)->Args({ 16, 0 })->Args({ 48, 0 })->Args({ 48, 1 });
+
+static void BM_ExploreMapChunk(benchmark::State& state)
+{
+	std::unique_ptr<Map> map(MakeSyntheticArea(Size(48, 36), true));
+	const Size& size = map->tileProps.GetSize();
+	SearchmapPoint center(size.w / 2, size.h / 2);
+	int range = int(state.range(0));
+
+	for (auto _ : state) {
+		map->ExploreMapChunk(center, range, 1);
+	}
+}
+BENCHMARK(BM_ExploreMapChunk)->Arg(15)->Arg(30);
+
+}
@@ -0,0 +1,132 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "BenchCore.h"
+
+#include "../../core/Game.h"
+#include "../../core/Interface.h"
+#include "../../core/SaveGameIterator.h"
+#include "../../core/Streams/FileStream.h"
+#include "../../core/System/VFS.h"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace GemRB {
+
+static path_t TempPath()
+{
+#ifdef WIN32
+	const char* tmpDir = getenv("TEMP");
+#else
+	const char* tmpDir = getenv("TMPDIR");
+	if (!tmpDir) {
+		tmpDir = getenv("TMP");
+	}
+#endif
+	return tmpDir ? tmpDir : "/tmp";
+}
+
+static void RemoveSubdirectories(const path_t& path)
+{
+	std::vector<path_t> subdirs;
+	DirectoryIterator dir(path);
+	dir.SetFlags(DirectoryIterator::Directories);
+	if (dir) {
+		do {
+			subdirs.push_back(dir.GetFullPath());
+		} while (++dir);
+	}
+	for (const auto& subdir : subdirs) {
+		DelTree(subdir, false);
+		RemoveDirectory(subdir);
+	}
+}
+
+// A quicksave late in a game: the current area is swapped out and written
+// together with 100 visited areas already in the cache, then the game and
+// the worldmap follow, just like a save from the GUI. The cache and the
+// saves live in a private directory, so nothing else sees them.
+static void BM_QuickSave(benchmark::State& state)
+{
+	RequireCore();
+	const int areaCount = int(state.range(0));
+	constexpr size_t areaSize = 96 * 1024;
+
+	path_t oldCachePath = core->config.CachePath;
+	path_t oldSavePath = core->config.SavePath;
+	path_t root = PathJoin(TempPath(), "gemrb-bench-save");
+	core->config.CachePath = PathJoin(root, "cache");
+	core->config.SavePath = PathJoin(root, "saves");
+	if (!MakeDirectories(core->config.CachePath) || !MakeDirectories(core->config.SavePath)) {
+		core->config.CachePath = oldCachePath;
+		core->config.SavePath = oldSavePath;
+		state.SkipWithError("Cannot create the temporary directories");
+		return;
+	}
+
+	// the full game, since the save needs the worldmap too
+	core->LoadGame(nullptr, 0);
+	core->GetGame()->GetMap(ResRef("ar0100"), false);
+
+	// somewhat compressible, like real areas with their tiles and actors
+	std::vector<char> contents(areaSize);
+	uint32_t seed = 1;
+	for (size_t i = 0; i < areaSize; ++i) {
+		seed = seed * 1103515245 + 12345;
+		contents[i] = (seed >> 16) % 4 ? char(i / 64) : char(seed >> 24);
+	}
+	for (int i = 0; i < areaCount; ++i) {
+		FileStream area;
+		if (!area.Create(PathJoinExt(core->config.CachePath, fmt::format("bench{:03d}", i), "are"))) {
+			state.SkipWithError("Cannot create the cached areas");
+			break;
+		}
+		contents[0] = char(i);
+		area.Write(contents.data(), contents.size());
+	}
+
+	const SaveGameIterator* saves = core->GetSaveGameIterator();
+	path_t saveDir = PathJoin(core->config.SavePath, "save");
+	for (auto _ : state) {
+		if (saves->CreateSaveGame(nullptr, StringView("Bench"), true) != GEM_OK) {
+			state.SkipWithError("Saving failed");
+			break;
+		}
+		state.PauseTiming();
+		RemoveSubdirectories(saveDir);
+		state.ResumeTiming();
+	}
+	state.counters["areas"] = double(areaCount);
+
+	RemoveSubdirectories(core->config.SavePath);
+	DelTree(core->config.SavePath, false);
+	RemoveDirectory(core->config.SavePath);
+	DelTree(core->config.CachePath, false);
+	RemoveDirectory(core->config.CachePath);
+	RemoveDirectory(root);
+	core->config.CachePath = oldCachePath;
+	core->config.SavePath = oldSavePath;
+}
+// the compression runs on worker threads, so the wall clock is what counts
+BENCHMARK(BM_QuickSave)->Arg(100)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}
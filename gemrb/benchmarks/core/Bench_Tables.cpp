@@ -0,0 +1,147 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "BenchCore.h"
+
+#include "../../core/PluginMgr.h"
+#include "../../core/SymbolMgr.h"
+#include "../../core/TableMgr.h"
+#include "../../core/Streams/MemoryStream.h"
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GemRB {
+
+static std::string MakeTable(int rows, int columns)
+{
+	std::string text = "2DA V1.0\n0\n ";
+	for (int col = 0; col < columns; ++col) {
+		text += fmt::format(" COLUMN_{}", col);
+	}
+	text += '\n';
+	for (int row = 0; row < rows; ++row) {
+		text += fmt::format("ROW_{}", row);
+		for (int col = 0; col < columns; ++col) {
+			text += fmt::format(" {}", row * columns + col);
+		}
+		text += '\n';
+	}
+	return text;
+}
+
+static std::string MakeSymbols(int count)
+{
+	std::string text = fmt::format("IDS V1.0\n{}\n", count);
+	for (int i = 0; i < count; ++i) {
+		text += fmt::format("{} SYMBOL_NUMBER_{}\n", i * 3, i);
+	}
+	return text;
+}
+
+// the importers take over the stream and its buffer
+static std::unique_ptr<DataStream> MakeStream(const std::string& text)
+{
+	void* data = malloc(text.size());
+	memcpy(data, text.data(), text.size());
+	return std::make_unique<MemoryStream>("bench", data, text.size());
+}
+
+template<class T>
+static PluginHolder<T> OpenTable(PluginID id, const std::string& text)
+{
+	auto importer = MakePluginHolder<T>(id);
+	if (!importer || !importer->Open(MakeStream(text))) {
+		return nullptr;
+	}
+	return importer;
+}
+
+static void BM_2DAParse(benchmark::State& state)
+{
+	RequireCore();
+	std::string text = MakeTable(int(state.range(0)), 12);
+
+	for (auto _ : state) {
+		auto table = OpenTable<TableMgr>(IE_2DA_CLASS_ID, text);
+		benchmark::DoNotOptimize(table);
+	}
+	state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_2DAParse)->Arg(50)->Arg(500);
+
+static void BM_2DALookup(benchmark::State& state)
+{
+	RequireCore();
+	constexpr int rows = 500;
+	auto table = OpenTable<TableMgr>(IE_2DA_CLASS_ID, MakeTable(rows, 12));
+	std::vector<std::string> rowNames;
+	for (int row = 0; row < rows; row += 7) {
+		rowNames.push_back(fmt::format("row_{}", row)); // lookups ignore the case
+	}
+
+	for (auto _ : state) {
+		for (const std::string& name : rowNames) {
+			TableMgr::index_t row = table->GetRowIndex(name);
+			benchmark::DoNotOptimize(table->QueryField(row, table->GetColumnIndex("COLUMN_11")));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * rowNames.size());
+}
+BENCHMARK(BM_2DALookup);
+
+static void BM_IDSParse(benchmark::State& state)
+{
+	RequireCore();
+	std::string text = MakeSymbols(int(state.range(0)));
+
+	for (auto _ : state) {
+		auto symbols = OpenTable<SymbolMgr>(IE_IDS_CLASS_ID, text);
+		benchmark::DoNotOptimize(symbols);
+	}
+	state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_IDSParse)->Arg(50)->Arg(500);
+
+static void BM_IDSLookup(benchmark::State& state)
+{
+	RequireCore();
+	constexpr int count = 500;
+	auto symbols = OpenTable<SymbolMgr>(IE_IDS_CLASS_ID, MakeSymbols(count));
+	std::vector<std::string> names;
+	for (int i = 0; i < count; i += 7) {
+		names.push_back(fmt::format("symbol_number_{}", i));
+	}
+
+	// both directions, by name and by value
+	for (auto _ : state) {
+		for (const std::string& name : names) {
+			int value = symbols->GetValue(name);
+			benchmark::DoNotOptimize(symbols->GetValue(value));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * names.size() * 2);
+}
+BENCHMARK(BM_IDSLookup);
+
+}
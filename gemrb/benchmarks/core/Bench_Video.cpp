@@ -0,0 +1,96 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "../../core/Video/RLE.h"
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace GemRB {
+
+static constexpr colorkey_t RLE_KEY = 0;
+
+// a sprite with transparent runs of random length between the opaque ones,
+// roughly like the BAM frames of creature animations
+static std::vector<uint8_t> MakeRLEData(const Size& size)
+{
+	std::mt19937 gen(1234);
+	std::vector<uint8_t> rle;
+	int pixels = size.Area();
+	while (pixels > 0) {
+		int opaque = std::min<int>(gen() % 24, pixels);
+		for (int i = 0; i < opaque; ++i) {
+			rle.push_back(uint8_t(1 + gen() % 255));
+		}
+		pixels -= opaque;
+		if (pixels <= 0) break;
+
+		int transparent = std::min<int>(1 + gen() % 32, pixels);
+		rle.push_back(RLE_KEY);
+		rle.push_back(uint8_t(transparent - 1));
+		pixels -= transparent;
+	}
+	return rle;
+}
+
+static void BM_DecodeRLEData(benchmark::State& state)
+{
+	Size size(int(state.range(0)), int(state.range(0)));
+	std::vector<uint8_t> rle = MakeRLEData(size);
+
+	for (auto _ : state) {
+		uint8_t* pixels = DecodeRLEData(rle.data(), size, RLE_KEY);
+		benchmark::DoNotOptimize(pixels);
+		free(pixels);
+	}
+	state.SetBytesProcessed(state.iterations() * size.Area());
+}
+BENCHMARK(BM_DecodeRLEData)->Arg(64)->Arg(256);
+
+template<SHADER SHADE>
+static void BM_RGBBlendingPipeline(benchmark::State& state)
+{
+	constexpr size_t count = 64 * 1024;
+	std::mt19937 gen(1234);
+	std::vector<Color> src(count);
+	for (Color& c : src) {
+		uint32_t rnd = gen();
+		// a quarter of fully transparent pixels, which take the early exit
+		uint8_t alpha = uint8_t(rnd >> 24);
+		c = Color(uint8_t(rnd), uint8_t(rnd >> 8), uint8_t(rnd >> 16), alpha < 64 ? 0 : alpha);
+	}
+	std::vector<Color> dst(count, Color(40, 80, 120, 255));
+
+	const RGBBlendingPipeline<SHADE, true> blender(Color(200, 180, 160, 255));
+	for (auto _ : state) {
+		for (size_t i = 0; i < count; ++i) {
+			blender(src[i], dst[i], 0);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_RGBBlendingPipeline, SHADER::NONE);
+BENCHMARK_TEMPLATE(BM_RGBBlendingPipeline, SHADER::TINT);
+BENCHMARK_TEMPLATE(BM_RGBBlendingPipeline, SHADER::GREYSCALE);
+BENCHMARK_TEMPLATE(BM_RGBBlendingPipeline, SHADER::SEPIA);
+
+}
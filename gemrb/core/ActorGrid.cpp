@@ -0,0 +1,148 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "ActorGrid.h"
+
+#include "Scriptable/Actor.h"
+
+#include <algorithm>
+
+namespace GemRB {
+
+void ActorGrid::Reset(const Size& mapSize)
+{
+	gridSize.w = std::max(1, (mapSize.w + CELL_SIZE - 1) / CELL_SIZE);
+	gridSize.h = std::max(1, (mapSize.h + CELL_SIZE - 1) / CELL_SIZE);
+	cells.clear();
+	cells.resize(gridSize.Area());
+	entries.clear();
+	nextSeq = 0;
+	maxReach = 0;
+}
+
+void ActorGrid::Clear()
+{
+	for (auto& cell : cells) {
+		cell.clear();
+	}
+	entries.clear();
+	nextSeq = 0;
+	maxReach = 0;
+}
+
+// actors can wander off the map edges, so they just get clamped to the border cells
+int ActorGrid::CellIndex(const Point& p) const
+{
+	int x = Clamp(p.x / CELL_SIZE, 0, gridSize.w - 1);
+	int y = Clamp(p.y / CELL_SIZE, 0, gridSize.h - 1);
+	return y * gridSize.w + x;
+}
+
+// covers both the ground circle used by IsOver and the personal space used by PersonalDistance
+int ActorGrid::Reach(const Actor* actor)
+{
+	return std::max(16, (actor->circleSize - 1) * 16) + 1;
+}
+
+// bucket order doesn't matter, Query sorts by sequence anyway
+void ActorGrid::Unlink(int cellIdx, const Actor* actor)
+{
+	auto& cell = cells[cellIdx];
+	for (auto& candidate : cell) {
+		if (candidate.second == actor) {
+			std::swap(candidate, cell.back());
+			cell.pop_back();
+			return;
+		}
+	}
+}
+
+void ActorGrid::Insert(Actor* actor)
+{
+	if (cells.empty() || entries.count(actor)) return;
+
+	Entry& entry = entries[actor];
+	entry.cell = CellIndex(actor->Pos);
+	entry.seq = nextSeq++;
+	cells[entry.cell].emplace_back(entry.seq, actor);
+	maxReach = std::max(maxReach, Reach(actor));
+}
+
+void ActorGrid::Remove(const Actor* actor)
+{
+	auto it = entries.find(actor);
+	if (it == entries.end()) return;
+
+	Unlink(it->second.cell, actor);
+	entries.erase(it);
+}
+
+void ActorGrid::Update(Actor* actor)
+{
+	auto it = entries.find(actor);
+	if (it == entries.end()) return;
+
+	maxReach = std::max(maxReach, Reach(actor));
+	int newCell = CellIndex(actor->Pos);
+	Entry& entry = it->second;
+	if (newCell == entry.cell) return;
+
+	Unlink(entry.cell, actor);
+	entry.cell = newCell;
+	cells[newCell].emplace_back(entry.seq, actor);
+}
+
+void ActorGrid::Collect(const Region& region) const
+{
+	candidates.clear();
+	if (entries.empty()) return;
+
+	// don't trust the callers to pass normalized regions
+	int left = std::min(region.x, region.x + region.w) - maxReach;
+	int right = std::max(region.x, region.x + region.w) + maxReach;
+	int top = std::min(region.y, region.y + region.h) - maxReach;
+	int bottom = std::max(region.y, region.y + region.h) + maxReach;
+	int x1 = Clamp(left / CELL_SIZE, 0, gridSize.w - 1);
+	int y1 = Clamp(top / CELL_SIZE, 0, gridSize.h - 1);
+	int x2 = Clamp(right / CELL_SIZE, 0, gridSize.w - 1);
+	int y2 = Clamp(bottom / CELL_SIZE, 0, gridSize.h - 1);
+
+	for (int y = y1; y <= y2; ++y) {
+		for (int x = x1; x <= x2; ++x) {
+			const auto& cell = cells[y * gridSize.w + x];
+			candidates.insert(candidates.end(), cell.begin(), cell.end());
+		}
+	}
+	std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+		return a.first < b.first;
+	});
+}
+
+void ActorGrid::Query(const Region& region, std::vector<Actor*>& out) const
+{
+	out.clear();
+	Collect(region);
+	out.reserve(candidates.size());
+	for (const auto& candidate : candidates) {
+		out.push_back(candidate.second);
+	}
+}
+
+}
@@ -0,0 +1,99 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef ACTORGRID_H
+#define ACTORGRID_H
+
+#include "exports.h"
+
+#include "Region.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace GemRB {
+
+class Actor;
+
+// Uniform bucket grid over navmap coordinates, so the area's proximity
+// queries only have to look at the actors near the queried spot.
+// Every actor also gets an increasing sequence number when inserted, which
+// matches its position in Map::actors, so candidates can be returned in the
+// same order a linear scan over that vector would visit them.
+class GEM_EXPORT ActorGrid {
+public:
+	// bucket side, in navmap pixels
+	static constexpr int CELL_SIZE = 256;
+
+	void Reset(const Size& mapSize);
+
+	void Insert(Actor* actor);
+	void Remove(const Actor* actor);
+	// the actor moved or changed its circle size
+	void Update(Actor* actor);
+	void Clear();
+
+	// collects all actors that may be over or touch the region, ordered like Map::actors
+	// the callers still need to do the exact checks
+	void Query(const Region& region, std::vector<Actor*>& out) const;
+	// the first of those candidates, in the same order, that passes the check,
+	// without copying them out; the check must not query the grid itself
+	template<typename PRED>
+	Actor* FindFirst(const Region& region, PRED&& pred) const
+	{
+		Collect(region);
+		for (const auto& candidate : candidates) {
+			if (pred(candidate.second)) return candidate.second;
+		}
+		return nullptr;
+	}
+
+	size_t GetActorCount() const { return entries.size(); }
+
+private:
+	using Candidate = std::pair<uint32_t, Actor*>;
+
+	struct Entry {
+		int cell = 0;
+		uint32_t seq = 0;
+	};
+
+	Size gridSize;
+	std::vector<std::vector<Candidate>> cells;
+	std::unordered_map<const Actor*, Entry> entries;
+	uint32_t nextSeq = 0;
+	// largest distance from its position at which an indexed actor can still be hit
+	int maxReach = 0;
+
+	// reused between queries, they happen many times per tick
+	mutable std::vector<Candidate> candidates;
+
+	// fills candidates for the region, in sequence order
+	void Collect(const Region& region) const;
+	int CellIndex(const Point& p) const;
+	void Unlink(int cellIdx, const Actor* actor);
+	static int Reach(const Actor* actor);
+};
+
+}
+
+#endif
@@ -26,8 +26,18 @@
 #include "Plugin.h"
 #include "SaveGameAREExtractor.h"
 
+#include <vector>
+
 namespace GemRB {
 
+struct SaveEntry {
+	path_t path;
+	// copied as it is, like the blob of areas retained from the running save
+	bool compressed = false;
+	// where the entry starts in the archive, set once it was written
+	strpos_t offset = 0;
+};
+
 class GEM_EXPORT ArchiveImporter : public Plugin {
 public:
 	virtual int CreateArchive(DataStream* stream) = 0;
@@ -35,6 +45,8 @@ public:
 	virtual int DecompressSaveGame(DataStream* compressed, SaveGameAREExtractor&) = 0;
 	virtual int AddToSaveGame(DataStream* str, DataStream* uncompressed) = 0;
 	virtual int AddToSaveGameCompressed(DataStream* str, DataStream* compressed) = 0;
+	// adds the files in order, but compresses them in parallel
+	virtual int AddToSaveGame(DataStream* str, std::vector<SaveEntry>& entries) = 0;
 };
 
 }
@@ -20,6 +20,8 @@
 
 #include "Audio.h"
 
+#include <chrono>
+
 namespace GemRB {
 
 const TypeID Audio::ID = { "Audio" };
@@ -111,4 +113,57 @@ Holder<SoundHandle> Audio::PlayMB(const String& resource, SFXChannel channel, co
 	return Play(mbResource, channel, p, flags, length);
 }
 
+std::shared_future<Holder<SoundHandle>> Audio::PlayAsync(StringView ResRef, SFXChannel channel, const Point& p, unsigned int flags)
+{
+	PendingPlay play;
+	std::shared_future<Holder<SoundHandle>> handle = play.handle.get_future().share();
+
+	if (!soundCache || ResRef.empty()) {
+		play.handle.set_value(Play(ResRef, channel, p, flags));
+		return handle;
+	}
+
+	play.sound = soundCache->Request(ResRef);
+	if (play.sound.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+		play.handle.set_value(Play(ResRef, channel, p, flags));
+		return handle;
+	}
+
+	play.resRef = std::string(ResRef.c_str(), ResRef.length());
+	play.channel = channel;
+	play.pos = p;
+	play.flags = flags;
+	play.queued = GetMilliseconds();
+	pending.push_back(std::move(play));
+	return handle;
+}
+
+void Audio::DispatchPending()
+{
+	if (pending.empty()) return;
+
+	tick_t now = GetMilliseconds();
+	auto it = pending.begin();
+	while (it != pending.end()) {
+		if (it->sound.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			++it;
+			continue;
+		}
+
+		if (it->sound.get() && now - it->queued <= MAX_PLAY_DELAY) {
+			it->handle.set_value(Play(it->resRef, it->channel, it->pos, it->flags));
+		} else {
+			it->handle.set_value(Holder<SoundHandle>());
+		}
+		it = pending.erase(it);
+	}
+}
+
+void Audio::Preload(const std::vector<ResRef>& sounds)
+{
+	if (soundCache) {
+		soundCache->Preload(sounds);
+	}
+}
+
 }
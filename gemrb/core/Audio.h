@@ -28,7 +28,10 @@
 #include "MapReverb.h"
 #include "Plugin.h"
 #include "Resource.h"
+#include "SoundCache.h"
 
+#include <future>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -130,6 +133,18 @@ public:
 	{
 		return Play(ResRef, channel, Point(), 0, length);
 	}
+	// lets the SoundCache decode the sound in the background and only starts it
+	// from DispatchPending once ready, so the caller never waits for it
+	std::shared_future<Holder<SoundHandle>> PlayAsync(
+		StringView ResRef,
+		SFXChannel channel,
+		const Point&,
+		unsigned int flags = 0);
+	// starts the async plays whose sounds got decoded, once per frame
+	void DispatchPending();
+	// decodes the sounds in the background, so playing them later is quick
+	void Preload(const std::vector<ResRef>& sounds);
+	SoundCache* GetSoundCache() const { return soundCache.get(); }
 
 	virtual AmbientMgr* GetAmbientMgr() { return ambim; }
 	virtual void UpdateVolume(unsigned int flags = GEM_SND_VOL_MUSIC | GEM_SND_VOL_AMBIENTS) = 0;
@@ -163,6 +178,23 @@ protected:
 	AmbientMgr* ambim = nullptr;
 	EnumArray<SFXChannel, Channel> channels;
 	Size screenSize;
+	// only set up by the drivers that actually play the samples
+	std::unique_ptr<SoundCache> soundCache;
+
+private:
+	// plays that are late by more than this are dropped instead
+	static constexpr tick_t MAX_PLAY_DELAY = 500;
+
+	struct PendingPlay {
+		std::string resRef;
+		SFXChannel channel;
+		Point pos;
+		unsigned int flags;
+		tick_t queued;
+		SoundCache::Future sound;
+		std::promise<Holder<SoundHandle>> handle;
+	};
+	std::vector<PendingPlay> pending;
 };
 
 }
@@ -21,6 +21,9 @@
 
 #include "Region.h"
 
+#include <cstdint>
+#include <cstring>
+
 namespace GemRB {
 
 class GEM_EXPORT Bitmap final {
@@ -165,6 +168,25 @@ public:
 	{
 		std::fill(begin(), end(), pattern);
 	}
+
+	// ORs the bytes [first, last) of an equally sized bitmap into this one, a machine word at a time
+	void Merge(const Bitmap& other, int first, int last) noexcept
+	{
+		first = std::max(first, 0);
+		last = std::min({ last, bytes, other.bytes });
+		int i = first;
+		for (; i + int(sizeof(uint64_t)) <= last; i += sizeof(uint64_t)) {
+			uint64_t a;
+			uint64_t b;
+			std::memcpy(&a, data + i, sizeof(a));
+			std::memcpy(&b, other.data + i, sizeof(b));
+			a |= b;
+			std::memcpy(data + i, &a, sizeof(a));
+		}
+		for (; i < last; ++i) {
+			data[i] |= other.data[i];
+		}
+	}
 };
 
 }
@@ -48,6 +48,8 @@ BOOL WINAPI DllEntryPoint(HINSTANCE /*hinstDLL*/, DWORD /*fdwReason*/,
 
 namespace GemRB {
 
+std::atomic<tick_t> ManualTime { 0 };
+
 //// Globally used functions
 
 /** Calculates distance between 2 points */
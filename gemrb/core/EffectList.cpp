@@ -0,0 +1,155 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "EffectList.h"
+
+#include <algorithm>
+
+namespace GemRB {
+
+EffectList::Slot& EffectList::Side::Grow()
+{
+	if (size == chunks.size() * CHUNK_SIZE) {
+		chunks.emplace_back(new Slot[CHUNK_SIZE]);
+	}
+	Slot& slot = (*this)[size++];
+	slot.dead = false;
+	return slot;
+}
+
+EffectList::EffectList(const EffectList& other)
+{
+	for (const Effect& fx : other) {
+		push_back(fx);
+	}
+}
+
+EffectList& EffectList::operator=(const EffectList& other)
+{
+	if (this != &other) {
+		clear();
+		for (const Effect& fx : other) {
+			push_back(fx);
+		}
+	}
+	return *this;
+}
+
+void EffectList::Index(ieDword opcode, ptrdiff_t pos)
+{
+	size_t bucket = Bucket(opcode);
+	if (bucket >= byOpcode.size()) {
+		byOpcode.resize(bucket + 1);
+	}
+	auto& positions = byOpcode[bucket];
+	// almost always at one of the ends
+	if (positions.empty() || positions.back() < pos) {
+		positions.push_back(pos);
+	} else {
+		positions.insert(std::lower_bound(positions.begin(), positions.end(), pos), pos);
+	}
+}
+
+void EffectList::RebuildIndex()
+{
+	for (auto& positions : byOpcode) {
+		positions.clear();
+	}
+	for (ptrdiff_t pos = First(); !Done(pos); ++pos) {
+		const Slot& slot = At(pos);
+		if (!slot.dead) {
+			Index(slot.fx.Opcode, pos);
+		}
+	}
+}
+
+void EffectList::push_back(const Effect& fx)
+{
+	Slot& slot = tail.Grow();
+	slot.fx = fx;
+	Index(fx.Opcode, static_cast<ptrdiff_t>(tail.size) - 1);
+	++live;
+}
+
+void EffectList::push_front(const Effect& fx)
+{
+	Slot& slot = head.Grow();
+	slot.fx = fx;
+	Index(fx.Opcode, First());
+	++live;
+}
+
+EffectList::iterator EffectList::erase(iterator it)
+{
+	Slot& slot = At(it.pos);
+	if (!slot.dead) {
+		slot.dead = true;
+		--live;
+		++dead;
+	}
+	return ++it;
+}
+
+void EffectList::clear()
+{
+	head = Side();
+	tail = Side();
+	byOpcode.clear();
+	live = 0;
+	dead = 0;
+}
+
+void EffectList::OpcodeChanged(const Effect* fx, ieDword oldOpcode)
+{
+	size_t bucket = Bucket(oldOpcode);
+	if (bucket >= byOpcode.size()) return;
+
+	auto& positions = byOpcode[bucket];
+	for (auto it = positions.begin(); it != positions.end(); ++it) {
+		const Slot& slot = At(*it);
+		if (&slot.fx != fx) continue;
+
+		ptrdiff_t pos = *it;
+		positions.erase(it);
+		if (!slot.dead) {
+			Index(fx->Opcode, pos);
+		}
+		return;
+	}
+}
+
+void EffectList::Compact()
+{
+	if (!dead) return;
+
+	Side compacted;
+	for (ptrdiff_t pos = First(); !Done(pos); ++pos) {
+		const Slot& slot = At(pos);
+		if (!slot.dead) {
+			compacted.Grow().fx = slot.fx;
+		}
+	}
+	head = Side();
+	tail = std::move(compacted);
+	dead = 0;
+	RebuildIndex();
+}
+
+}
@@ -0,0 +1,252 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef EFFECTLIST_H
+#define EFFECTLIST_H
+
+#include "exports.h"
+
+#include "Effect.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace GemRB {
+
+// Storage behind EffectQueue, keeping the order and guarantees of the
+// std::list it replaced:
+// - effects live in fixed size chunks, so pointers to them stay valid while
+//   the list grows (opcodes add effects while their queue is being applied)
+// - effects added while iterating are visited, the ones pushed to the front are not
+// - erasing only marks the effect dead, the tombstones are dropped by Compact,
+//   which must only be called when nobody is iterating the list
+// Positions are signed: the front grows downwards from -1, the back upwards
+// from 0, so adding effects never moves the others. The positions of each
+// opcode are indexed in order, so the opcode queries don't need a full scan.
+// Opcodes come straight from the files, so the ones past MAX_OPCODES share
+// a single overflow bucket instead of getting their own.
+class GEM_EXPORT EffectList {
+public:
+	static constexpr ieDword MAX_OPCODES = 512;
+
+private:
+	static constexpr size_t CHUNK_SIZE = 16;
+
+	struct Slot {
+		Effect fx;
+		bool dead = false;
+	};
+
+	// one end of the list, growing away from the other
+	struct Side {
+		std::vector<std::unique_ptr<Slot[]>> chunks;
+		size_t size = 0;
+
+		Slot& operator[](size_t idx) { return chunks[idx / CHUNK_SIZE][idx % CHUNK_SIZE]; }
+		const Slot& operator[](size_t idx) const { return chunks[idx / CHUNK_SIZE][idx % CHUNK_SIZE]; }
+		Slot& Grow();
+	};
+
+	Side head; // in reverse order
+	Side tail;
+	size_t live = 0;
+	size_t dead = 0;
+	std::vector<std::vector<ptrdiff_t>> byOpcode;
+
+	static constexpr ptrdiff_t END = PTRDIFF_MAX;
+
+	ptrdiff_t First() const { return -static_cast<ptrdiff_t>(head.size); }
+	bool Done(ptrdiff_t pos) const { return pos >= static_cast<ptrdiff_t>(tail.size); }
+	Slot& At(ptrdiff_t pos) { return pos < 0 ? head[-pos - 1] : tail[pos]; }
+	const Slot& At(ptrdiff_t pos) const { return pos < 0 ? head[-pos - 1] : tail[pos]; }
+
+	static size_t Bucket(ieDword opcode) { return opcode < MAX_OPCODES ? opcode : MAX_OPCODES; }
+	void Index(ieDword opcode, ptrdiff_t pos);
+	void RebuildIndex();
+
+public:
+	template<typename LIST, typename VALUE>
+	class Iterator {
+		LIST* list = nullptr;
+		ptrdiff_t pos = END;
+
+		friend class EffectList;
+
+		void SkipDead()
+		{
+			while (!list->Done(pos) && list->At(pos).dead) {
+				++pos;
+			}
+		}
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Effect;
+		using difference_type = ptrdiff_t;
+		using pointer = VALUE*;
+		using reference = VALUE&;
+
+		Iterator() noexcept = default;
+		Iterator(LIST* list, ptrdiff_t pos)
+			: list(list), pos(pos)
+		{
+			SkipDead();
+		}
+
+		VALUE& operator*() const { return list->At(pos).fx; }
+		VALUE* operator->() const { return &list->At(pos).fx; }
+
+		Iterator& operator++()
+		{
+			++pos;
+			SkipDead();
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			Iterator old = *this;
+			++*this;
+			return old;
+		}
+
+		// the end is wherever the back is right now
+		bool operator==(const Iterator& other) const
+		{
+			bool done = list->Done(pos);
+			if (done || other.list->Done(other.pos)) {
+				return done == other.list->Done(other.pos);
+			}
+			return pos == other.pos;
+		}
+		bool operator!=(const Iterator& other) const { return !(*this == other); }
+	};
+
+	using iterator = Iterator<EffectList, Effect>;
+	using const_iterator = Iterator<const EffectList, const Effect>;
+
+	// walks the effects with a given opcode, in list order
+	template<typename LIST, typename VALUE>
+	class OpcodeRange {
+		LIST* list;
+		ieDword opcode;
+
+	public:
+		class iterator {
+			LIST* list;
+			ieDword opcode;
+			size_t idx;
+
+			const std::vector<ptrdiff_t>* Positions() const
+			{
+				size_t bucket = EffectList::Bucket(opcode);
+				return bucket < list->byOpcode.size() ? &list->byOpcode[bucket] : nullptr;
+			}
+
+			bool Done() const
+			{
+				const auto* positions = Positions();
+				return !positions || idx >= positions->size();
+			}
+
+			// the overflow bucket mixes opcodes, so check them too
+			bool Skip() const
+			{
+				const auto& slot = list->At((*Positions())[idx]);
+				return slot.dead || slot.fx.Opcode != opcode;
+			}
+
+			void SkipDead()
+			{
+				while (!Done() && Skip()) {
+					++idx;
+				}
+			}
+
+		public:
+			iterator(LIST* list, ieDword opcode, size_t idx)
+				: list(list), opcode(opcode), idx(idx)
+			{
+				SkipDead();
+			}
+
+			VALUE& operator*() const { return list->At((*Positions())[idx]).fx; }
+			iterator& operator++()
+			{
+				++idx;
+				SkipDead();
+				return *this;
+			}
+			bool operator!=(const iterator& other) const
+			{
+				bool done = Done();
+				if (done || other.Done()) {
+					return done != other.Done();
+				}
+				return idx != other.idx;
+			}
+		};
+
+		OpcodeRange(LIST* list, ieDword opcode)
+			: list(list), opcode(opcode) {}
+
+		iterator begin() const { return iterator(list, opcode, 0); }
+		iterator end() const { return iterator(list, opcode, SIZE_MAX); }
+	};
+
+	EffectList() noexcept = default;
+	EffectList(const EffectList& other);
+	EffectList(EffectList&&) noexcept = default;
+	EffectList& operator=(const EffectList& other);
+	EffectList& operator=(EffectList&&) noexcept = default;
+
+	iterator begin() { return iterator(this, First()); }
+	iterator end() { return iterator(this, END); }
+	const_iterator begin() const { return const_iterator(this, First()); }
+	const_iterator end() const { return const_iterator(this, END); }
+
+	OpcodeRange<EffectList, Effect> WithOpcode(ieDword opcode) { return { this, opcode }; }
+	OpcodeRange<const EffectList, const Effect> WithOpcode(ieDword opcode) const { return { this, opcode }; }
+
+	size_t size() const { return live; }
+	bool empty() const { return !live; }
+	Effect& front() { return *begin(); }
+	const Effect& front() const { return *begin(); }
+
+	void push_back(const Effect& fx);
+	void push_front(const Effect& fx);
+	// marks the effect dead, returns the next one
+	iterator erase(iterator it);
+	void clear();
+
+	// call after changing the opcode of a stored effect, so the index follows
+	void OpcodeChanged(const Effect* fx, ieDword oldOpcode);
+
+	size_t GetDeadCount() const { return dead; }
+	// drops the dead effects, this moves the rest
+	void Compact();
+};
+
+}
+
+#endif
@@ -80,7 +80,7 @@ static EffectDesc* FindEffect(StringView effectname)
 /** The available effects should already be registered by the effect plugins */
 
 struct Globals {
-	static constexpr int MAX_EFFECTS = 512;
+	static constexpr int MAX_EFFECTS = EffectList::MAX_OPCODES;
 	EffectDesc Opcodes[MAX_EFFECTS];
 
 	int pstflags = false;
@@ -438,9 +438,9 @@ Effect* EffectQueue::CreateUnsummonEffect(const Effect* fx)
 void EffectQueue::AddEffect(Effect* fx, bool insert)
 {
 	if (insert) {
-		effects.push_front(std::move(*fx));
+		effects.push_front(*fx);
 	} else {
-		effects.push_back(std::move(*fx));
+		effects.push_back(*fx);
 	}
 	delete fx;
 }
@@ -484,6 +484,10 @@ void EffectQueue::Cleanup()
 			++f;
 		}
 	}
+	// nothing iterates the queue here, so it's the place to drop the tombstones
+	if (effects.GetDeadCount() > effects.size() / 4) {
+		effects.Compact();
+	}
 }
 
 //Handle the target flag when the effect is applied first
@@ -1294,8 +1298,13 @@ int EffectQueue::ApplyEffect(Actor* target, Effect* fx, ieDword first_apply, ieD
 		}
 	}
 
+	ieDword opcode = fx->Opcode;
 	res = ed(Owner, target, fx);
 	fx->FirstApply = 0;
+	// some opcodes turn into others, keep the opcode index of the target up to date
+	if (fx->Opcode != opcode && target) {
+		target->fxqueue.effects.OpcodeChanged(fx, opcode);
+	}
 
 	switch (res) {
 		case FX_APPLIED:
@@ -1327,6 +1336,25 @@ int EffectQueue::ApplyEffect(Actor* target, Effect* fx, ieDword first_apply, ieD
 	return res;
 }
 
+bool EffectQueue::IsStatOnly(const Effect& fx)
+{
+	// the rest can expire, trigger or change the base stats
+	switch (fx.TimingMode) {
+		case FX_DURATION_INSTANT_WHILE_EQUIPPED:
+		case FX_DURATION_PERMANENT_UNSAVED:
+		case FX_DURATION_INSTANT_PERMANENT_AFTER_BONUSES:
+			break;
+		default:
+			return false;
+	}
+	if (fx.FirstApply || fx.Opcode >= Globals::MAX_EFFECTS) {
+		return false;
+	}
+
+	int flags = Globals::Get().Opcodes[fx.Opcode].Flags;
+	return (flags & EFFECT_STAT_ONLY) && !(flags & EFFECT_REINIT_ON_LOAD);
+}
+
 // looks for opcode with param2
 
 #define MATCH_OPCODE() \
@@ -1368,7 +1396,7 @@ static inline bool IsLive(ieByte timingmode)
 //will be killed along with it
 void EffectQueue::RemoveAllEffects(ieDword opcode)
 {
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -1545,7 +1573,7 @@ void EffectQueue::RemoveAllEffects(EffectRef& effectReference)
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithResource(ieDword opcode, const ResRef& resource)
 {
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		if (fx.Resource != resource) {
@@ -1566,7 +1594,7 @@ void EffectQueue::RemoveAllEffectsWithResource(EffectRef& effectReference, const
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithSource(ieDword opcode, const ResRef& source, int mode)
 {
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		if (fx.SourceRef != source) continue;
 
@@ -1597,7 +1625,7 @@ void EffectQueue::RemoveAllEffectsWithSource(EffectRef& effectReference, const R
 //(works only if a higher stat means good for the target)
 void EffectQueue::RemoveAllDetrimentalEffects(ieDword opcode, ieDword current)
 {
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -1634,7 +1662,7 @@ void EffectQueue::RemoveAllDetrimentalEffects(EffectRef& effectReference, ieDwor
 //opcode need to be removed (see removal of portrait icon)
 void EffectQueue::RemoveAllEffectsWithParam(ieDword opcode, ieDword param, bool param1)
 {
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		if (param1) {
@@ -1663,7 +1691,7 @@ void EffectQueue::RemoveAllEffectsWithParam1(EffectRef& effectReference, ieDword
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithParamAndResource(ieDword opcode, ieDword param2, const ResRef& resource)
 {
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
@@ -1793,7 +1821,7 @@ bool EffectQueue::RollDispelChance(ieDword casterLevel, ieDword level)
 
 const Effect* EffectQueue::HasOpcode(ieDword opcode) const
 {
-	for (const auto& fx : effects) {
+	for (const auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -1813,7 +1841,7 @@ const Effect* EffectQueue::HasEffect(EffectRef& effectReference) const
 
 Effect* EffectQueue::HasOpcode(ieDword opcode)
 {
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -1833,7 +1861,7 @@ Effect* EffectQueue::HasEffect(EffectRef& effectReference)
 
 const Effect* EffectQueue::HasOpcodeWithParam(ieDword opcode, ieDword param2) const
 {
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
@@ -1858,7 +1886,7 @@ const Effect* EffectQueue::HasEffectWithParam(EffectRef& effectReference, ieDwor
 
 const Effect* EffectQueue::HasOpcodeWithParamPair(ieDword opcode, ieDword param1, ieDword param2) const
 {
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
@@ -1886,7 +1914,7 @@ const Effect* EffectQueue::HasEffectWithParamPair(EffectRef& effectReference, ie
 bool EffectQueue::DecreaseParam1OfEffect(ieDword opcode, ieDword amount)
 {
 	bool found = false;
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		ieDword& amount_left = fx.Parameter1;
@@ -1914,7 +1942,7 @@ bool EffectQueue::DecreaseParam1OfEffect(EffectRef& effectReference, ieDword amo
 //returns the damage amount NOT soaked
 int EffectQueue::DecreaseParam3OfEffect(ieDword opcode, ieDword amount, ieDword param2)
 {
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
@@ -1953,7 +1981,7 @@ static const int ids_stats[9] = { IE_FACTION, IE_TEAM, IE_EA, IE_GENERAL, IE_RAC
 int EffectQueue::BonusAgainstCreature(ieDword opcode, const Actor* actor) const
 {
 	ieDword sum = 0;
-	for (const auto& fx : effects) {
+	for (const auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		if (fx.Parameter1) {
@@ -2005,7 +2033,7 @@ int EffectQueue::BonusAgainstCreature(EffectRef& effectReference, const Actor* a
 int EffectQueue::BonusForParam2(ieDword opcode, ieDword param2) const
 {
 	int sum = 0;
-	for (const auto& fx : effects) {
+	for (const auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
@@ -2027,7 +2055,7 @@ int EffectQueue::MaxParam1(ieDword opcode, bool positive) const
 {
 	int max = 0;
 	ieDwordSigned param1 = 0;
-	for (const auto& fx : effects) {
+	for (const auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -2050,7 +2078,7 @@ int EffectQueue::MaxParam1(EffectRef& effectReference, bool positive) const
 
 bool EffectQueue::WeaponImmunity(ieDword opcode, int enchantment, ieDword weapontype) const
 {
-	for (const auto& fx : effects) {
+	for (const auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -2090,7 +2118,7 @@ void EffectQueue::AddWeaponEffects(EffectQueue* fxqueue, EffectRef& fx_ref, ieDw
 	ieDword opcode = fx_ref.opcode;
 	Point p(-1, -1);
 
-	for (const auto& fx : effects) {
+	for (const auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		if (!param2 && fx.Parameter2 != param2) continue;
@@ -2110,7 +2138,7 @@ int EffectQueue::SumDamageReduction(EffectRef& effectReference, ieDword weaponEn
 	int remaining = 0;
 	int count = 0;
 
-	for (const auto& fx : effects) {
+	for (const auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 
@@ -2131,7 +2159,7 @@ int EffectQueue::SumDamageReduction(EffectRef& effectReference, ieDword weaponEn
 //useful for immunity vs spell, can't use item, etc.
 const Effect* EffectQueue::HasOpcodeWithResource(ieDword opcode, const ResRef& resource) const
 {
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		if (fx.Resource != resource) continue;
@@ -2156,7 +2184,7 @@ const Effect* EffectQueue::HasEffectWithPower(EffectRef& effectReference, ieDwor
 
 const Effect* EffectQueue::HasOpcodeWithPower(ieDword opcode, ieDword power) const
 {
-	for (const auto& fx : effects) {
+	for (const auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		// NOTE: matching greater or equals!
@@ -2184,7 +2212,7 @@ const Effect* EffectQueue::HasSource(const ResRef& removed) const
 //used in contingency/sequencer code (cannot have the same contingency twice)
 const Effect* EffectQueue::HasOpcodeWithSource(ieDword opcode, const ResRef& removed) const
 {
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		if (removed != fx.SourceRef) {
@@ -2270,17 +2298,22 @@ Effect* EffectQueue::GetNextEffect(queue_t::iterator& f)
 ieDword EffectQueue::CountEffects(ieDword opcode, ieDword param1, ieDword param2, const ResRef& resource, const ResRef& source) const
 {
 	ieDword cnt = 0;
-
-	for (const auto& fx : effects) {
-		if (opcode != 0xffffffff)
-			MATCH_OPCODE()
-		if (param1 != 0xffffffff)
-			MATCH_PARAM1()
-		if (param2 != 0xffffffff)
-			MATCH_PARAM2()
-		if (!resource.IsEmpty() && fx.Resource != resource) continue;
-		if (!source.IsEmpty() && fx.SourceRef != source) continue;
+	auto count = [&](const Effect& fx) {
+		if (param1 != 0xffffffff && fx.Parameter1 != param1) return;
+		if (param2 != 0xffffffff && fx.Parameter2 != param2) return;
+		if (!resource.IsEmpty() && fx.Resource != resource) return;
+		if (!source.IsEmpty() && fx.SourceRef != source) return;
 		cnt++;
+	};
+
+	if (opcode == 0xffffffff) {
+		for (const auto& fx : effects) {
+			count(fx);
+		}
+	} else {
+		for (const auto& fx : effects.WithOpcode(opcode)) {
+			if (fx.Opcode == opcode) count(fx);
+		}
 	}
 	return cnt;
 }
@@ -2290,7 +2323,7 @@ unsigned int EffectQueue::GetEffectOrder(EffectRef& effectReference, const Effec
 	ieDword cnt = 1;
 	ieDword opcode = ResolveEffect(effectReference);
 
-	for (const auto& fx : effects) {
+	for (const auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		MATCH_LIVE_FX()
 		if (&fx == fx2) break;
@@ -2301,7 +2334,7 @@ unsigned int EffectQueue::GetEffectOrder(EffectRef& effectReference, const Effec
 
 void EffectQueue::ModifyEffectPoint(ieDword opcode, ieDword x, ieDword y)
 {
-	for (auto& fx : effects) {
+	for (auto& fx : effects.WithOpcode(opcode)) {
 		MATCH_OPCODE()
 		fx.Pos = Point(x, y);
 		fx.Parameter3 = 0;
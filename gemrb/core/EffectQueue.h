@@ -31,12 +31,12 @@
 #include "exports.h"
 
 #include "Effect.h"
+#include "EffectList.h"
 #include "Region.h"
 
 #include "Logging/Logging.h"
 
 #include <cstdlib>
-#include <list>
 
 namespace GemRB {
 
@@ -166,7 +166,11 @@ enum EffectFlags {
 	EFFECT_NO_ACTOR = 4,
 	EFFECT_REINIT_ON_LOAD = 8,
 	EFFECT_PRESET_TARGET = 16,
-	EFFECT_SPECIAL_UNDO = 32
+	EFFECT_SPECIAL_UNDO = 32,
+	// only changes stats through SetStat (STAT_* macros), based on nothing but
+	// Parameter1, Parameter2, TimingMode and the base and current values of the
+	// stats it writes, so StatCache can skip reapplying it
+	EFFECT_STAT_ONLY = 64
 };
 
 // unusual SpellProt types which need hacking (fake stats)
@@ -212,7 +216,7 @@ bool IsColorslotEffect(int opcode);
 class GEM_EXPORT EffectQueue {
 private:
 	/** List of Effects applied on the Actor */
-	using queue_t = std::list<Effect>;
+	using queue_t = EffectList;
 	queue_t effects;
 	/** Actor which is target of the Effects */
 	Scriptable* Owner = nullptr;
@@ -339,6 +343,8 @@ public:
 	static bool match_ids(const Actor* target, int table, ieDword value);
 	/** returns true if the process should abort applying a stack of effects */
 	int ApplyEffect(Actor* target, Effect* fx, ieDword first_apply, ieDword resistance = 1) const;
+	/* true if reapplying the effect only recomputes stats, see EFFECT_STAT_ONLY */
+	static bool IsStatOnly(const Effect& fx);
 	/** just checks if it is a particularly stupid effect that needs its target reset */
 	static bool OverrideTarget(const Effect* fx);
 	bool HasHostileEffects() const;
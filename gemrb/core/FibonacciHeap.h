@@ -61,17 +61,25 @@ template<class V>
 class FibonacciHeap {
 protected:
 	node<V>* heap;
+	// popped and cleared nodes are kept here (linked through next) for reuse
+	node<V>* freeList;
 
 public:
 	FibonacciHeap()
 	{
 		heap = _empty();
+		freeList = NULL;
 	}
 	virtual ~FibonacciHeap()
 	{
 		if (heap) {
 			_deleteAll(heap);
 		}
+		while (freeList) {
+			node<V>* n = freeList;
+			freeList = n->next;
+			delete n;
+		}
 	}
 	node<V>* insert(V value)
 	{
@@ -96,6 +104,13 @@ public:
 		return heap == NULL;
 	}
 
+	// empties the heap, but keeps the nodes around for later inserts
+	void clear()
+	{
+		_recycleAll(heap);
+		heap = _empty();
+	}
+
 	V top()
 	{
 		return heap->value;
@@ -106,7 +121,7 @@ public:
 		node<V>* old = heap;
 		heap = _removeMinimum(heap);
 		V ret = old->value;
-		delete old;
+		_recycle(old);
 		return ret;
 	}
 
@@ -128,7 +143,13 @@ private:
 
 	node<V>* _singleton(V value)
 	{
-		node<V>* n = new node<V>;
+		node<V>* n;
+		if (freeList) {
+			n = freeList;
+			freeList = n->next;
+		} else {
+			n = new node<V>;
+		}
 		n->value = value;
 		n->prev = n->next = n;
 		n->degree = 0;
@@ -169,6 +190,25 @@ private:
 		}
 	}
 
+	void _recycle(node<V>* n)
+	{
+		n->next = freeList;
+		freeList = n;
+	}
+
+	void _recycleAll(node<V>* n)
+	{
+		if (n != NULL) {
+			node<V>* c = n;
+			do {
+				node<V>* d = c;
+				c = c->next;
+				_recycleAll(d->child);
+				_recycle(d);
+			} while (c != n);
+		}
+	}
+
 	void _addChild(node<V>* parent, node<V>* child)
 	{
 		child->prev = child->next = child;
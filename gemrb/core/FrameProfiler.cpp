@@ -0,0 +1,173 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "FrameProfiler.h"
+
+#include "Logging/Logging.h"
+#include "Streams/FileStream.h"
+
+#include <algorithm>
+
+namespace GemRB {
+
+static const char* const PhaseNames[] = {
+	"GameScripts", "AreaScripts", "GenerateQueues", "UpdateFog", "DrawMap", "DrawFog", "DrawGUI", "SwapBuffers"
+};
+static_assert(sizeof(PhaseNames) / sizeof(PhaseNames[0]) == size_t(ProfilePhase::count), "Missing profiler phase names");
+
+static uint32_t Microseconds(FrameProfiler::Clock::duration time)
+{
+	return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(time).count());
+}
+
+FrameProfiler& FrameProfiler::Get()
+{
+	static FrameProfiler profiler;
+	return profiler;
+}
+
+const char* FrameProfiler::GetPhaseName(ProfilePhase phase)
+{
+	return PhaseNames[UnderType(phase)];
+}
+
+void FrameProfiler::SetEnabled(bool enable)
+{
+	if (enable == enabled) return;
+
+	enabled = enable;
+	if (enabled) {
+		history.assign(HISTORY, Frame());
+		next = 0;
+		frameCount = 0;
+		current = Frame();
+		frameStart = Clock::now();
+	} else {
+		history.clear();
+		history.shrink_to_fit();
+	}
+}
+
+void FrameProfiler::Add(ProfilePhase phase, Clock::duration time, const ResRef* area)
+{
+	uint32_t us = Microseconds(time);
+	current.phases[phase] += us;
+	if (!area) return;
+
+	auto it = std::find_if(current.areas.begin(), current.areas.end(), [area](const auto& entry) {
+		return entry.first == *area;
+	});
+	if (it == current.areas.end()) {
+		current.areas.emplace_back(*area, us);
+	} else {
+		it->second += us;
+	}
+}
+
+void FrameProfiler::EndFrame()
+{
+	if (!enabled) return;
+
+	Clock::time_point now = Clock::now();
+	current.index = frameCount++;
+	current.total = Microseconds(now - frameStart);
+	frameStart = now;
+
+	// swap, so the area list keeps its memory
+	std::swap(history[next], current);
+	next = (next + 1) % HISTORY;
+	current.phases = EnumArray<ProfilePhase, uint32_t>();
+	current.areas.clear();
+}
+
+size_t FrameProfiler::GetFrameCount() const
+{
+	return std::min<uint64_t>(frameCount, history.size());
+}
+
+const FrameProfiler::Frame* FrameProfiler::GetFrame(size_t age) const
+{
+	if (age >= GetFrameCount()) return nullptr;
+	return &history[(next + HISTORY - 1 - age) % HISTORY];
+}
+
+String FrameProfiler::Summary() const
+{
+	size_t count = std::min(GetFrameCount(), OVERLAY_FRAMES);
+	if (!count) return u"no frames yet";
+
+	uint64_t totalSum = 0;
+	uint32_t totalMax = 0;
+	EnumArray<ProfilePhase, uint64_t> sums;
+	EnumArray<ProfilePhase, uint32_t> maxima;
+	for (size_t age = 0; age < count; ++age) {
+		const Frame* frame = GetFrame(age);
+		totalSum += frame->total;
+		totalMax = std::max(totalMax, frame->total);
+		for (auto phase : EnumIterator<ProfilePhase>()) {
+			sums[phase] += frame->phases[phase];
+			maxima[phase] = std::max(maxima[phase], frame->phases[phase]);
+		}
+	}
+
+	std::string summary = fmt::format("{:<15}{:>7.2f} {:>7.2f}\n", "Frame (avg/max)", totalSum / 1000.0 / count, totalMax / 1000.0);
+	for (auto phase : EnumIterator<ProfilePhase>()) {
+		summary += fmt::format("{:<15}{:>7.2f} {:>7.2f}\n", PhaseNames[UnderType(phase)], sums[phase] / 1000.0 / count, maxima[phase] / 1000.0);
+	}
+	return StringFromUtf8(summary);
+}
+
+bool FrameProfiler::DumpCSV(const path_t& path) const
+{
+	FileStream out;
+	if (!out.Create(path)) {
+		Log(ERROR, "FrameProfiler", "Unable to write {}.", path);
+		return false;
+	}
+
+	std::string line = "frame,total";
+	for (const char* name : PhaseNames) {
+		line += ',';
+		line += name;
+	}
+	line += ",areas\n";
+	out.Write(line.c_str(), line.length());
+
+	// oldest first, all in microseconds
+	for (size_t age = GetFrameCount(); age--;) {
+		const Frame* frame = GetFrame(age);
+		line = fmt::format("{},{}", frame->index, frame->total);
+		for (auto phase : EnumIterator<ProfilePhase>()) {
+			line += fmt::format(",{}", frame->phases[phase]);
+		}
+		char separator = ',';
+		for (const auto& area : frame->areas) {
+			line += fmt::format("{}{}:{}", separator, area.first, area.second);
+			separator = ' ';
+		}
+		if (frame->areas.empty()) line += ',';
+		line += '\n';
+		out.Write(line.c_str(), line.length());
+	}
+	Log(MESSAGE, "FrameProfiler", "Wrote {} frames to {}.", GetFrameCount(), path);
+	return true;
+}
+
+}
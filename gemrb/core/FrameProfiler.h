@@ -0,0 +1,119 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include "exports.h"
+
+#include "EnumIndex.h"
+#include "Resource.h"
+
+#include "Strings/String.h"
+#include "System/VFS.h"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace GemRB {
+
+// the phases can nest, the map is drawn as part of the GUI for example
+enum class ProfilePhase : uint8_t {
+	GameScripts,
+	AreaScripts,
+	GenerateQueues,
+	UpdateFog,
+	DrawMap,
+	DrawFog,
+	DrawGUI,
+	SwapBuffers,
+	count
+};
+
+// Always available timings of the main phases of each frame, for when an
+// external profiler like Tracy can't be used. Shown as an overlay (see the
+// ProfileFrames setting and GemRB.ProfileFrames) and dumpable to CSV.
+// Everything is expected to happen on the main thread.
+class GEM_EXPORT FrameProfiler {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	// frames kept for the overlay averages and the dumps
+	static constexpr size_t HISTORY = 1024;
+	static constexpr size_t OVERLAY_FRAMES = 60;
+
+	struct Frame {
+		uint64_t index = 0;
+		uint32_t total = 0; // microseconds, like the phases
+		EnumArray<ProfilePhase, uint32_t> phases;
+		// the share of each area in AreaScripts
+		std::vector<std::pair<ResRef, uint32_t>> areas;
+	};
+
+	static FrameProfiler& Get();
+	static const char* GetPhaseName(ProfilePhase phase);
+
+	bool IsEnabled() const { return enabled; }
+	void SetEnabled(bool enable);
+
+	void Add(ProfilePhase phase, Clock::duration time, const ResRef* area = nullptr);
+	// closes the frame that is being recorded
+	void EndFrame();
+
+	const Frame* GetFrame(size_t age) const;
+	size_t GetFrameCount() const;
+	// averages and maxima over the last frames, one line per phase
+	String Summary() const;
+	bool DumpCSV(const path_t& path) const;
+
+private:
+	bool enabled = false;
+	Frame current;
+	std::vector<Frame> history;
+	size_t next = 0; // where the next frame goes in history
+	uint64_t frameCount = 0;
+	Clock::time_point frameStart;
+};
+
+class GEM_EXPORT ProfileScope {
+private:
+	ProfilePhase phase;
+	const ResRef* area;
+	bool active;
+	FrameProfiler::Clock::time_point start;
+
+public:
+	explicit ProfileScope(ProfilePhase phase, const ResRef* area = nullptr)
+		: phase(phase), area(area), active(FrameProfiler::Get().IsEnabled())
+	{
+		if (active) start = FrameProfiler::Clock::now();
+	}
+	ProfileScope(const ProfileScope&) = delete;
+	~ProfileScope()
+	{
+		if (active) FrameProfiler::Get().Add(phase, FrameProfiler::Clock::now() - start, area);
+	}
+	ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+}
+
+#endif
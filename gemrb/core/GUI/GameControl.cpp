@@ -1348,6 +1348,10 @@ void GameControl::UpdateCursor()
 			overMe = overInfoPoint;
 			if (overInfoPoint) {
 				nextCursor = overInfoPoint->GetCursor(targetMode);
+				// pointing at an exit is a good hint where we'll go next
+				if (overInfoPoint->Type == ST_TRAVEL) {
+					gamedata->PrefetchArea(overInfoPoint->Destination, false);
+				}
 			}
 		}
 
@@ -2018,6 +2022,7 @@ bool GameControl::HandleActiveRegion(InfoPoint* trap, Actor* actor, const Point&
 
 	switch (trap->Type) {
 		case ST_TRAVEL:
+			gamedata->PrefetchArea(trap->Destination);
 			trap->AddTrigger(TriggerEntry(trigger_clicked, actor->GetGlobalID()));
 			actor->objects.LastMarked = trap->GetGlobalID();
 			//clear the go closer flag
@@ -21,6 +21,7 @@
 #include "defsounds.h"
 
 #include "Debug.h"
+#include "FrameProfiler.h"
 #include "GameData.h"
 #include "ImageMgr.h"
 #include "Interface.h"
@@ -600,6 +601,7 @@ WindowManager::HUDLock WindowManager::DrawHUD() const
 void WindowManager::DrawWindows() const
 {
 	TRACY(ZoneScoped);
+	ProfileScope profile(ProfilePhase::DrawGUI);
 	HUDBuf->Clear();
 
 	if (windows.empty()) {
@@ -57,6 +57,23 @@ WorldMapControl::WorldMapControl(const Region& frame, Holder<Font> font, const C
 	// visible immediately and without the need for area travel
 	worldmap->CalculateDistances(currentArea, WMPDirection::NONE);
 
+	// the neighbours are the likeliest destinations
+	const WMPAreaEntry* here = worldmap->GetArea(currentArea);
+	if (here) {
+		for (WMPDirection dir : EnumIterator<WMPDirection>()) {
+			for (ieDword i = 0; i < here->AreaLinksCount[dir]; ++i) {
+				ieDword linkIdx = here->AreaLinksIndex[dir] + i;
+				if (linkIdx >= ieDword(worldmap->GetLinkCount())) break;
+				const WMPAreaLink* link = worldmap->GetLink(linkIdx);
+				if (link->AreaIndex >= ieDword(worldmap->GetEntryCount())) continue;
+				const WMPAreaEntry* dest = worldmap->GetEntry(link->AreaIndex);
+				if ((dest->GetAreaStatus() & WMP_ENTRY_WALKABLE) == WMP_ENTRY_WALKABLE) {
+					gamedata->PrefetchArea(dest->AreaResRef, false);
+				}
+			}
+		}
+	}
+
 	SetAction([this](const Control* /*this*/) {
 		//this also updates visible locations
 		WorldMap* map = core->GetWorldMap();
@@ -240,6 +257,7 @@ bool WorldMapControl::OnMouseOver(const MouseEvent& me)
 		SetCursor(core->Cursors[IE_CURSOR_NORMAL]);
 		Area = ae;
 		if (oldArea != ae) {
+			gamedata->PrefetchArea(ae->AreaResRef);
 			const String str = core->GetString(DisplayMessage::GetStringReference(HCStrings::TravelTime));
 			int hours = worldmap->GetDistance(Area->AreaName);
 			if (!str.empty() && hours >= 0) {
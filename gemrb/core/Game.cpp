@@ -26,6 +26,7 @@
 #include "strrefs.h"
 
 #include "DisplayMessage.h"
+#include "FrameProfiler.h"
 #include "GameData.h"
 #include "IniSpawn.h"
 #include "Interface.h"
@@ -80,9 +81,12 @@ struct Injured {
 
 #define MAX_MAPS_LOADED 1
 
+uint32_t Game::variablesEpoch = 0;
+
 Game::Game(void)
 	: Scriptable(ST_GLOBAL)
 {
+	VariablesChanged();
 	SetScript(core->GlobalScript, 0);
 	weather = new Particles(200);
 	weather->SetRegion(0, 0, core->config.Width, core->config.Height);
@@ -690,6 +694,7 @@ Map* Game::GetMap(const ResRef& areaName, bool change)
 	// change the tileset if needed
 	area->ChangeMap(IsDay());
 	area->SetupAmbients();
+	area->PreloadSounds();
 	ChangeSong(false, true);
 	Infravision();
 
@@ -861,6 +866,9 @@ int Game::LoadMap(const ResRef& resRef, bool loadscreen)
 	}
 
 	int ret = AddMap(newMap);
+	if (core->config.HierarchicalPathfinding) {
+		newMap->SetHierarchicalPathfinding(true);
+	}
 
 	// spawn creatures on a map already in the game
 	for (size_t i = 0; i < PCs.size(); i++) {
@@ -1372,6 +1380,7 @@ void Game::IncrementChapter()
 	} else if (!core->HasFeature(GFFlags::NO_NEW_VARIABLES)) {
 		locals["CHAPTER"] = 0;
 	}
+	VariablesChanged();
 
 	//clear statistics
 	for (const auto& pc : PCs) {
@@ -1575,6 +1584,7 @@ static bool ShouldChangeSong(bool combatChange)
 // runs all area scripts
 void Game::UpdateScripts()
 {
+	ProfileScope profile(ProfilePhase::GameScripts);
 	Update();
 
 	PartyAttack = false;
@@ -1706,6 +1716,7 @@ void Game::TextDream()
 		}
 
 		locals["DREAM"] = dream + 1;
+		VariablesChanged();
 		core->SetEventFlag(EF_TEXTSCREEN);
 	}
 }
@@ -2364,6 +2375,7 @@ std::string Game::dump() const
 	int hours = GameTime / core->Time.hour_size;
 	AppendFormat(buffer, "Game time: {} ({} days, {} hours)\n", GameTime.load(), hours / 24, hours % 24);
 	AppendFormat(buffer, "CombatCounter: {}\n", CombatCounter);
+	AppendFormat(buffer, "Trigger evaluations saved by caching: {}\n", Script::GetSavedEvaluations());
 
 	AppendFormat(buffer, "Party size: {}\n", PCs.size());
 	for (const auto& actor : PCs) {
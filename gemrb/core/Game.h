@@ -514,6 +514,9 @@ public:
 	bool IsTargeted(ieDword gid) const;
 	// GLOBAL is just the LOCALS of the Game Scriptable, but we want to avoid any confusion
 	ieDword GetGlobal(const ieVariable& key, ieDword fallback) const { return GetLocal(key, fallback); };
+	// call after writing to locals or kaputz directly, so cached trigger results aren't reused
+	static void VariablesChanged() { ++variablesEpoch; }
+	static uint32_t GetVariablesEpoch() { return variablesEpoch; }
 	bool CheckPartyBanter() const;
 	void CheckBored();
 	void CheckAreaComment();
@@ -521,6 +524,9 @@ public:
 	void SetGameTime(uint32_t value);
 	uint32_t GetGameTimeReal() const { return GameTime; }
 private:
+	// shared by all games, so a newly loaded one can't match stale results of the previous
+	static uint32_t variablesEpoch;
+
 	ResRef* GetDream(Map* area);
 	bool RestPartyInternal(RestChecks checks, int hp, int& hours);
 	bool CastOnRest() const;
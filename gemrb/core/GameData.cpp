@@ -54,6 +54,9 @@ GEM_EXPORT GameData* gamedata;
 
 GameData::~GameData()
 {
+	if (prefetcher) {
+		prefetcher->Stop();
+	}
 	PaletteCache.clear();
 
 	while (!stores.empty()) {
@@ -1054,4 +1057,14 @@ int GameData::GetVBData(const TableMgr::key_t& rowName)
 	return vbDetails->QueryFieldSigned<int>(rowName, "VALUE");
 }
 
+void GameData::PrefetchArea(const ResRef& area, bool urgent)
+{
+	if (!core->config.PrefetchAreas) return;
+
+	if (!prefetcher) {
+		prefetcher = std::make_unique<ResourcePrefetcher>(*this);
+	}
+	prefetcher->PrefetchArea(area, urgent);
+}
+
 }
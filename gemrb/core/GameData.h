@@ -35,6 +35,7 @@
 #include "Palette.h"
 #include "Resource.h"
 #include "ResourceManager.h"
+#include "ResourcePrefetcher.h"
 #include "Spell.h"
 #include "SrcMgr.h"
 #include "TableMgr.h"
@@ -42,6 +43,7 @@
 #include "Scriptable/Actor.h"
 
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -196,11 +198,15 @@ public:
 	inline int GetTextSpeed() const { return TextScreenSpeed; }
 	inline void SetTextSpeed(int speed) { TextScreenSpeed = speed; }
 
+	/** Starts reading the files of an area in the background, if enabled (PrefetchAreas) */
+	void PrefetchArea(const ResRef& area, bool urgent = true);
+
 private:
 	void ReadItemSounds();
 	void ReadSpellProtTable();
 
 private:
+	std::unique_ptr<ResourcePrefetcher> prefetcher;
 	ResRefRCCache<Item> ItemCache;
 	ResRefRCCache<Spell> SpellCache;
 	ResRefRCCache<Effect> EffectCache;
@@ -1827,6 +1827,7 @@ void SetVariable(Scriptable* Sender, const StringParam& VarName, ieDword value,
 		} else if (!NoCreate) {
 			vars[key] = value;
 		}
+		Game::VariablesChanged();
 	};
 
 	if (context.IsEmpty()) {
@@ -1842,6 +1842,7 @@ Script* GameScript::CacheScript(const ResRef& resRef, bool AIScript)
 		stream->ReadLine(line, 10);
 	}
 	delete stream;
+	newScript->Compile();
 	return newScript;
 }
 
@@ -1871,7 +1872,7 @@ bool GameScript::Update(bool* continuing, bool* done)
 	RandomNumValue = RAND<int>();
 	for (size_t a = 0; a < script->responseBlocks.size(); a++) {
 		ResponseBlock* rB = script->responseBlocks[a];
-		if (!rB->condition->Evaluate(MySelf)) {
+		if (!script->EvaluateCondition(a, MySelf)) {
 			continue;
 		}
 
@@ -2017,21 +2018,25 @@ int GameScript::EvaluateString(Scriptable* Sender, const char* String)
 	return 0;
 }
 
-bool Condition::Evaluate(Scriptable* Sender) const
+// shared by the plain and the compiled conditions
+// evaluate(i) returns the result of the i-th trigger
+template<typename EVAL>
+static bool EvaluateTriggers(size_t count, EVAL evaluate)
 {
 	int ORcount = 0;
 	unsigned int result = 0;
 	bool subresult = true;
 
-	if (triggers.empty()) {
+	if (!count) {
 		return true;
 	}
 
-	for (const Trigger* tR : triggers) {
+	bool efficientOr = core->HasFeature(GFFlags::EFFICIENT_OR);
+	for (size_t i = 0; i < count; ++i) {
 		//do not evaluate triggers in an Or() block if one of them
 		//was already True() ... but this sane approach was only used in iwd2!
-		if (!core->HasFeature(GFFlags::EFFICIENT_OR) || !ORcount || !subresult) {
-			result = tR->Evaluate(Sender);
+		if (!efficientOr || !ORcount || !subresult) {
+			result = evaluate(i);
 		}
 		if (result > 1) {
 			//we started an Or() block
@@ -2063,6 +2068,119 @@ bool Condition::Evaluate(Scriptable* Sender) const
 	return true;
 }
 
+bool Condition::Evaluate(Scriptable* Sender) const
+{
+	return EvaluateTriggers(triggers.size(), [this, Sender](size_t i) {
+		return triggers[i]->Evaluate(Sender);
+	});
+}
+
+uint64_t Script::savedEvaluations = 0;
+
+static bool IsGlobalContext(const VarContext& context)
+{
+	return context == "GLOBAL" || (HasKaputz && context == "KAPUTZ");
+}
+
+// the scope is the name prefix when there is no explicit context, like in CheckVariable
+static bool IsGlobalVariable(const StringParam& name)
+{
+	VarContext context;
+	context.Format("{:.6}", name);
+	return IsGlobalContext(context);
+}
+
+// variable triggers whose result doesn't depend on the caller, when their variables are global
+static bool IsPureTrigger(const CompiledTrigger& op)
+{
+	TriggerFunction func = op.function;
+	const Trigger* tR = op.trigger;
+
+	if (func == GameScript::GlobalsEqual || func == GameScript::GlobalsGT || func == GameScript::GlobalsLT ||
+	    func == GameScript::GLT_Trigger || func == GameScript::GGT_Trigger) {
+		return true;
+	}
+	if (func == GameScript::Global || func == GameScript::GlobalGT || func == GameScript::GlobalLT ||
+	    func == GameScript::BitCheck || func == GameScript::BitCheckExact || func == GameScript::Xor ||
+	    func == GameScript::BitGlobal_Trigger) {
+		return IsGlobalVariable(tR->string0Parameter);
+	}
+	if (func == GameScript::GlobalAndGlobal_Trigger || func == GameScript::GlobalOrGlobal_Trigger ||
+	    func == GameScript::GlobalBAndGlobal_Trigger || func == GameScript::GlobalBAndGlobalExact ||
+	    func == GameScript::GlobalBitGlobal_Trigger || func == GameScript::GlobalLTGlobal ||
+	    func == GameScript::GlobalGTGlobal) {
+		return IsGlobalVariable(tR->string0Parameter) && IsGlobalVariable(tR->string1Parameter);
+	}
+	// timers also depend on the game time, which is part of the cache stamp
+	if (func == GameScript::GlobalTimerExact || func == GameScript::GlobalTimerExpired ||
+	    func == GameScript::GlobalTimerNotExpired || func == GameScript::GlobalTimerStarted) {
+		return IsGlobalContext(VarContext(tR->string1Parameter));
+	}
+	return false;
+}
+
+void Script::Compile()
+{
+	code.clear();
+	blockCode.clear();
+	blockCode.reserve(responseBlocks.size());
+	for (const ResponseBlock* rB : responseBlocks) {
+		auto start = static_cast<uint32_t>(code.size());
+		if (rB->condition) {
+			for (const Trigger* tR : rB->condition->triggers) {
+				CompiledTrigger op;
+				op.trigger = tR;
+				op.negate = tR->flags & TF_NEGATE;
+				if (tR->triggerID < MAX_TRIGGERS) {
+					op.function = triggers[tR->triggerID];
+				}
+				if (op.function == GameScript::Or && !op.negate) {
+					op.orCount = tR->int0Parameter;
+				}
+				op.pure = op.function && IsPureTrigger(op);
+				code.push_back(op);
+			}
+		}
+		blockCode.emplace_back(start, static_cast<uint32_t>(code.size()));
+	}
+}
+
+bool Script::EvaluateCondition(size_t block, Scriptable* Sender) const
+{
+	const auto& range = blockCode[block];
+	const CompiledTrigger* ops = code.data() + range.first;
+	// the debug log lives in Trigger::Evaluate
+	bool debug = InDebugMode(DebugMode::TRIGGERS);
+	// variable reads are logged too, so don't hide them behind the cached results
+	bool memoize = !InDebugMode(DebugMode::VARIABLES);
+	const Game* game = core->GetGame();
+	uint32_t time = game ? game->GetGameTime() : 0;
+	uint32_t epoch = Game::GetVariablesEpoch();
+	return EvaluateTriggers(range.second - range.first, [ops, Sender, debug, memoize, time, epoch](size_t i) {
+		const CompiledTrigger& op = ops[i];
+		if (op.orCount) {
+			return op.orCount;
+		}
+		if (!op.function || debug) {
+			return op.trigger->Evaluate(Sender);
+		}
+
+		int ret;
+		if (op.pure && memoize && op.cachedEpoch == epoch && op.cachedTime == time) {
+			ret = op.cachedResult;
+			++savedEvaluations;
+		} else {
+			ret = op.function(Sender, op.trigger);
+			if (op.pure) {
+				op.cachedResult = ret;
+				op.cachedTime = time;
+				op.cachedEpoch = epoch;
+			}
+		}
+		return op.negate ? int(!ret) : ret;
+	});
+}
+
 /* this may return more than a boolean, in case of Or(x) */
 int Trigger::Evaluate(Scriptable* Sender) const
 {
@@ -2071,17 +2189,23 @@ int Trigger::Evaluate(Scriptable* Sender) const
 		return 0;
 	}
 	TriggerFunction func = triggers[triggerID];
-	StringView tmpstr = triggersTable->GetValue(triggerID);
-	if (tmpstr.empty()) {
-		tmpstr = triggersTable->GetValue(triggerID | 0x4000);
-	}
+	// the name is only needed for logging
+	auto triggerName = [this]() {
+		StringView tmpstr = triggersTable->GetValue(triggerID);
+		if (tmpstr.empty()) {
+			tmpstr = triggersTable->GetValue(triggerID | 0x4000);
+		}
+		return tmpstr;
+	};
 	if (!func) {
 		triggers[triggerID] = GameScript::False;
 		Log(WARNING, "GameScript", "Unhandled trigger code: {:#x} {}",
-		    triggerID, tmpstr);
+		    triggerID, triggerName());
 		return 0;
 	}
-	ScriptDebugLog(DebugMode::TRIGGERS, "Executing trigger code: {:#x} {} (Sender: {} / {})", triggerID, tmpstr, Sender->GetScriptName(), fmt::WideToChar { Sender->GetName() });
+	if (InDebugMode(DebugMode::TRIGGERS)) {
+		Log(DEBUG, "GameScript", "Executing trigger code: {:#x} {} (Sender: {} / {})", triggerID, triggerName(), Sender->GetScriptName(), fmt::WideToChar { Sender->GetName() });
+	}
 
 	int ret = func(Sender, this);
 	if (flags & TF_NEGATE) {
@@ -363,6 +363,24 @@ public:
 	ResponseSet* responseSet = nullptr;
 };
 
+using TriggerFunction = int (*)(Scriptable*, const Trigger*);
+
+// a trigger lowered for quick evaluation, see Script::Compile
+struct CompiledTrigger {
+	// nullptr means going through Trigger::Evaluate (unknown or broken triggers)
+	TriggerFunction function = nullptr;
+	const Trigger* trigger = nullptr;
+	// set for Or(), which doesn't need to be called, since it just returns its count
+	int orCount = 0;
+	bool negate = false;
+	// only reads global variables and the game time, so the result is the same for every caller
+	bool pure = false;
+	// last result of a pure trigger, valid while the game time and variables epoch match
+	mutable int cachedResult = 0;
+	mutable uint32_t cachedTime = 0;
+	mutable uint32_t cachedEpoch = 0;
+};
+
 class GEM_EXPORT Script final : protected Canary {
 public:
 	~Script() noexcept override
@@ -381,9 +399,23 @@ public:
 	{
 		delete this;
 	}
+
+	// lower all the block conditions into one flat array; call once after loading
+	void Compile();
+	// same result as responseBlocks[block]->condition->Evaluate(Sender)
+	bool EvaluateCondition(size_t block, Scriptable* Sender) const;
+
+	// how many trigger calls were answered from the pure trigger results
+	static uint64_t GetSavedEvaluations() { return savedEvaluations; }
+
+private:
+	std::vector<CompiledTrigger> code;
+	// start and end of each block's triggers in code
+	std::vector<std::pair<uint32_t, uint32_t>> blockCode;
+
+	static uint64_t savedEvaluations;
 };
 
-using TriggerFunction = int (*)(Scriptable*, const Trigger*);
 using ActionFunction = void (*)(Scriptable*, Action*);
 using ObjectFunction = Targets* (*) (const Scriptable*, Targets*, int ga_flags);
 using IDSFunction = int (*)(const Actor*, int parameter);
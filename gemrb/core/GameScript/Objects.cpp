@@ -809,10 +809,9 @@ Targets* GameScript::LeastDamagedOf(const Scriptable* Sender, Targets* parameter
 Targets* GameScript::Farthest(const Scriptable* /*Sender*/, Targets* parameters, int ga_flags)
 {
 	const targettype* t = parameters->GetLastTarget(ST_ACTOR);
+	Scriptable* farthest = t ? t->actor : nullptr;
 	parameters->Clear();
-	if (t) {
-		parameters->AddTarget(t->actor, 0, ga_flags);
-	}
+	parameters->AddTarget(farthest, 0, ga_flags);
 	return parameters;
 }
 
@@ -23,13 +23,99 @@
 
 #include "GameScript/GSUtils.h"
 
+#include <algorithm>
+
 namespace GemRB {
 
+// only the main thread evaluates scripts, so no locking is needed
+struct TargetsPool {
+	static constexpr size_t MAX_FREE = 64;
+
+	std::vector<void*> blocks;
+	std::vector<targetlist> lists;
+
+	~TargetsPool()
+	{
+		for (void* block : blocks) {
+			::operator delete(block);
+		}
+	}
+};
+
+static TargetsPool& Pool()
+{
+	static TargetsPool pool;
+	return pool;
+}
+
+static bool Closer(const targettype& a, const targettype& b)
+{
+	if (a.distance != b.distance) return a.distance < b.distance;
+	return a.order < b.order;
+}
+
+Targets::Targets() noexcept
+{
+	auto& lists = Pool().lists;
+	if (!lists.empty()) {
+		objects = std::move(lists.back());
+		lists.pop_back();
+	}
+}
+
+Targets::~Targets()
+{
+	auto& lists = Pool().lists;
+	if (lists.size() < TargetsPool::MAX_FREE && objects.capacity()) {
+		objects.clear();
+		lists.push_back(std::move(objects));
+	}
+}
+
+void* Targets::operator new(size_t size)
+{
+	auto& blocks = Pool().blocks;
+	if (size != sizeof(Targets) || blocks.empty()) {
+		return ::operator new(size);
+	}
+	void* block = blocks.back();
+	blocks.pop_back();
+	return block;
+}
+
+void Targets::operator delete(void* ptr, size_t size) noexcept
+{
+	if (!ptr) return;
+	auto& blocks = Pool().blocks;
+	if (size != sizeof(Targets) || blocks.size() >= TargetsPool::MAX_FREE) {
+		::operator delete(ptr);
+		return;
+	}
+	blocks.push_back(ptr);
+}
+
+void Targets::Sort()
+{
+	if (sorted) return;
+	std::sort(objects.begin(), objects.end(), Closer);
+	sorted = true;
+}
+
 size_t Targets::Count() const
 {
 	return objects.size();
 }
 
+void Targets::Pop()
+{
+	if (objects.empty()) return;
+	if (sorted) {
+		objects.erase(objects.begin());
+	} else {
+		objects.erase(std::min_element(objects.begin(), objects.end(), Closer));
+	}
+}
+
 targettype* Targets::RemoveTargetAt(targetlist::iterator& m)
 {
 	m = objects.erase(m);
@@ -41,17 +127,20 @@ targettype* Targets::RemoveTargetAt(targetlist::iterator& m)
 
 const targettype* Targets::GetLastTarget(ScriptableType type)
 {
-	targetlist::const_iterator m = objects.end();
-	while (m-- != objects.begin()) {
-		if (type == ST_ANY || (*m).actor->Type == type) {
-			return &(*m);
+	// the farthest, no need to sort for that
+	const targettype* last = nullptr;
+	for (const auto& object : objects) {
+		if (type != ST_ANY && object.actor->Type != type) continue;
+		if (!last || Closer(*last, object)) {
+			last = &object;
 		}
 	}
-	return nullptr;
+	return last;
 }
 
 const targettype* Targets::GetFirstTarget(targetlist::iterator& m, ScriptableType type)
 {
+	Sort();
 	m = objects.begin();
 	while (m != objects.end()) {
 		if (type != ST_ANY && (*m).actor->Type != type) {
@@ -78,17 +167,29 @@ const targettype* Targets::GetNextTarget(targetlist::iterator& m, ScriptableType
 
 Scriptable* Targets::GetTarget(unsigned int index, ScriptableType type)
 {
-	targetlist::iterator m = objects.begin();
-	while (m != objects.end()) {
-		if (type == ST_ANY || (*m).actor->Type == type) {
+	auto matches = [type](const targettype& object) {
+		return type == ST_ANY || object.actor->Type == type;
+	};
+
+	if (sorted) {
+		for (const auto& object : objects) {
+			if (!matches(object)) continue;
 			if (!index) {
-				return (*m).actor;
+				return object.actor;
 			}
 			index--;
 		}
-		++m;
+		return nullptr;
 	}
-	return nullptr;
+
+	// only the one at this rank is needed, so select it instead of sorting everything
+	auto end = std::partition(objects.begin(), objects.end(), matches);
+	if (index >= static_cast<size_t>(end - objects.begin())) {
+		return nullptr;
+	}
+	auto nth = objects.begin() + index;
+	std::nth_element(objects.begin(), nth, end, Closer);
+	return nth->actor;
 }
 
 void Targets::AddTarget(Scriptable* target, unsigned int distance, int flags)
@@ -113,25 +214,27 @@ void Targets::AddTarget(Scriptable* target, unsigned int distance, int flags)
 			break;
 	}
 
-	targettype newTarget = { target, distance };
-	for (auto m = objects.begin(); m != objects.end(); ++m) {
-		if ((*m).distance > distance) {
-			objects.insert(m, newTarget);
-			return;
-		}
+	// the new target comes after any earlier one at the same distance
+	if (!objects.empty() && objects.back().distance > distance) {
+		sorted = false;
 	}
-	objects.push_back(newTarget);
+	objects.push_back({ target, distance, nextOrder++ });
 }
 
 void Targets::Clear()
 {
 	objects.clear();
+	nextOrder = 0;
+	sorted = true;
 }
 
 void Targets::dump() const
 {
+	targetlist ordered = objects;
+	std::sort(ordered.begin(), ordered.end(), Closer);
+
 	Log(DEBUG, "GameScript", "Target dump (actors only):");
-	for (const auto& object : objects) {
+	for (const auto& object : ordered) {
 		if (object.actor->Type == ST_ACTOR) {
 			Log(DEBUG, "GameScript", "{}", fmt::WideToChar { object.actor->GetName() });
 		}
@@ -143,13 +246,10 @@ void Targets::FilterObjectRect(const Object* oC)
 	// can't match anything if the second pair of coordinates (or all of them) are unset
 	if (oC->objectRect.w <= 0 || oC->objectRect.h <= 0) return;
 
-	for (auto m = objects.begin(); m != objects.end();) {
-		if (!IsInObjectRect((*m).actor->Pos, oC->objectRect)) {
-			m = objects.erase(m);
-		} else {
-			++m;
-		}
-	}
+	auto outside = [oC](const targettype& object) {
+		return !IsInObjectRect(object.actor->Pos, oC->objectRect);
+	};
+	objects.erase(std::remove_if(objects.begin(), objects.end(), outside), objects.end());
 }
 
 }
@@ -25,6 +25,8 @@
 
 #include "Scriptable/Scriptable.h"
 
+#include <vector>
+
 namespace GemRB {
 
 class Actor;
@@ -33,18 +35,35 @@ class Object;
 struct targettype {
 	Scriptable* actor; // could be door
 	unsigned int distance;
+	// insertion order, breaks distance ties the same way every time
+	unsigned int order;
 };
 
-using targetlist = std::list<targettype>;
+using targetlist = std::vector<targettype>;
 
+// Targets are created and thrown away for every object reference a script
+// evaluates, so both the objects and their buffers are recycled instead of
+// going back to the allocator.
+// The targets are only sorted by distance once something needs the order,
+// picking a single one by rank just does a partial selection.
 class GEM_EXPORT Targets {
 	targetlist objects;
+	unsigned int nextOrder = 0;
+	bool sorted = true;
+
+	void Sort();
 
 public:
-	Targets() noexcept {};
+	Targets() noexcept;
+	Targets(const Targets&) = delete;
+	~Targets();
+	Targets& operator=(const Targets&) = delete;
+
+	static void* operator new(size_t size);
+	static void operator delete(void* ptr, size_t size) noexcept;
 
 	size_t Count() const;
-	void Pop() { objects.pop_front(); };
+	void Pop();
 	targettype* RemoveTargetAt(targetlist::iterator& m);
 	const targettype* GetNextTarget(targetlist::iterator& m, ScriptableType type);
 	const targettype* GetLastTarget(ScriptableType type);
@@ -40,6 +40,7 @@
 #include "EffectQueue.h"
 #include "Factory.h"
 #include "FontManager.h"
+#include "FrameProfiler.h"
 #include "Game.h"
 #include "ItemMgr.h"
 #include "KeyMap.h"
@@ -58,6 +59,7 @@
 #include "SpellMgr.h"
 #include "StoreMgr.h"
 #include "SymbolMgr.h"
+#include "TickBenchmark.h"
 #include "TileMap.h"
 #include "VEFObject.h"
 #include "WorldMapMgr.h"
@@ -238,6 +240,9 @@ Interface::Interface(CoreSettings&& cfg)
 	core = this;
 
 	SetDebugMode(DebugMode(config.debugMode));
+	if (config.RandomSeed) {
+		RNG::getInstance().Seed(config.RandomSeed);
+	}
 
 #if defined(WIN32)
 	const uint32_t codepage = GetACP();
@@ -651,6 +656,11 @@ Interface::~Interface() noexcept
 	delete displaymsg;
 	delete TooltipBG;
 
+	// the background sound decoding still reads through it
+	if (AudioDriver && AudioDriver->GetSoundCache()) {
+		AudioDriver->GetSoundCache()->Stop();
+	}
+
 	// delete and nullify this global data as well
 	delete gamedata;
 	gamedata = nullptr;
@@ -957,6 +967,12 @@ void Interface::DisableMusicPlaylist(size_t SongType)
 /** this is the main loop */
 void Interface::Main()
 {
+	if (config.BenchmarkTicks > 0) {
+		RunBenchmark();
+		QuitGame(0);
+		return;
+	}
+
 	int speed = vars.Get("Mouse Scroll Speed", 10);
 	SetMouseScrollSpeed(speed + 1);
 
@@ -982,6 +998,22 @@ void Interface::Main()
 	// set for printing
 	fpsRgn.x = 5;
 	fpsRgn.y = 0;
+	// one line per phase, plus the frame total
+	Region profileRgn(5, 30, 260, (int(ProfilePhase::count) + 1) * fps->LineHeight);
+
+	FrameProfiler& profiler = FrameProfiler::Get();
+	if (config.ProfileFrames) {
+		profiler.SetEnabled(true);
+	}
+	auto swapBuffers = [&]() {
+		int ret;
+		{
+			ProfileScope profile(ProfilePhase::SwapBuffers);
+			ret = VideoDriver->SwapBuffers(config.CapFPS);
+		}
+		profiler.EndFrame();
+		return ret;
+	};
 
 	tick_t frame = 0;
 	tick_t time = GetMilliseconds();
@@ -1024,6 +1056,7 @@ void Interface::Main()
 			GlobalColorCycle.AdvanceTime(time);
 			lastGameUpdate = time;
 		}
+		AudioDriver->DispatchPending();
 
 		winmgr->DrawWindows();
 		if (config.DrawFPS) {
@@ -1038,8 +1071,13 @@ void Interface::Main()
 			VideoDriver->DrawRect(fpsRgn, ColorBlack);
 			fps->Print(fpsRgn, String(fpsstring), IE_FONT_ALIGN_MIDDLE | IE_FONT_SINGLE_LINE, { ColorWhite, ColorBlack });
 		}
+		if (profiler.IsEnabled()) {
+			auto lock = winmgr->DrawHUD();
+			VideoDriver->DrawRect(profileRgn, ColorBlack);
+			fps->Print(profileRgn, profiler.Summary(), IE_FONT_ALIGN_LEFT | IE_FONT_ALIGN_TOP, { ColorWhite, ColorBlack });
+		}
 
-	} while (VideoDriver->SwapBuffers(config.CapFPS) == GEM_OK && !(QuitFlag & QF_KILL));
+	} while (swapBuffers() == GEM_OK && !(QuitFlag & QF_KILL));
 	QuitGame(0);
 }
 
@@ -1823,6 +1861,87 @@ void Interface::GameLoop(void)
 	}
 }
 
+void Interface::RunBenchmark()
+{
+	TickBenchmark bench;
+	if (!config.BenchmarkReplay.empty()) {
+		FileStream replay;
+		if (!replay.Open(config.BenchmarkReplay) || !bench.LoadReplay(replay)) {
+			Log(ERROR, "Benchmark", "Unable to load the replay {}!", config.BenchmarkReplay);
+			return;
+		}
+	}
+
+	// let the start scripts run, so the game is loaded the same way as from the menus
+	while (QuitFlag && QuitFlag != QF_KILL) {
+		HandleFlags();
+	}
+
+	Holder<SaveGame> save = GetSaveGameIterator()->GetSaveGame(StringFromUtf8(config.BenchmarkSave));
+	if (!save) {
+		Log(ERROR, "Benchmark", "No save game called {}!", config.BenchmarkSave);
+		return;
+	}
+
+	// fixed seed and clock, so that repeated runs simulate exactly the same
+	RNG::getInstance().Seed(config.RandomSeed);
+	tick_t oldClock = ManualTime;
+	if (!oldClock) {
+		ManualTime = GetMilliseconds();
+	}
+
+	SetupLoadGame(std::move(save), 0);
+	QuitFlag |= QF_ENTERGAME;
+	while (QuitFlag && QuitFlag != QF_KILL) {
+		HandleFlags();
+	}
+	if (!game) {
+		Log(ERROR, "Benchmark", "Unable to load {}!", config.BenchmarkSave);
+		ManualTime = oldClock;
+		return;
+	}
+
+	FrameProfiler& profiler = FrameProfiler::Get();
+	bool profiling = profiler.IsEnabled();
+	profiler.SetEnabled(true);
+	const tick_t oneTick = 1000 / Time.ticksPerSec;
+	// the first update only starts the global timer
+	GameLoop();
+	AudioDriver->DispatchPending();
+	profiler.EndFrame();
+
+	auto start = FrameProfiler::Clock::now();
+	for (uint32_t tick = 0; game && tick < uint32_t(config.BenchmarkTicks); ++tick) {
+		// same order as in the main loop, minus everything that draws
+		while (QuitFlag && QuitFlag != QF_KILL) {
+			HandleFlags();
+		}
+		if (QuitFlag & QF_KILL || !game) break;
+		if (gamectrl) {
+			if (EventFlag) {
+				HandleEvents();
+			}
+			HandleGUIBehaviour(gamectrl);
+		}
+
+		bench.Inject(*game, tick);
+		ManualTime += oneTick;
+		GameLoop();
+		AudioDriver->DispatchPending();
+		profiler.EndFrame();
+		bench.AddTick(*profiler.GetFrame(0));
+	}
+	auto elapsed = FrameProfiler::Clock::now() - start;
+
+	if (game) {
+		bench.LogReport(elapsed, TickBenchmark::StateHash(*game));
+	} else {
+		Log(ERROR, "Benchmark", "The game ended after {} ticks!", bench.GetTicks());
+	}
+	profiler.SetEnabled(profiling);
+	ManualTime = oldClock;
+}
+
 /** handles hardcoded gui behaviour */
 void Interface::HandleGUIBehaviour(GameControl* gc)
 {
@@ -2505,6 +2624,9 @@ void Interface::LoadGame(Holder<SaveGame> sg, int ver_override)
 		savStr = nullptr;
 	}
 
+	// the rest of the loading and the start of the game happen in between
+	gamedata->PrefetchArea(newGame->CurrentArea);
+
 	// rarely caused crashes while loading, so stop the ambients
 	if (ambim) {
 		ambim->Reset();
@@ -3769,13 +3891,19 @@ static bool IsBlobSaveItem(const path_t& path)
 
 int Interface::CompressSave(const path_t& folder, bool overrideRunning)
 {
-	FileStream str;
-
-	str.Create(folder, GameNameResRef.c_str(), IE_SAV_CLASS_ID);
 	DirectoryIterator dir(config.CachePath);
 	if (!dir) {
 		return GEM_ERROR;
 	}
+
+	// write to the side first, so a failed save never leaves a broken archive behind
+	path_t savePath = PathJoinExt(folder, GameNameResRef, TypeExt(IE_SAV_CLASS_ID));
+	path_t tmpPath = savePath + ".tmp";
+	FileStream str;
+	if (!str.Create(tmpPath)) {
+		Log(ERROR, "Interface", "Failed to create \"{}\".", tmpPath);
+		return GEM_ERROR;
+	}
 	PluginHolder<ArchiveImporter> ai = MakePluginHolder<ArchiveImporter>(IE_SAV_CLASS_ID);
 	ai->CreateArchive(&str);
 
@@ -3784,30 +3912,26 @@ int Interface::CompressSave(const path_t& folder, bool overrideRunning)
 	// itself as "ares.blb" into the cache folder. Otherwise, just copy directly.
 	if (!overrideRunning && saveGameAREExtractor.copyRetainedAREs(&str) == GEM_ERROR) {
 		Log(ERROR, "Interface", "Failed to copy ARE files into new save game.");
+		str.Close();
+		UnlinkFile(tmpPath);
 		return GEM_ERROR;
 	}
 
+	// the areas and stores are already in the cache, so just collect what to pack
+	std::vector<SaveEntry> entries;
 	dir.SetFlags(DirectoryIterator::Files);
 	//.tot and .toh should be saved last, because they are updated when an .are is saved
 	int priority = 2;
 	while (priority) {
 		do {
 			const path_t& name = dir.GetName();
-			if (SavedExtension(name) == priority) {
-				path_t dtmp = dir.GetFullPath();
-				FileStream fs;
-				if (!fs.Open(dtmp)) {
-					Log(ERROR, "Interface", "Failed to open \"{}\".", dtmp);
-				}
+			if (SavedExtension(name) != priority) continue;
 
-				if (IsBlobSaveItem(dtmp)) {
-					if (overrideRunning) {
-						saveGameAREExtractor.updateSaveGame(str.GetPos());
-						ai->AddToSaveGameCompressed(&str, &fs);
-					}
-				} else {
-					ai->AddToSaveGame(&str, &fs);
-				}
+			SaveEntry entry;
+			entry.path = dir.GetFullPath();
+			entry.compressed = IsBlobSaveItem(entry.path);
+			if (!entry.compressed || overrideRunning) {
+				entries.push_back(std::move(entry));
 			}
 		} while (++dir);
 		//reopen list for the second round
@@ -3817,8 +3941,22 @@ int Interface::CompressSave(const path_t& folder, bool overrideRunning)
 		}
 	}
 
+	int ret = ai->AddToSaveGame(&str, entries);
+	str.Close(); // windows won't rename open files
+	if (ret != GEM_OK || !RenameFile(tmpPath, savePath)) {
+		Log(ERROR, "Interface", "Failed to write \"{}\".", savePath);
+		UnlinkFile(tmpPath);
+		return GEM_ERROR;
+	}
+
+	for (const auto& entry : entries) {
+		if (entry.compressed) {
+			saveGameAREExtractor.updateSaveGame(entry.offset);
+		}
+	}
+
 	tick_t endTime = GetMilliseconds();
-	Log(WARNING, "Core", "{} ms (compressing SAV file)", endTime - startTime);
+	Log(WARNING, "Core", "{} ms (compressing SAV file, {} entries)", endTime - startTime, entries.size());
 	return GEM_OK;
 }
 
@@ -686,6 +686,8 @@ private:
 	GameControl* StartGameControl();
 	/** Executes everything (non graphical) in the main game loop */
 	void GameLoop(void);
+	/** Loads BenchmarkSave and runs BenchmarkTicks game ticks without drawing */
+	void RunBenchmark();
 	/** the internal (without cache) part of GetListFrom2DA */
 	std::vector<ieDword> GetListFrom2DAInternal(const ResRef& resref) const;
 
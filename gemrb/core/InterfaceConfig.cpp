@@ -158,25 +158,37 @@ CoreSettings LoadFromDictionary(InterfaceConfig cfg)
 		}
 	};
 
+	CONFIG_INT("BenchmarkTicks", config.BenchmarkTicks);
 	CONFIG_INT("Bpp", config.Bpp);
 	CONFIG_INT("CaseSensitive", config.CaseSensitive);
 	CONFIG_INT("DoubleClickDelay", config.DoubleClickDelay);
 	CONFIG_INT("DrawFPS", config.DrawFPS);
+	CONFIG_INT("ProfileFrames", config.ProfileFrames);
 	CONFIG_INT("CapFPS", config.CapFPS);
 	CONFIG_INT("FullScreen", config.FullScreen);
 	CONFIG_INT("EnableCheatKeys", config.CheatFlag);
 	CONFIG_INT("GCDebug", config.DebugFlags);
 	CONFIG_INT("GUIEnhancements", config.GUIEnhancements);
 	CONFIG_INT("Height", config.Height);
+	CONFIG_INT("HierarchicalPathfinding", config.HierarchicalPathfinding);
+	CONFIG_INT("IncrementalEffects", config.IncrementalEffects);
+	CONFIG_INT("VerifyIncrementalEffects", config.VerifyIncrementalEffects);
 	CONFIG_INT("KeepCache", config.KeepCache);
+	CONFIG_INT("WarmUpCache", config.WarmUpCache);
 	CONFIG_INT("MaxPartySize", config.MaxPartySize);
 	config.MaxPartySize = std::min(std::max(1, config.MaxPartySize), 10);
 	CONFIG_INT("MouseFeedback", config.MouseFeedback);
 	CONFIG_INT("MultipleQuickSaves", config.MultipleQuickSaves);
+	CONFIG_INT("NullVideoDumpInterval", config.NullVideoDumpInterval);
+	CONFIG_INT("NullVideoFrames", config.NullVideoFrames);
+	CONFIG_INT("NullVideoRaster", config.NullVideoRaster);
+	CONFIG_INT("PrefetchAreas", config.PrefetchAreas);
 	CONFIG_INT("UseAsLibrary", config.UseAsLibrary);
+	CONFIG_INT("RandomSeed", config.RandomSeed);
 	CONFIG_INT("RepeatKeyDelay", config.ActionRepeatDelay);
 	CONFIG_INT("SaveAsOriginal", config.SaveAsOriginal);
 	CONFIG_INT("SpriteFogOfWar", config.SpriteFoW);
+	CONFIG_INT("TerrainChunks", config.TerrainChunks);
 	CONFIG_INT("DebugMode", config.debugMode);
 	CONFIG_INT("TouchInput", config.TouchInput);
 	CONFIG_INT("Width", config.Width);
@@ -219,6 +231,8 @@ CoreSettings LoadFromDictionary(InterfaceConfig cfg)
 	// Path configuration
 	CONFIG_PATH("GemRBPath", config.GemRBPath);
 	CONFIG_PATH("CachePath", config.CachePath);
+	CONFIG_PATH("NullVideoDumpPath", config.NullVideoDumpPath);
+	CONFIG_PATH("BenchmarkReplay", config.BenchmarkReplay);
 
 	// AppImage doesn't support relative urls at all
 	// we set the path to the data dir to cover unhardcoded and co,
@@ -287,6 +301,7 @@ CoreSettings LoadFromDictionary(InterfaceConfig cfg)
 	CONFIG_PATH("SavePath", config.SavePath, config.GamePath);
 
 	CONFIG_STRING("AudioDriver", config.AudioDriverName);
+	CONFIG_STRING("BenchmarkSave", config.BenchmarkSave);
 	CONFIG_STRING("VideoDriver", config.VideoDriverName);
 	CONFIG_STRING("SkipPlugin", config.SkipPlugin);
 	CONFIG_STRING("DelayPlugin", config.DelayPlugin);
@@ -339,6 +354,20 @@ CoreSettings LoadFromArgs(int argc, char* argv[])
 		} else if (stricmp(argv[i], "-q") == 0) {
 			// quiet mode
 			settings.Set("AudioDriver", "none");
+		} else if (stricmp(argv[i], "--headless") == 0) {
+			// no window and no sound, for benchmarks and automated tests
+			settings.Set("AudioDriver", "none");
+			settings.Set("VideoDriver", "none");
+		} else if (stricmp(argv[i], "--benchmark") == 0) {
+			// run the simulation of a saved game as fast as possible
+			if (i < argc - 2) {
+				settings.Set("BenchmarkSave", argv[++i]);
+				settings.Set("BenchmarkTicks", argv[++i]);
+			}
+		} else if (stricmp(argv[i], "--replay") == 0) {
+			if (i < argc - 1) settings.Set("BenchmarkReplay", argv[++i]);
+		} else if (stricmp(argv[i], "--seed") == 0) {
+			if (i < argc - 1) settings.Set("RandomSeed", argv[++i]);
 		} else if (stricmp(argv[i], "-f") == 0) {
 			settings.Set("FullScreen", "1");
 		} else if (stricmp(argv[i], "--color") == 0) {
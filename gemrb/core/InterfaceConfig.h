@@ -93,6 +93,12 @@ struct CoreSettings {
 	int Height = 480;
 	int Bpp = 32;
 	bool DrawFPS = false;
+	bool ProfileFrames = false;
+	// simulation benchmark, see Interface::RunBenchmark
+	std::string BenchmarkSave;
+	int BenchmarkTicks = 0;
+	path_t BenchmarkReplay;
+	int RandomSeed = 0; // 0 seeds from the clock, except in benchmarks
 	int CapFPS = 0;
 	bool FullScreen = false;
 	bool SpriteFoW = false;
@@ -104,11 +110,22 @@ struct CoreSettings {
 	int GUIEnhancements = 23;
 
 	bool KeepCache = false;
+	bool WarmUpCache = false;
 	bool MultipleQuickSaves = false;
+	bool HierarchicalPathfinding = false;
+	bool PrefetchAreas = false;
+	bool TerrainChunks = false;
+	bool IncrementalEffects = false;
+	bool VerifyIncrementalEffects = false;
 	bool UseAsLibrary = false;
 	// once GemRB own format is working well, this might be set to 0
 	int SaveAsOriginal = 1; // if true, saves files in compatible mode
 	std::string VideoDriverName = "sdl"; // consider deprecating? It's now a hidden option
+	// only used by the "none" video driver
+	bool NullVideoRaster = false;
+	int NullVideoFrames = 0;
+	int NullVideoDumpInterval = 0;
+	path_t NullVideoDumpPath;
 	std::string AudioDriverName = "openal";
 	std::string SkipPlugin;
 	std::string DelayPlugin;
@@ -0,0 +1,86 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "LineCache.h"
+
+namespace GemRB {
+
+bool LineCache::Key::operator==(const Key& other) const noexcept
+{
+	return s == other.s && d == other.d && speed == other.speed && size == other.size && kind == other.kind;
+}
+
+size_t LineCache::Slot(const Key& key)
+{
+	size_t hash = 0;
+	for (int val : { key.s.x, key.s.y, key.d.x, key.d.y, key.speed, key.size, int(key.kind) }) {
+		hash = hash * 31 + static_cast<unsigned int>(val);
+	}
+	hash ^= hash >> 15;
+	return hash & (CACHE_SIZE - 1);
+}
+
+bool LineCache::Lookup(const Key& key, uint32_t epoch, PathMapFlags& result) const
+{
+	if (!entries.empty()) {
+		const Entry& entry = entries[Slot(key)];
+		if (entry.valid && entry.epoch == epoch && entry.key == key) {
+			result = entry.result;
+			++hits;
+			return true;
+		}
+	}
+	++misses;
+	return false;
+}
+
+void LineCache::Store(const Key& key, uint32_t epoch, PathMapFlags result)
+{
+	// only pay for the table in areas where someone actually asks
+	if (entries.empty()) {
+		entries.resize(CACHE_SIZE);
+	}
+
+	Entry& entry = entries[Slot(key)];
+	entry.key = key;
+	entry.epoch = epoch;
+	entry.result = result;
+	entry.valid = true;
+}
+
+void LineCache::Clear()
+{
+	entries.clear();
+}
+
+unsigned int LineCache::GetHitRate() const
+{
+	uint64_t total = hits + misses;
+	if (!total) return 0;
+	return static_cast<unsigned int>(hits * 100 / total);
+}
+
+void LineCache::ResetStats()
+{
+	hits = 0;
+	misses = 0;
+}
+
+}
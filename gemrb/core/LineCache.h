@@ -0,0 +1,88 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef LINECACHE_H
+#define LINECACHE_H
+
+#include "exports.h"
+
+#include "PathFinder.h"
+#include "Region.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace GemRB {
+
+// Small direct mapped cache for the results of the searchmap line walks
+// done by Map::IsVisibleLOS and Map::IsWalkableTo. Each entry remembers the
+// searchmap epoch (see TileProps) it was computed in, so any change to the
+// searchmap makes the older entries stale without having to clear anything.
+class GEM_EXPORT LineCache {
+public:
+	enum class Kind : uint8_t {
+		LOSNavmap,
+		LOSSearchmap,
+		WalkNavmap,
+		WalkSearchmap
+	};
+
+	struct Key {
+		Point s;
+		Point d;
+		// speed and circle size of the caller, they change which cells get checked
+		// size is -1 when there is no caller, since that skips the radius check
+		int speed = 0;
+		int size = -1;
+		Kind kind = Kind::LOSNavmap;
+
+		bool operator==(const Key& other) const noexcept;
+	};
+
+	static constexpr size_t CACHE_SIZE = 2048; // power of two
+
+	bool Lookup(const Key& key, uint32_t epoch, PathMapFlags& result) const;
+	void Store(const Key& key, uint32_t epoch, PathMapFlags result);
+	void Clear();
+
+	uint64_t GetHits() const { return hits; }
+	uint64_t GetMisses() const { return misses; }
+	// in percent
+	unsigned int GetHitRate() const;
+	void ResetStats();
+
+private:
+	struct Entry {
+		Key key;
+		uint32_t epoch = 0;
+		PathMapFlags result = PathMapFlags::IMPASSABLE;
+		bool valid = false;
+	};
+
+	std::vector<Entry> entries;
+	mutable uint64_t hits = 0;
+	mutable uint64_t misses = 0;
+
+	static size_t Slot(const Key& key);
+};
+
+}
+
+#endif
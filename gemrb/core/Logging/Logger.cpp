@@ -20,7 +20,10 @@
 
 #include "Logging/Logging.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <cstring>
 
 namespace GemRB {
 
@@ -36,8 +39,13 @@ const EnumArray<LogLevel, LOG_FMT> Logger::LevelFormat {
 const LOG_FMT Logger::MSG_STYLE = fmt::fg(fmt::color::ghost_white);
 
 Logger::Logger(std::deque<WriterPtr> writers)
-	: writers(std::move(writers))
-{}
+	: queue(new Slot[QUEUE_SIZE]), writers(std::move(writers))
+{
+	for (size_t i = 0; i < QUEUE_SIZE; ++i) {
+		queue[i].seq.store(i, std::memory_order_relaxed);
+	}
+	UpdateMaxLevel();
+}
 
 Logger::~Logger()
 {
@@ -49,22 +57,28 @@ Logger::~Logger()
 
 void Logger::StartProcessingThread()
 {
-	loggingThread = std::thread([this] {
-		while (running) {
-			QueueType queue;
-			std::unique_lock<std::mutex> lk(queueLock);
-			cv.wait(lk, [this]() { return !messageQueue.empty() || !running; });
-			queue.swap(messageQueue);
-			lk.unlock();
-			ProcessMessages(std::move(queue));
+	loggingThread = std::thread(&Logger::threadLoop, this);
+}
+
+void Logger::threadLoop()
+{
+	while (running) {
+		{
+			std::unique_lock<std::mutex> lk(wakeLock);
+			// the producers don't take the lock, so don't rely on being woken up
+			cv.wait_for(lk, std::chrono::milliseconds(20), [this]() { return HasPending() || !running; });
 		}
-	});
+		ProcessMessages();
+	}
+	// whatever was logged while shutting down
+	ProcessMessages();
 }
 
 void Logger::AddLogWriter(WriterPtr writer)
 {
 	std::lock_guard<std::mutex> l(writerLock);
 	writers.push_back(std::move(writer));
+	UpdateMaxLevel();
 
 	if (!loggingThread.joinable()) {
 		StartProcessingThread();
@@ -72,14 +86,58 @@ void Logger::AddLogWriter(WriterPtr writer)
 	}
 }
 
-void Logger::ProcessMessages(QueueType queue)
+void Logger::UpdateMaxLevel()
+{
+	// until there are writers, everything is kept for the first one
+	LogLevel level = writers.empty() ? DEBUG : FATAL;
+	for (const auto& writer : writers) {
+		level = std::max<LogLevel>(level, writer->level);
+	}
+	maxLevel = level;
+}
+
+bool Logger::HasPending() const
+{
+	size_t pos = tail.load(std::memory_order_relaxed);
+	return queue[pos & (QUEUE_SIZE - 1)].seq.load(std::memory_order_acquire) == pos + 1;
+}
+
+void Logger::WriteToWriters(const LogMessage& msg)
+{
+	for (const auto& writer : writers) {
+		if (msg.level <= writer->level || msg.level == INTERNAL) {
+			writer->WriteLogMessage(msg);
+		}
+	}
+}
+
+void Logger::ProcessMessages()
 {
 	std::lock_guard<std::mutex> l(writerLock);
-	while (!queue.empty()) {
-		for (const auto& writer : writers) {
-			writer->WriteLogMessage(queue.front());
+	if (!HasPending()) return;
+
+	LogMessage& msg = current;
+	while (HasPending()) {
+		size_t pos = tail.load(std::memory_order_relaxed);
+		Slot& slot = queue[pos & (QUEUE_SIZE - 1)];
+		msg.level = slot.level;
+		msg.format = slot.format;
+		msg.owner.assign(slot.owner, slot.ownerLength);
+		if (slot.longMessage.empty()) {
+			msg.message.assign(slot.message, slot.messageLength);
+		} else {
+			msg.message.swap(slot.longMessage);
+			slot.longMessage.clear();
 		}
-		queue.pop_front();
+		slot.seq.store(pos + QUEUE_SIZE, std::memory_order_release);
+		tail.store(pos + 1, std::memory_order_relaxed);
+
+		WriteToWriters(msg);
+	}
+
+	size_t lost = dropped.exchange(0);
+	if (lost) {
+		WriteToWriters(LogMessage(WARNING, "Logger", fmt::format("The log queue was full, {} messages were dropped.", lost), MSG_STYLE));
 	}
 	for (const auto& writer : writers) {
 		writer->Flush();
@@ -88,23 +146,59 @@ void Logger::ProcessMessages(QueueType queue)
 
 void Logger::LogMsg(LogLevel level, const char* owner, const char* message, LOG_FMT fmt)
 {
-	LogMsg(LogMessage(level, owner, message, fmt));
+	LogMsg(level, owner, message, strlen(message), fmt);
 }
 
 void Logger::LogMsg(LogMessage&& msg)
 {
-	if (msg.level == FATAL) {
-		// fatal errors must happen now!
+	LogMsg(msg.level, msg.owner.c_str(), msg.message.c_str(), msg.message.length(), msg.format);
+}
+
+void Logger::LogMsg(LogLevel level, const char* owner, const char* message, size_t length, LOG_FMT fmt)
+{
+	if (level == FATAL) {
+		// fatal errors must happen now! But after what led to them
+		ProcessMessages();
+		LogMessage msg(level, owner, std::string(message, length), fmt);
 		std::lock_guard<std::mutex> l(writerLock);
 		for (const auto& writer : writers) {
 			writer->WriteLogMessage(msg);
 			writer->Flush();
 		}
+		return;
+	}
+
+	size_t pos = head.load(std::memory_order_relaxed);
+	Slot* slot;
+	while (true) {
+		slot = &queue[pos & (QUEUE_SIZE - 1)];
+		size_t seq = slot->seq.load(std::memory_order_acquire);
+		auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+		if (diff == 0) {
+			if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+		} else if (diff < 0) {
+			// full, the processing thread is too far behind
+			++dropped;
+			++droppedTotal;
+			return;
+		} else {
+			pos = head.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->level = level;
+	slot->format = fmt;
+	size_t ownerLength = std::min(strlen(owner), OWNER_SIZE);
+	memcpy(slot->owner, owner, ownerLength);
+	slot->ownerLength = static_cast<uint8_t>(ownerLength);
+	if (length <= MESSAGE_SIZE) {
+		memcpy(slot->message, message, length);
+		slot->messageLength = static_cast<uint16_t>(length);
 	} else {
-		std::lock_guard<std::mutex> l(queueLock);
-		messageQueue.push_back(std::move(msg));
-		cv.notify_all();
+		slot->longMessage.assign(message, length);
 	}
+	slot->seq.store(pos + 1, std::memory_order_release);
+	cv.notify_one();
 }
 
 void Logger::Flush()
@@ -38,6 +38,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace GemRB {
 
@@ -89,19 +90,50 @@ public:
 	using WriterPtr = std::shared_ptr<LogWriter>;
 
 private:
-	using QueueType = std::deque<LogMessage>;
-	QueueType messageQueue;
+	// Messages go through a bounded ring of fixed size slots, claimed without a lock
+	// by the logging threads and drained by the processing thread. When it is full,
+	// messages are dropped and counted instead of blocking the game.
+	static constexpr size_t QUEUE_SIZE = 4096; // power of two
+	static constexpr size_t OWNER_SIZE = 32;
+	static constexpr size_t MESSAGE_SIZE = 480;
+
+	struct Slot {
+		std::atomic<size_t> seq { 0 };
+		LogLevel level = DEBUG;
+		LOG_FMT format;
+		uint8_t ownerLength = 0;
+		uint16_t messageLength = 0;
+		char owner[OWNER_SIZE];
+		char message[MESSAGE_SIZE];
+		// only used by the rare messages that don't fit
+		std::string longMessage;
+	};
+
+	std::unique_ptr<Slot[]> queue;
+	alignas(64) std::atomic<size_t> head { 0 };
+	// only advanced by whoever holds writerLock
+	alignas(64) std::atomic<size_t> tail { 0 };
+	std::atomic<size_t> dropped { 0 };
+	std::atomic<size_t> droppedTotal { 0 };
+
 	std::deque<WriterPtr> writers;
+	// reused, so its strings only grow a few times
+	LogMessage current { DEBUG, std::string(), std::string(), MSG_STYLE };
+	// the most verbose level any writer wants, so callers can skip formatting
+	std::atomic<LogLevel> maxLevel { DEBUG };
 
 	std::atomic_bool running { true };
 	std::condition_variable cv;
-	std::mutex queueLock;
+	std::mutex wakeLock;
 	std::mutex writerLock;
 	std::thread loggingThread;
 
 	void threadLoop();
-	void ProcessMessages(QueueType queue);
+	bool HasPending() const;
+	void ProcessMessages();
+	void WriteToWriters(const LogMessage& msg);
 	void StartProcessingThread();
+	void UpdateMaxLevel();
 
 public:
 	explicit Logger(std::deque<WriterPtr>);
@@ -110,8 +142,13 @@ public:
 	void AddLogWriter(WriterPtr writer);
 
 	void LogMsg(LogLevel, const char* owner, const char* message, LOG_FMT fmt);
+	void LogMsg(LogLevel, const char* owner, const char* message, size_t length, LOG_FMT fmt);
 	void LogMsg(LogMessage&& msg);
 	void Flush();
+
+	bool WantsLevel(LogLevel level) const { return level <= maxLevel.load(std::memory_order_relaxed) || level == INTERNAL; }
+	// messages lost because the queue was full
+	size_t GetDroppedCount() const { return droppedTotal; }
 };
 
 }
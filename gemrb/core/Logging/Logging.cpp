@@ -90,6 +90,29 @@ void LogMsg(LogMessage&& msg)
 	}
 }
 
+void LogMsg(LogLevel level, const char* owner, const char* message, size_t length, LOG_FMT fmt)
+{
+	// the message may be in the staging buffer, so copy it before anything else can log
+	if (logger) {
+		logger->LogMsg(level, owner, message, length, fmt);
+	}
+	if (level <= CWLL || level == INTERNAL) {
+		ConsoleWinLogMsg(LogMessage(level, owner, std::string(message, length), fmt));
+	}
+}
+
+bool LogLevelEnabled(LogLevel level)
+{
+	if (level <= CWLL || level == INTERNAL) return true;
+	return logger && logger->WantsLevel(level);
+}
+
+fmt::memory_buffer& LogStagingBuffer()
+{
+	static thread_local fmt::memory_buffer buffer;
+	return buffer;
+}
+
 void AddLogWriter(Logger::WriterPtr&& writer)
 {
 	writers.push_back(std::move(writer));
@@ -33,6 +33,7 @@
 #include "fmt/std.h"
 
 #include <cstdarg>
+#include <iterator>
 
 namespace GemRB {
 
@@ -40,13 +41,22 @@ GEM_EXPORT void ToggleLogging(bool);
 GEM_EXPORT void AddLogWriter(Logger::WriterPtr&&);
 GEM_EXPORT void SetConsoleWindowLogLevel(LogLevel level);
 GEM_EXPORT void LogMsg(Logger::LogMessage&& msg);
+GEM_EXPORT void LogMsg(LogLevel level, const char* owner, const char* message, size_t length, LOG_FMT fmt);
 GEM_EXPORT void FlushLogs();
+// false if nobody would see a message of this level, so it doesn't need to be formatted
+GEM_EXPORT bool LogLevelEnabled(LogLevel level);
+// each thread formats its messages here, so logging doesn't have to allocate
+GEM_EXPORT fmt::memory_buffer& LogStagingBuffer();
 
 template<typename... ARGS>
 void Log(LogLevel level, const char* owner, const char* message, ARGS&&... args)
 {
-	auto formattedMsg = fmt::format(message, std::forward<ARGS>(args)...);
-	LogMsg(Logger::LogMessage(level, owner, std::move(formattedMsg), Logger::MSG_STYLE));
+	if (!LogLevelEnabled(level)) return;
+
+	fmt::memory_buffer& buffer = LogStagingBuffer();
+	buffer.clear();
+	fmt::format_to(std::back_inserter(buffer), message, std::forward<ARGS>(args)...);
+	LogMsg(level, owner, buffer.data(), buffer.size(), Logger::MSG_STYLE);
 }
 
 /// Log an error and exit.
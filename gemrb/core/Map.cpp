@@ -29,6 +29,7 @@
 #include "AmbientMgr.h"
 #include "Audio.h"
 #include "DisplayMessage.h"
+#include "FrameProfiler.h"
 #include "Game.h"
 #include "GameData.h"
 #include "Geometry.h"
@@ -39,6 +40,7 @@
 #include "MusicMgr.h"
 #include "Palette.h"
 #include "Particles.h"
+#include "PathClusterGraph.h"
 #include "PluginMgr.h"
 #include "Projectile.h"
 #include "RNG.h"
@@ -95,6 +97,8 @@ void TileProps::SetTileProp(const SearchmapPoint& p, Property prop, uint8_t val)
 			case Property::SEARCH_MAP:
 				c &= ~searchMapMask;
 				c |= val << searchMapShift;
+				++searchMapEpoch;
+				++staticEpoch;
 				break;
 			case Property::MATERIAL:
 				c &= ~materialMapMask;
@@ -175,6 +179,8 @@ void TileProps::PaintSearchMap(const SearchmapPoint& p, PathMapFlags value) cons
 
 	uint32_t& pixel = propPtr[p.y * size.w + p.x];
 	pixel = (pixel & ~searchMapMask) | (uint32_t(value) << propImage->Format().Rshift);
+	++searchMapEpoch;
+	++staticEpoch;
 }
 
 // Valid values are - PathMapFlags::UNMARKED, PathMapFlags::PC, PathMapFlags::NPC
@@ -197,6 +203,7 @@ void TileProps::PaintSearchMap(const SearchmapPoint& p, uint16_t blocksize, cons
 		}
 	};
 
+	++searchMapEpoch;
 	blocksize = Clamp<uint16_t>(blocksize, 1, MAX_CIRCLESIZE);
 	uint16_t r = blocksize - 1;
 
@@ -443,6 +450,7 @@ Map::Map(TileMap* tm, TileProps props, Holder<Sprite2D> sm)
 {
 	area = this;
 	MasterArea = core->GetGame()->MasterArea(scriptName);
+	actorGrid.Reset(Size(tileProps.GetSize().w * 16, tileProps.GetSize().h * 12));
 }
 
 Map::~Map(void)
@@ -492,6 +500,11 @@ Map::~Map(void)
 void Map::SetTileMapProps(TileProps props)
 {
 	tileProps = std::move(props);
+	// the new searchmap starts counting its epochs anew
+	lineCache.Clear();
+	if (clusterGraph) {
+		SetHierarchicalPathfinding(true);
+	}
 }
 
 const MapReverbProperties& Map::GetReverbProperties() const
@@ -671,6 +684,8 @@ void Map::DrawPortal(const InfoPoint* ip, int enable)
 
 void Map::UpdateScripts()
 {
+	ResRef areaRef = GetScriptRef();
+	ProfileScope profile(ProfilePhase::AreaScripts, &areaRef);
 	bool has_pcs = false;
 	for (const auto& actor : actors) {
 		if (actor->InParty) {
@@ -1163,6 +1178,7 @@ VEFObject* Map::GetNextScriptedAnimation(const scaIterator& iter) const
 //Draw the game area (including overlays, actors, animations, weather)
 void Map::DrawMap(const Region& viewport, FogRenderer& fogRenderer, uint32_t dFlags)
 {
+	ProfileScope profile(ProfilePhase::DrawMap);
 	assert(TMap);
 	debugFlags = dFlags;
 
@@ -1407,7 +1423,10 @@ void Map::DrawMap(const Region& viewport, FogRenderer& fogRenderer, uint32_t dFl
 		FogMapSize(),
 		Explore::Get().LargeFog
 	};
-	fogRenderer.DrawFog(mapData);
+	{
+		ProfileScope fogProfile(ProfilePhase::DrawFog);
+		fogRenderer.DrawFog(mapData);
+	}
 
 	// This must go AFTER the fog!
 	DrawOverheadText();
@@ -2298,6 +2317,7 @@ void Map::MarkVisited(const Actor* actor) const
 			Log(ERROR, "Map", "Area {} has a too long script name for generating _visited globals!", scriptName);
 		}
 		core->GetGame()->locals[key] = 1;
+		Game::VariablesChanged();
 	}
 }
 
@@ -2307,6 +2327,7 @@ void Map::AddActor(Actor* actor, bool init)
 	actor->AreaName = scriptName;
 	if (!HasActor(actor)) {
 		actors.push_back(actor);
+		actorGrid.Insert(actor);
 	}
 	if (init) {
 		actor->SetMap(this);
@@ -2353,6 +2374,7 @@ void Map::DeleteActor(size_t idx)
 		}
 	}
 	//remove the actor from the area's actor list
+	actorGrid.Remove(actors[idx]);
 	actors.erase(actors.begin() + idx);
 }
 
@@ -2481,36 +2503,38 @@ std::vector<Scriptable*> Map::GetScriptablesInRect(const Point& p, unsigned int
 	return neighbours;
 }
 
+// bounding box of everything closer to p than radius (pixels)
+// anything bigger than a few maps is as good as infinite
+static constexpr unsigned int MAX_QUERY_RADIUS = 0x10000;
+static Region RadiusBox(const Point& p, unsigned int radius)
+{
+	Region box(p, Size());
+	box.ExpandAllSides(static_cast<int>(std::min(radius, MAX_QUERY_RADIUS * 16)) + 1);
+	return box;
+}
+
 Actor* Map::GetActor(const Point& p, int flags, const Movable* checker) const
 {
-	for (auto actor : actors) {
-		if (!actor->IsOver(p))
-			continue;
-		if (!actor->ValidTarget(flags, checker)) {
-			continue;
-		}
-		return actor;
-	}
-	return nullptr;
+	return actorGrid.FindFirst(Region(p, Size()), [&](const Actor* actor) {
+		return actor->IsOver(p) && actor->ValidTarget(flags, checker);
+	});
 }
 
 Actor* Map::GetActorInRadius(const Point& p, int flags, unsigned int radius, const Scriptable* checker) const
 {
-	for (auto actor : actors) {
-		if (PersonalDistance(p, actor) > radius)
-			continue;
-		if (!actor->ValidTarget(flags, checker)) {
-			continue;
-		}
-		return actor;
-	}
-	return nullptr;
+	return actorGrid.FindFirst(RadiusBox(p, radius), [&](const Actor* actor) {
+		return PersonalDistance(p, actor) <= radius && actor->ValidTarget(flags, checker);
+	});
 }
 
 std::vector<Actor*> Map::GetAllActorsInRadius(const Point& p, int flags, unsigned int radius, const Scriptable* see) const
 {
+	// Feet2Pixels stretches by at most 16 (horizontally)
 	std::vector<Actor*> neighbours;
-	for (auto actor : actors) {
+	actorGrid.Query(RadiusBox(p, std::min(radius, MAX_QUERY_RADIUS) * 16), neighbours);
+	// filter the candidates in place
+	size_t count = 0;
+	for (auto actor : neighbours) {
 		if (!WithinRange(actor, p, radius)) {
 			continue;
 		}
@@ -2523,8 +2547,9 @@ std::vector<Actor*> Map::GetAllActorsInRadius(const Point& p, int flags, unsigne
 				continue;
 			}
 		}
-		neighbours.emplace_back(actor);
+		neighbours[count++] = actor;
 	}
+	neighbours.resize(count);
 	return neighbours;
 }
 
@@ -2751,15 +2776,17 @@ Actor* Map::GetActorByScriptName(const ieVariable& name) const
 std::vector<Actor*> Map::GetActorsInRect(const Region& rgn, int excludeFlags) const
 {
 	std::vector<Actor*> actorlist;
-	actorlist.reserve(actors.size());
-	for (auto actor : actors) {
+	actorGrid.Query(rgn, actorlist);
+	size_t count = 0;
+	for (auto actor : actorlist) {
 		if (!actor->ValidTarget(excludeFlags))
 			continue;
 		if (!rgn.PointInside(actor->Pos) && !actor->IsOver(rgn.origin)) // imagine drawing a tiny box inside the circle, but not over the center
 			continue;
 
-		actorlist.push_back(actor);
+		actorlist[count++] = actor;
 	}
+	actorlist.resize(count);
 
 	return actorlist;
 }
@@ -3009,30 +3036,67 @@ PathMapFlags Map::GetBlockedInLineTile(const SearchmapPoint& s, const SearchmapP
 	return ret;
 }
 
+static LineCache::Key MakeLineKey(LineCache::Kind kind, const BasePoint& s, const BasePoint& d, const Actor* caller)
+{
+	LineCache::Key key;
+	key.kind = kind;
+	key.s = Point(s.x, s.y);
+	key.d = Point(d.x, d.y);
+	if (caller) {
+		key.speed = caller->GetSpeed();
+		key.size = caller->circleSize;
+	}
+	return key;
+}
+
 // PathMapFlags::SIDEWALL obstructs LOS, while PathMapFlags::IMPASSABLE doesn't
+// actors never block sight, so these can ignore them moving around
 bool Map::IsVisibleLOS(const Point& s, const Point& d, const Actor* caller) const
 {
-	PathMapFlags ret = GetBlockedInLine(s, d, false, caller);
+	auto key = MakeLineKey(LineCache::Kind::LOSNavmap, s, d, caller);
+	// the circle size is only used with stopOnImpassable
+	key.size = -1;
+	PathMapFlags ret;
+	if (!lineCache.Lookup(key, tileProps.GetStaticEpoch(), ret)) {
+		ret = GetBlockedInLine(s, d, false, caller);
+		lineCache.Store(key, tileProps.GetStaticEpoch(), ret);
+	}
 	return !bool(ret & PathMapFlags::SIDEWALL);
 }
 
 bool Map::IsVisibleLOS(const SearchmapPoint& s, const SearchmapPoint& d, const Actor* caller) const
 {
-	PathMapFlags ret = GetBlockedInLineTile(s, d, false, caller);
+	auto key = MakeLineKey(LineCache::Kind::LOSSearchmap, s, d, caller);
+	key.size = -1;
+	PathMapFlags ret;
+	if (!lineCache.Lookup(key, tileProps.GetStaticEpoch(), ret)) {
+		ret = GetBlockedInLineTile(s, d, false, caller);
+		lineCache.Store(key, tileProps.GetStaticEpoch(), ret);
+	}
 	return !bool(ret & PathMapFlags::SIDEWALL);
 }
 
 // Used by the pathfinder, so PathMapFlags::IMPASSABLE obstructs walkability
 bool Map::IsWalkableTo(const Point& s, const Point& d, bool actorsAreBlocking, const Actor* caller) const
 {
-	PathMapFlags ret = GetBlockedInLine(s, d, true, caller);
+	auto key = MakeLineKey(LineCache::Kind::WalkNavmap, s, d, caller);
+	PathMapFlags ret;
+	if (!lineCache.Lookup(key, tileProps.GetSearchMapEpoch(), ret)) {
+		ret = GetBlockedInLine(s, d, true, caller);
+		lineCache.Store(key, tileProps.GetSearchMapEpoch(), ret);
+	}
 	PathMapFlags mask = PathMapFlags::PASSABLE | (actorsAreBlocking ? PathMapFlags::UNMARKED : PathMapFlags::ACTOR);
 	return bool(ret & mask);
 }
 
 bool Map::IsWalkableTo(const SearchmapPoint& s, const SearchmapPoint& d, bool actorsAreBlocking, const Actor* caller) const
 {
-	PathMapFlags ret = GetBlockedInLineTile(s, d, true, caller);
+	auto key = MakeLineKey(LineCache::Kind::WalkSearchmap, s, d, caller);
+	PathMapFlags ret;
+	if (!lineCache.Lookup(key, tileProps.GetSearchMapEpoch(), ret)) {
+		ret = GetBlockedInLineTile(s, d, true, caller);
+		lineCache.Store(key, tileProps.GetSearchMapEpoch(), ret);
+	}
 	PathMapFlags mask = PathMapFlags::PASSABLE | (actorsAreBlocking ? PathMapFlags::UNMARKED : PathMapFlags::ACTOR);
 	return bool(ret & mask);
 }
@@ -3140,6 +3204,7 @@ Priority Map::SetPriority(Actor* actor, bool& hostilesNew, ieDword gameTime) con
 //it should be extended to wallgroups, animations, effects!
 void Map::GenerateQueues()
 {
+	ProfileScope profile(ProfilePhase::GenerateQueues);
 	unsigned int i = (unsigned int) actors.size();
 	for (const Priority priority : EnumIterator<Priority, Priority::RunScripts, Priority::Ignore>()) {
 		if (lastActorCount[priority] != i) {
@@ -3299,6 +3364,7 @@ void Map::RemoveActor(Actor* actor)
 			ClearSearchMapFor(actor);
 			actor->SetMap(nullptr);
 			actor->AreaName.Reset();
+			actorGrid.Remove(actor);
 			actors.erase(actors.begin() + i);
 			return;
 		}
@@ -3306,6 +3372,11 @@ void Map::RemoveActor(Actor* actor)
 	Log(WARNING, "Map", "RemoveActor: actor not found?");
 }
 
+void Map::ActorMoved(Actor* actor)
+{
+	actorGrid.Update(actor);
+}
+
 //returns true if none of the partymembers are on the map
 //and noone is trying to follow the party out
 bool Map::CanFree() const
@@ -3360,6 +3431,7 @@ std::string Map::dump(bool show_actors) const
 	AppendFormat(buffer, "Weather: {}\n", YesNo(AreaType & AT_WEATHER));
 	AppendFormat(buffer, "Area Type: {}\n", AreaType & (AT_CITY | AT_FOREST | AT_DUNGEON));
 	AppendFormat(buffer, "Can rest: {}\n", YesNo(core->GetGame()->CanPartyRest(RestChecks::Area)));
+	AppendFormat(buffer, "LOS/walkability cache: {} hits, {} misses ({}%)\n", lineCache.GetHits(), lineCache.GetMisses(), lineCache.GetHitRate());
 
 	if (show_actors) {
 		buffer.append("\n");
@@ -3591,6 +3663,21 @@ void Map::SetupAmbients() const
 	ambim->SetAmbients(ambients);
 }
 
+void Map::PreloadSounds() const
+{
+	std::vector<ResRef> sounds;
+	for (const auto& ambient : ambients) {
+		sounds.insert(sounds.end(), ambient->sounds.begin(), ambient->sounds.end());
+	}
+	for (const auto& actor : actors) {
+		actor->ListWalkSounds(sounds);
+	}
+
+	std::sort(sounds.begin(), sounds.end());
+	sounds.erase(std::unique(sounds.begin(), sounds.end()), sounds.end());
+	core->GetAudioDrv()->Preload(sounds);
+}
+
 void Map::AddMapNote(const Point& point, ieWord color, String text, bool readonly)
 {
 	AddMapNote(point, MapNote(std::move(text), color, readonly));
@@ -3853,10 +3940,24 @@ void Map::ExploreTile(const FogPoint& fogP, bool fogOnly)
 }
 
 void Map::ExploreMapChunk(const SearchmapPoint& pos, int range, int los)
+{
+	ExploreMapChunk(pos, range, los, ExploredBitmap, VisibleBitmap);
+}
+
+void Map::ExploreMapChunk(const SearchmapPoint& pos, int range, int los, Bitmap& explored, Bitmap& visible) const
 {
 	SearchmapPoint tile;
 	FogPoint fogTile;
 	const Explore& explore = Explore::Get();
+	const Size fogSize = explored.GetSize();
+
+	auto exploreTile = [&](bool fogOnly) {
+		if (!fogSize.PointInside(fogTile)) return;
+		explored[fogTile] = true;
+		if (!fogOnly) {
+			visible[fogTile] = true;
+		}
+	};
 
 	if (range > Explore::MaxVisibility) {
 		range = Explore::MaxVisibility;
@@ -3872,7 +3973,7 @@ void Map::ExploreMapChunk(const SearchmapPoint& pos, int range, int los)
 			fogTile = FogPoint(tile);
 
 			if (!los) {
-				ExploreTile(fogTile, fogOnly);
+				exploreTile(fogOnly);
 				continue;
 			}
 
@@ -3894,7 +3995,7 @@ void Map::ExploreMapChunk(const SearchmapPoint& pos, int range, int los)
 				Pass--;
 				if (!Pass) break;
 			}
-			ExploreTile(fogTile, fogOnly);
+			exploreTile(fogOnly);
 		}
 	}
 }
@@ -3902,8 +4003,11 @@ void Map::ExploreMapChunk(const SearchmapPoint& pos, int range, int los)
 void Map::UpdateFog()
 {
 	TRACY(ZoneScoped);
+	ProfileScope profile(ProfilePhase::UpdateFog);
 	VisibleBitmap.fill(0);
 
+	// the rays only look at walls and doors, never at actors, so the static epoch is enough
+	uint32_t epoch = tileProps.GetStaticEpoch();
 	std::set<Spawn*> potentialSpawns;
 	for (const auto actor : actors) {
 		if (!actor->Modified[IE_EXPLORE]) continue;
@@ -3913,7 +4017,37 @@ void Map::UpdateFog()
 
 		int vis2 = actor->Modified[IE_VISUALRANGE];
 		if ((state & STATE_BLIND) || (vis2 < 2)) vis2 = 2; //can see only themselves
-		ExploreMapChunk(actor->SMPos, vis2 + actor->GetAnims()->GetCircleSize(), 1);
+		int range = vis2 + actor->GetAnims()->GetCircleSize();
+
+		auto it = actorVision.find(actor->GetGlobalID());
+		if (it == actorVision.end()) {
+			it = actorVision.emplace(actor->GetGlobalID(), ActorVision(FogMapSize())).first;
+		}
+		ActorVision& vision = it->second;
+		if (vision.pos != actor->SMPos || vision.range != range || vision.epoch != epoch || vision.areaType != AreaType) {
+			vision.pos = actor->SMPos;
+			vision.range = range;
+			vision.epoch = epoch;
+			vision.areaType = AreaType;
+			vision.explored.fill(0);
+			vision.visible.fill(0);
+			ExploreMapChunk(actor->SMPos, range, 1, vision.explored, vision.visible);
+
+			// explored is a superset of visible
+			const uint8_t* bits = vision.explored.begin();
+			int bytes = vision.explored.Bytes();
+			vision.firstByte = 0;
+			while (vision.firstByte < bytes && !bits[vision.firstByte]) {
+				vision.firstByte++;
+			}
+			vision.lastByte = bytes;
+			while (vision.lastByte > vision.firstByte && !bits[vision.lastByte - 1]) {
+				vision.lastByte--;
+			}
+		}
+		vision.seen = true;
+		ExploredBitmap.Merge(vision.explored, vision.firstByte, vision.lastByte);
+		VisibleBitmap.Merge(vision.visible, vision.firstByte, vision.lastByte);
 
 		Spawn* sp = GetSpawnRadius(actor->Pos, SPAWN_RANGE); //30 * 12
 		if (sp) {
@@ -3921,6 +4055,16 @@ void Map::UpdateFog()
 		}
 	}
 
+	// forget actors that left, died or stopped exploring
+	for (auto it = actorVision.begin(); it != actorVision.end();) {
+		if (it->second.seen) {
+			it->second.seen = false;
+			++it;
+		} else {
+			it = actorVision.erase(it);
+		}
+	}
+
 	for (Spawn* spawn : potentialSpawns) {
 		TriggerSpawn(spawn);
 	}
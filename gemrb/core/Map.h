@@ -24,8 +24,10 @@
 #include "exports.h"
 #include "globals.h"
 
+#include "ActorGrid.h"
 #include "Bitmap.h"
 #include "FogRenderer.h"
+#include "LineCache.h"
 #include "MapReverb.h"
 #include "PathFinder.h"
 #include "Polygon.h"
@@ -52,6 +54,7 @@ class GameControl;
 class IniSpawn;
 class Palette;
 class Particles;
+class PathClusterGraph;
 class Projectile;
 class ScriptedAnimation;
 class TileMap;
@@ -342,6 +345,11 @@ class GEM_EXPORT TileProps {
 	static constexpr uint32_t heightMapShift = 8;
 	static constexpr uint32_t lightMapShift = 0;
 
+	// bumped on every searchmap change, so derived data can tell when it is stale
+	// the static epoch ignores actors (un)painting their circles, which only touches the actor bits
+	mutable uint32_t searchMapEpoch = 0;
+	mutable uint32_t staticEpoch = 0;
+
 public:
 	static const PixelFormat pixelFormat;
 
@@ -371,6 +379,9 @@ public:
 
 	void PaintSearchMap(const SearchmapPoint&, PathMapFlags value) const noexcept;
 	void PaintSearchMap(const SearchmapPoint& p, uint16_t blocksize, PathMapFlags value) const noexcept;
+
+	uint32_t GetSearchMapEpoch() const noexcept { return searchMapEpoch; }
+	uint32_t GetStaticEpoch() const noexcept { return staticEpoch; }
 };
 
 class GEM_EXPORT Map : public Scriptable {
@@ -405,6 +416,29 @@ private:
 
 	std::list<AreaAnimation> animations;
 	std::vector<Actor*> actors;
+	// spatial index over actors, for the proximity queries
+	ActorGrid actorGrid;
+	// results of the searchmap line walks
+	mutable LineCache lineCache;
+
+	// what each exploring actor saw during the last UpdateFog, so the rays
+	// only need to be cast again once it moves or the searchmap changes
+	struct ActorVision {
+		SearchmapPoint pos;
+		int range = -1;
+		uint32_t epoch = 0;
+		MapEnv areaType = AT_UNINITIALIZED;
+		Bitmap explored;
+		Bitmap visible;
+		// the bytes that can have any bits set
+		int firstByte = 0;
+		int lastByte = 0;
+		bool seen = false;
+
+		explicit ActorVision(const Size& fogSize)
+			: explored(fogSize, uint8_t(0x00)), visible(fogSize, uint8_t(0x00)) {}
+	};
+	std::unordered_map<ScriptID, ActorVision> actorVision;
 	std::vector<WallPolygonGroup> wallGroups;
 	std::list<VEFObject*> vvcCells;
 	std::list<Projectile*> projectiles;
@@ -438,6 +472,7 @@ private:
 	};
 
 	std::unique_ptr<MapReverb> reverb;
+	std::unique_ptr<PathClusterGraph> clusterGraph;
 	MapReverb::id_t reverbID = EFX_PROFILE_REVERB_INVALID;
 
 	struct MainAmbients {
@@ -550,6 +585,8 @@ public:
 	bool HasActor(const Actor* actor) const;
 	bool SpawnsAlive() const;
 	void RemoveActor(Actor* actor);
+	// keeps the spatial index current, called when an actor moved or changed size
+	void ActorMoved(Actor* actor);
 	Actor* GetRandomEnemySeen(const Actor* origin) const;
 
 	int GetActorCount(bool any) const;
@@ -608,6 +645,8 @@ public:
 	void ExploreTile(const FogPoint&, bool fogOnly = false);
 	/* explore map from given point in map coordinates */
 	void ExploreMapChunk(const SearchmapPoint& pos, int range, int los);
+	/* same, but marking the tiles in the passed bitmaps */
+	void ExploreMapChunk(const SearchmapPoint& pos, int range, int los, Bitmap& explored, Bitmap& visible) const;
 	void BlockSearchMapFor(const Movable* actor) const;
 	void ClearSearchMapFor(const Movable* actor) const;
 	/* update VisibleBitmap by resolving vision of all explore actors */
@@ -628,6 +667,11 @@ public:
 	Path GetLinePath(const Point& start, const Point& dest, int speed, orient_t Orientation, int flags) const;
 	/* Finds the path which leads to near d */
 	Path FindPath(const Point& s, const Point& d, unsigned int size, unsigned int minDistance = 0, int flags = PF_SIGHT, const Actor* caller = nullptr) const;
+	/* builds or drops the cluster graph used to speed up long searches */
+	void SetHierarchicalPathfinding(bool enable);
+	bool HasHierarchicalPathfinding() const { return clusterGraph != nullptr; }
+	/* notify about searchmap changes other than actor movement */
+	void SearchMapChanged(const SearchmapPoint& p) const;
 
 	bool IsVisible(const Point& p) const;
 	bool IsExplored(const Point& p) const;
@@ -642,6 +686,8 @@ public:
 	//ambients
 	void SetAmbients(std::vector<Ambient*> ambient, MapReverb::id_t reverbID = EFX_PROFILE_REVERB_INVALID);
 	void SetupAmbients() const;
+	// decodes the ambient and creature walk sounds in the background
+	void PreloadSounds() const;
 	const std::vector<Ambient*>& GetAmbients() const { return ambients; };
 	const MapReverbProperties& GetReverbProperties() const;
 
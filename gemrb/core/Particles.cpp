@@ -78,7 +78,7 @@ static void InitSparks()
 
 Particles::Particles(int s)
 {
-	points.resize(s);
+	points.Resize(s);
 	/*
 	for (int i=0;i<MAX_SPARK_PHASE;i++) {
 		bitmap[i]=NULL;
@@ -142,18 +142,16 @@ bool Particles::AddNew(const Point& point)
 	}
 	int i = last_insert;
 	while (i--) {
-		if (points[i].state == -1) {
-			points[i].state = st;
-			points[i].pos = point;
+		if (points.state[i] == -1) {
+			points.Set(i, st, point);
 			last_insert = i;
 			return false;
 		}
 	}
 	i = size;
 	while (i-- != last_insert) {
-		if (points[i].state == -1) {
-			points[i].state = st;
-			points[i].pos = point;
+		if (points.state[i] == -1) {
+			points.Set(i, st, point);
 			last_insert = i;
 			return false;
 		}
@@ -161,16 +159,83 @@ bool Particles::AddNew(const Point& point)
 	return true;
 }
 
-void Particles::Draw(Point p)
+// the pixels DrawCircle would plot for the circle sparks
+static const std::vector<BasePoint>& CircleStencil()
+{
+	static const std::vector<BasePoint> stencil = PlotCircle(BasePoint(), 2);
+	return stencil;
+}
+
+void Particles::BatchElement(ieWord i, const Point& p, int length, std::vector<BasePoint>& batch) const
 {
+	Point origin = points.GetPos(i) - p;
+	switch (type) {
+		case SP_TYPE_CIRCLE:
+			for (const BasePoint& offset : CircleStencil()) {
+				batch.emplace_back(origin.x + offset.x, origin.y + offset.y);
+			}
+			break;
+		case SP_TYPE_POINT:
+		default:
+			batch.push_back(origin);
+			break;
+		// this is more like a raindrop
+		case SP_TYPE_LINE:
+			if (length) {
+				// the longer drops are slanted by a pixel halfway down
+				int slant = length > 3 ? i & 1 : 0;
+				for (int y = 0; y <= length; ++y) {
+					int x = 2 * y > length ? slant : 0;
+					batch.emplace_back(origin.x + x, origin.y + y);
+				}
+			}
+			break;
+	}
+}
+
+void Particles::DrawFragment(ieWord i, const Point& p, Color clr) const
+{
+	/*
+	if (bitmap[state]) {
+		Holder<Sprite2D> frame = bitmap[state]->GetFrame(points[i].state&255);
+		video->BlitGameSprite(frame,
+			points[i].pos.x+screen.x,
+			points[i].pos.y+screen.y, 0, clr,
+			NULL, NULL, &screen);
+	}
+	*/
+	if (!fragments) return;
+
+	//IE_ANI_CAST stance has a simple looping animation
+	const auto* anims = fragments->GetAnimation(IE_ANI_CAST, ClampToOrientation(i));
+	if (!anims) return;
+
+	const auto anim = anims->at(0);
+	Holder<Sprite2D> nextFrame = anim->GetFrame(anim->GetCurrentFrameIndex());
+
+	BlitFlags flags = BlitFlags::NONE;
 	const Game* game = core->GetGame();
+	if (game) game->ApplyGlobalTint(clr, flags);
+
+	VideoDriver->BlitGameSpriteWithPalette(nextFrame, fragments->GetPartPalette(0),
+					       points.GetPos(i) - p, flags, clr);
+}
 
+void Particles::Draw(Point p)
+{
 	if (owner) {
 		p -= pos.origin;
 	}
+
+	// everything but the fragments is plain pixels, so collect them by color
+	// and hand them to the video driver in one go per color
+	for (auto& batch : batches) {
+		batch.clear();
+	}
+
 	ieWord i = size;
 	while (i--) {
-		if (points[i].state == -1) {
+		if (points.state[i] == -1) {
 			continue;
 		}
 		int state;
@@ -178,10 +243,10 @@ void Particles::Draw(Point p)
 		switch (path) {
 			case SP_PATH_FLIT:
 			case SP_PATH_RAIN:
-				state = points[i].state >> 4;
+				state = points.state[i] >> 4;
 				break;
 			default:
-				state = points[i].state;
+				state = points.state[i];
 				break;
 		}
 
@@ -194,53 +259,27 @@ void Particles::Draw(Point p)
 			state = MAX_SPARK_PHASE - state - 1;
 			length = 0;
 		}
+
+		if (type == SP_TYPE_BITMAP) {
+			Color clr = color;
+			if (!clr.Packed()) {
+				clr = sparkcolors[colorIdx][state];
+			}
+			DrawFragment(i, p, clr);
+		} else {
+			// a custom color is the same for all phases
+			BatchElement(i, p, length, batches[color.Packed() ? 0 : state]);
+		}
+	}
+
+	for (int state = 0; state < MAX_SPARK_PHASE; ++state) {
+		if (batches[state].empty()) continue;
+
 		Color clr = color;
 		if (!clr.Packed()) {
 			clr = sparkcolors[colorIdx][state];
 		}
-		switch (type) {
-			case SP_TYPE_BITMAP:
-				/*
-			if (bitmap[state]) {
-				Holder<Sprite2D> frame = bitmap[state]->GetFrame(points[i].state&255);
-				video->BlitGameSprite(frame,
-					points[i].pos.x+screen.x,
-					points[i].pos.y+screen.y, 0, clr,
-					NULL, NULL, &screen);
-			}
-			*/
-				if (fragments) {
-					//IE_ANI_CAST stance has a simple looping animation
-					const auto* anims = fragments->GetAnimation(IE_ANI_CAST, ClampToOrientation(i));
-					if (!anims) {
-						break;
-					}
-
-					const auto anim = anims->at(0);
-					Holder<Sprite2D> nextFrame = anim->GetFrame(anim->GetCurrentFrameIndex());
-
-					BlitFlags flags = BlitFlags::NONE;
-					if (game) game->ApplyGlobalTint(clr, flags);
-
-					VideoDriver->BlitGameSpriteWithPalette(nextFrame, fragments->GetPartPalette(0),
-									       points[i].pos - p, flags, clr);
-				}
-				break;
-			case SP_TYPE_CIRCLE:
-				VideoDriver->DrawCircle(points[i].pos - p, 2, clr);
-				break;
-			case SP_TYPE_POINT:
-			default:
-				VideoDriver->DrawPoint(points[i].pos - p, clr);
-				break;
-			// this is more like a raindrop
-			case SP_TYPE_LINE:
-				if (length) {
-					int y = length > 3 ? i & 1 : 0;
-					VideoDriver->DrawLine(points[i].pos - p, points[i].pos - p + Point(y, length), clr);
-				}
-				break;
-		}
+		VideoDriver->DrawPoints(batches[state], clr);
 	}
 }
 
@@ -308,55 +347,19 @@ int Particles::Update()
 		default:
 			grow = size / 10;
 	}
+
+	// no branches on the element state, so these simple loops can be vectorized
+	int* state = points.state.data();
+	int alive = 0;
 	for (int i = 0; i < size; i++) {
-		if (points[i].state == -1) {
-			continue;
-		}
+		int used = state[i] != -1;
+		alive |= used;
+		grow += state[i] == 0;
+		state[i] -= used;
+	}
+	if (alive) {
 		drawn = true;
-		if (!points[i].state) {
-			grow++;
-		}
-		points[i].state--;
-
-		switch (path) {
-			case SP_PATH_FALL:
-				points[i].pos.y += 3 + ((i >> 2) & 3);
-				points[i].pos.y %= pos.h;
-				break;
-			case SP_PATH_RAIN:
-				points[i].pos.x += pos.w + (i & 1);
-				points[i].pos.x %= pos.w;
-				points[i].pos.y += 3 + ((i >> 2) & 3);
-				points[i].pos.y %= pos.h;
-				break;
-			case SP_PATH_FLIT:
-				if (points[i].state <= MAX_SPARK_PHASE << 4) {
-					break;
-				}
-				points[i].pos.x += core->Roll(1, 3, pos.w - 2);
-				points[i].pos.x %= pos.w;
-				points[i].pos.y += (i & 3) + 1;
-				break;
-			case SP_PATH_EXPL:
-				points[i].pos.y += 1;
-				break;
-			case SP_PATH_FOUNT:
-				if (points[i].state <= MAX_SPARK_PHASE) {
-					break;
-				}
-				if (points[i].state < (MAX_SPARK_PHASE + pos.h)) {
-					if ((points[i].state & 7) == 7) {
-						points[i].pos.x += (i & 3) - 1;
-					}
-					points[i].pos.y += 2;
-				} else {
-					if ((points[i].state & 7) == 7) {
-						points[i].pos.x += (i & 3) - 1;
-					}
-					points[i].pos.y -= 2;
-				}
-				break;
-		}
+		MoveElements();
 	}
 	if (phase == P_GROW) {
 		AddParticles(grow);
@@ -368,4 +371,55 @@ int Particles::Update()
 	return drawn;
 }
 
+void Particles::MoveElements()
+{
+	// unused elements get moved as well, their position is reset when they're reused
+	const int* state = points.state.data();
+	int* x = points.x.data();
+	int* y = points.y.data();
+
+	switch (path) {
+		case SP_PATH_FALL:
+			for (int i = 0; i < size; i++) {
+				y[i] = (y[i] + 3 + ((i >> 2) & 3)) % pos.h;
+			}
+			break;
+		case SP_PATH_RAIN:
+			for (int i = 0; i < size; i++) {
+				x[i] = (x[i] + pos.w + (i & 1)) % pos.w;
+				y[i] = (y[i] + 3 + ((i >> 2) & 3)) % pos.h;
+			}
+			break;
+		case SP_PATH_FLIT:
+			for (int i = 0; i < size; i++) {
+				// this also skips the unused ones
+				if (state[i] <= MAX_SPARK_PHASE << 4) {
+					continue;
+				}
+				x[i] += core->Roll(1, 3, pos.w - 2);
+				x[i] %= pos.w;
+				y[i] += (i & 3) + 1;
+			}
+			break;
+		case SP_PATH_EXPL:
+			for (int i = 0; i < size; i++) {
+				y[i] += 1;
+			}
+			break;
+		case SP_PATH_FOUNT:
+			for (int i = 0; i < size; i++) {
+				if (state[i] <= MAX_SPARK_PHASE) {
+					continue;
+				}
+				if ((state[i] & 7) == 7) {
+					x[i] += (i & 3) - 1;
+				}
+				y[i] += state[i] < MAX_SPARK_PHASE + pos.h ? 2 : -2;
+			}
+			break;
+		default:
+			break;
+	}
+}
+
 }
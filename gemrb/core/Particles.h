@@ -35,6 +35,7 @@
 #include "Region.h"
 
 #include <memory>
+#include <vector>
 
 namespace GemRB {
 
@@ -46,10 +47,26 @@ class Scriptable;
 #define P_FADE  1
 #define P_EMPTY 2
 
-// this structure holds data for a single particle element
-struct Element {
-	int state = -1;
-	Point pos;
+// the particle elements, stored as separate arrays, so the per frame
+// update runs over plain integers; a state of -1 marks an unused element
+struct ParticleElements {
+	std::vector<int> state;
+	std::vector<int> x;
+	std::vector<int> y;
+
+	void Resize(size_t size)
+	{
+		state.resize(size, -1);
+		x.resize(size);
+		y.resize(size);
+	}
+	void Set(size_t i, int st, const Point& p)
+	{
+		state[i] = st;
+		x[i] = p.x;
+		y[i] = p.y;
+	}
+	Point GetPos(size_t i) const { return Point(x[i], y[i]); }
 };
 
 /**
@@ -125,7 +142,9 @@ public:
 	int GetHeight() const { return pos.y + pos.h; }
 
 private:
-	std::vector<Element> points;
+	ParticleElements points;
+	// reused between frames, the points drawn in each spark color phase
+	std::vector<BasePoint> batches[MAX_SPARK_PHASE];
 	ieDword timetolive = 0;
 	tick_t lastUpdate = 0;
 	//	ieDword target;    //could be 0, in that case target is pos
@@ -143,6 +162,11 @@ private:
 	//1. the cycles are loaded only when needed
 	//2. the fragments ARE avatar animations in the original IE (for some unknown reason)
 	std::unique_ptr<CharAnimations> fragments;
+
+	/* appends the pixels of element i to a batch of the same color */
+	void BatchElement(ieWord i, const Point& p, int length, std::vector<BasePoint>& batch) const;
+	void DrawFragment(ieWord i, const Point& p, Color clr) const;
+	void MoveElements();
 };
 
 }
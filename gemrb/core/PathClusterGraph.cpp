@@ -0,0 +1,353 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "PathClusterGraph.h"
+
+#include "Map.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace GemRB {
+
+constexpr unsigned int UNREACHABLE = std::numeric_limits<unsigned int>::max();
+// border stretches at least this long get an entrance at each end instead of just one in the middle
+constexpr int LONG_ENTRANCE = 6;
+
+PathClusterGraph::PathClusterGraph(const TileProps& props)
+	: props(props)
+{
+	Build();
+}
+
+size_t PathClusterGraph::GetNodeCount() const
+{
+	return nodes.size() - freeNodes.size();
+}
+
+// actors are ignored on purpose, they move around too much
+bool PathClusterGraph::IsWalkable(const SearchmapPoint& p) const
+{
+	PathMapFlags flags = props.QuerySearchMap(p);
+	return bool(flags & (PathMapFlags::PASSABLE | PathMapFlags::TRAVEL)) && !bool(flags & PathMapFlags::DOOR);
+}
+
+int PathClusterGraph::ClusterIndex(const SearchmapPoint& p) const
+{
+	return (p.y / CLUSTER_SIZE) * gridSize.w + p.x / CLUSTER_SIZE;
+}
+
+Region PathClusterGraph::ClusterRegion(int cluster) const
+{
+	int x = (cluster % gridSize.w) * CLUSTER_SIZE;
+	int y = (cluster / gridSize.w) * CLUSTER_SIZE;
+	return Region(x, y, std::min(CLUSTER_SIZE, mapSize.w - x), std::min(CLUSTER_SIZE, mapSize.h - y));
+}
+
+bool PathClusterGraph::IsLongRange(const SearchmapPoint& s, const SearchmapPoint& d) const
+{
+	int dx = std::abs(s.x / CLUSTER_SIZE - d.x / CLUSTER_SIZE);
+	int dy = std::abs(s.y / CLUSTER_SIZE - d.y / CLUSTER_SIZE);
+	return std::max(dx, dy) > 1;
+}
+
+bool PathClusterGraph::InCorridor(const std::vector<uint8_t>& corridor, const SearchmapPoint& p) const
+{
+	return corridor[ClusterIndex(p)];
+}
+
+void PathClusterGraph::Invalidate(const SearchmapPoint& p)
+{
+	if (!mapSize.PointInside(p)) return;
+
+	dirty[ClusterIndex(p)] = 1;
+	anyDirty = true;
+}
+
+void PathClusterGraph::Build()
+{
+	mapSize = props.GetSize();
+	gridSize.w = (mapSize.w + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+	gridSize.h = (mapSize.h + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+
+	nodes.clear();
+	freeNodes.clear();
+	eastBorders.assign(gridSize.Area(), {});
+	southBorders.assign(gridSize.Area(), {});
+	dirty.assign(gridSize.Area(), 1);
+	fillDist.resize(CLUSTER_SIZE * CLUSTER_SIZE);
+	anyDirty = true;
+	Refresh();
+}
+
+// rebuild the entrances around changed clusters and relink them and their neighbours
+void PathClusterGraph::Refresh()
+{
+	if (!anyDirty) return;
+
+	std::vector<uint8_t> relink(gridSize.Area(), 0);
+	for (int cluster = 0; cluster < gridSize.Area(); cluster++) {
+		if (!dirty[cluster]) continue;
+
+		int cx = cluster % gridSize.w;
+		int cy = cluster / gridSize.w;
+		BuildBorder(cluster, true);
+		BuildBorder(cluster, false);
+		relink[cluster] = 1;
+		if (cx > 0) {
+			BuildBorder(cluster - 1, true);
+			relink[cluster - 1] = 1;
+		}
+		if (cy > 0) {
+			BuildBorder(cluster - gridSize.w, false);
+			relink[cluster - gridSize.w] = 1;
+		}
+		if (cx + 1 < gridSize.w) relink[cluster + 1] = 1;
+		if (cy + 1 < gridSize.h) relink[cluster + gridSize.w] = 1;
+	}
+
+	for (int cluster = 0; cluster < gridSize.Area(); cluster++) {
+		if (relink[cluster]) LinkCluster(cluster);
+	}
+
+	std::fill(dirty.begin(), dirty.end(), 0);
+	anyDirty = false;
+}
+
+int PathClusterGraph::AddNode(const SearchmapPoint& p)
+{
+	int id;
+	if (freeNodes.empty()) {
+		id = static_cast<int>(nodes.size());
+		nodes.emplace_back();
+	} else {
+		id = freeNodes.back();
+		freeNodes.pop_back();
+	}
+
+	Node& node = nodes[id];
+	node.pos = p;
+	node.cluster = ClusterIndex(p);
+	node.edges.clear();
+	return id;
+}
+
+void PathClusterGraph::ClearBorder(std::vector<int>& border)
+{
+	for (int id : border) {
+		nodes[id].cluster = -1;
+		nodes[id].edges.clear();
+		freeNodes.push_back(id);
+	}
+	border.clear();
+}
+
+void PathClusterGraph::BuildBorder(int cluster, bool east)
+{
+	std::vector<int>& border = east ? eastBorders[cluster] : southBorders[cluster];
+	ClearBorder(border);
+
+	int cx = cluster % gridSize.w;
+	int cy = cluster / gridSize.w;
+	if (east && cx + 1 >= gridSize.w) return;
+	if (!east && cy + 1 >= gridSize.h) return;
+
+	Region bounds = ClusterRegion(cluster);
+	// walk along the border, inside is our edge cell, outside the neighbour's
+	SearchmapPoint step = east ? SearchmapPoint(0, 1) : SearchmapPoint(1, 0);
+	SearchmapPoint across = east ? SearchmapPoint(1, 0) : SearchmapPoint(0, 1);
+	SearchmapPoint first = east ? SearchmapPoint(bounds.x + bounds.w - 1, bounds.y) : SearchmapPoint(bounds.x, bounds.y + bounds.h - 1);
+	int length = east ? bounds.h : bounds.w;
+
+	auto addEntrance = [&](int offset) {
+		SearchmapPoint inside = first + step * offset;
+		int a = AddNode(inside);
+		int b = AddNode(inside + across);
+		nodes[a].edges.push_back({ b, 1 });
+		nodes[b].edges.push_back({ a, 1 });
+		border.push_back(a);
+		border.push_back(b);
+	};
+
+	int runStart = -1;
+	for (int i = 0; i <= length; i++) {
+		SearchmapPoint inside = first + step * i;
+		bool passable = i < length && IsWalkable(inside) && IsWalkable(inside + across);
+		if (passable) {
+			if (runStart < 0) runStart = i;
+			continue;
+		}
+		if (runStart < 0) continue;
+
+		int runEnd = i - 1;
+		if (runEnd - runStart + 1 < LONG_ENTRANCE) {
+			addEntrance((runStart + runEnd) / 2);
+		} else {
+			addEntrance(runStart);
+			addEntrance(runEnd);
+		}
+		runStart = -1;
+	}
+}
+
+void PathClusterGraph::CollectClusterNodes(int cluster, std::vector<int>& out) const
+{
+	out.clear();
+	auto collect = [&](const std::vector<int>& border) {
+		for (int id : border) {
+			if (nodes[id].cluster == cluster) out.push_back(id);
+		}
+	};
+
+	collect(eastBorders[cluster]);
+	collect(southBorders[cluster]);
+	if (cluster % gridSize.w > 0) collect(eastBorders[cluster - 1]);
+	if (cluster >= gridSize.w) collect(southBorders[cluster - gridSize.w]);
+}
+
+void PathClusterGraph::FloodCluster(const SearchmapPoint& p, const Region& bounds)
+{
+	std::fill(fillDist.begin(), fillDist.end(), UNREACHABLE);
+	fillQueue.clear();
+	if (!IsWalkable(p)) return;
+
+	fillDist[(p.y - bounds.y) * CLUSTER_SIZE + p.x - bounds.x] = 0;
+	fillQueue.push_back(p);
+	static const SearchmapPoint neighbours[] = { SearchmapPoint(1, 0), SearchmapPoint(0, 1), SearchmapPoint(-1, 0), SearchmapPoint(0, -1) };
+	for (size_t head = 0; head < fillQueue.size(); head++) {
+		SearchmapPoint current = fillQueue[head];
+		unsigned int dist = fillDist[(current.y - bounds.y) * CLUSTER_SIZE + current.x - bounds.x];
+		for (const SearchmapPoint& offset : neighbours) {
+			SearchmapPoint next = current + offset;
+			if (next.x < bounds.x || next.y < bounds.y || next.x >= bounds.x + bounds.w || next.y >= bounds.y + bounds.h) continue;
+			unsigned int& nextDist = fillDist[(next.y - bounds.y) * CLUSTER_SIZE + next.x - bounds.x];
+			if (nextDist != UNREACHABLE || !IsWalkable(next)) continue;
+			nextDist = dist + 1;
+			fillQueue.push_back(next);
+		}
+	}
+}
+
+unsigned int PathClusterGraph::FillDistance(const SearchmapPoint& p, const Region& bounds) const
+{
+	return fillDist[(p.y - bounds.y) * CLUSTER_SIZE + p.x - bounds.x];
+}
+
+void PathClusterGraph::LinkCluster(int cluster)
+{
+	std::vector<int> members;
+	CollectClusterNodes(cluster, members);
+	Region bounds = ClusterRegion(cluster);
+
+	for (int id : members) {
+		// keep only the link across the border, added by BuildBorder
+		Node& node = nodes[id];
+		node.edges.resize(1);
+
+		FloodCluster(node.pos, bounds);
+		for (int other : members) {
+			if (other == id) continue;
+			unsigned int dist = FillDistance(nodes[other].pos, bounds);
+			if (dist == UNREACHABLE) continue;
+			node.edges.push_back({ other, dist });
+		}
+	}
+}
+
+bool PathClusterGraph::FindCorridor(const SearchmapPoint& s, const SearchmapPoint& d, std::vector<uint8_t>& corridor)
+{
+	if (!mapSize.PointInside(s) || !mapSize.PointInside(d)) return false;
+	Refresh();
+
+	// the endpoints are temporarily inserted after the real nodes
+	int count = static_cast<int>(nodes.size());
+	int startID = count;
+	int goalID = count + 1;
+	searchDist.assign(count + 2, UNREACHABLE);
+	searchParent.assign(count + 2, -1);
+
+	open.clear();
+	goalLinks.assign(count, UNREACHABLE);
+
+	auto heuristic = [&d](const SearchmapPoint& p) {
+		return static_cast<unsigned int>(std::abs(p.x - d.x) + std::abs(p.y - d.y));
+	};
+	auto relax = [&](int id, unsigned int dist, int parent, const SearchmapPoint& pos) {
+		if (dist >= searchDist[id]) return;
+		searchDist[id] = dist;
+		searchParent[id] = parent;
+		open.emplace_back(dist + heuristic(pos), id);
+		std::push_heap(open.begin(), open.end(), std::greater<OpenEntry>());
+	};
+
+	int goalCluster = ClusterIndex(d);
+	Region goalBounds = ClusterRegion(goalCluster);
+	FloodCluster(d, goalBounds);
+	CollectClusterNodes(goalCluster, clusterNodes);
+	for (int id : clusterNodes) {
+		goalLinks[id] = FillDistance(nodes[id].pos, goalBounds);
+	}
+
+	int startCluster = ClusterIndex(s);
+	Region startBounds = ClusterRegion(startCluster);
+	FloodCluster(s, startBounds);
+	CollectClusterNodes(startCluster, clusterNodes);
+	searchDist[startID] = 0;
+	for (int id : clusterNodes) {
+		unsigned int dist = FillDistance(nodes[id].pos, startBounds);
+		if (dist == UNREACHABLE) continue;
+		relax(id, dist, startID, nodes[id].pos);
+	}
+
+	bool found = false;
+	while (!open.empty()) {
+		std::pop_heap(open.begin(), open.end(), std::greater<OpenEntry>());
+		OpenEntry current = open.back();
+		open.pop_back();
+
+		int id = current.second;
+		if (id == goalID) {
+			found = true;
+			break;
+		}
+		const Node& node = nodes[id];
+		// stale entry, we already found a shorter way here
+		if (current.first != searchDist[id] + heuristic(node.pos)) continue;
+
+		for (const Edge& edge : node.edges) {
+			relax(edge.target, searchDist[id] + edge.cost, id, nodes[edge.target].pos);
+		}
+		if (goalLinks[id] != UNREACHABLE) {
+			relax(goalID, searchDist[id] + goalLinks[id], id, d);
+		}
+	}
+	if (!found) return false;
+
+	corridor.assign(gridSize.Area(), 0);
+	corridor[startCluster] = 1;
+	corridor[goalCluster] = 1;
+	for (int id = searchParent[goalID]; id != startID; id = searchParent[id]) {
+		corridor[nodes[id].cluster] = 1;
+	}
+	return true;
+}
+
+}
@@ -0,0 +1,119 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef PATHCLUSTERGRAPH_H
+#define PATHCLUSTERGRAPH_H
+
+#include "exports.h"
+
+#include "PathFinder.h"
+#include "Region.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace GemRB {
+
+class TileProps;
+
+// Abstract graph for hierarchical pathfinding (HPA*, see Botea et al., 2004)
+// The searchmap is split into square clusters. Wherever two neighbouring
+// clusters share a walkable stretch of border, we place a pair of entrance
+// nodes, which are then connected to all other entrances of the same cluster.
+// Long searches first run over this much smaller graph and Map::FindPath then
+// only has to refine the resulting corridor of clusters.
+// Only static passability is considered (actors are ignored), so the corridor
+// is just a hint and the caller must be able to fall back to a full search.
+class GEM_EXPORT PathClusterGraph {
+public:
+	// cluster side, in searchmap cells
+	static constexpr int CLUSTER_SIZE = 16;
+
+	explicit PathClusterGraph(const TileProps& props);
+
+	// fills corridor with a flag per cluster, set for the clusters on the
+	// abstract path; returns false if no abstract path was found
+	bool FindCorridor(const SearchmapPoint& s, const SearchmapPoint& d, std::vector<uint8_t>& corridor);
+	bool InCorridor(const std::vector<uint8_t>& corridor, const SearchmapPoint& p) const;
+	// should the search between these two points go through the graph at all?
+	bool IsLongRange(const SearchmapPoint& s, const SearchmapPoint& d) const;
+
+	// the searchmap changed at p (eg. a door was opened), so schedule the
+	// cluster for a rebuild, which happens lazily on the next query
+	void Invalidate(const SearchmapPoint& p);
+
+	size_t GetNodeCount() const;
+
+private:
+	struct Edge {
+		int target;
+		unsigned int cost;
+	};
+
+	// estimated total cost and node id
+	using OpenEntry = std::pair<unsigned int, int>;
+
+	struct Node {
+		SearchmapPoint pos;
+		int cluster = -1;
+		std::vector<Edge> edges;
+	};
+
+	const TileProps& props;
+	Size mapSize;
+	Size gridSize;
+
+	std::vector<Node> nodes;
+	std::vector<int> freeNodes;
+	// entrance nodes lying on the east and south border of each cluster
+	std::vector<std::vector<int>> eastBorders;
+	std::vector<std::vector<int>> southBorders;
+	std::vector<uint8_t> dirty;
+	bool anyDirty = false;
+
+	// reusable buffers for the cluster flood fills and the abstract search
+	std::vector<unsigned int> fillDist;
+	std::vector<SearchmapPoint> fillQueue;
+	std::vector<unsigned int> searchDist;
+	std::vector<int> searchParent;
+	std::vector<unsigned int> goalLinks;
+	std::vector<OpenEntry> open;
+	std::vector<int> clusterNodes;
+
+	bool IsWalkable(const SearchmapPoint& p) const;
+	int ClusterIndex(const SearchmapPoint& p) const;
+	Region ClusterRegion(int cluster) const;
+
+	void Build();
+	void Refresh();
+	int AddNode(const SearchmapPoint& p);
+	void ClearBorder(std::vector<int>& border);
+	void BuildBorder(int cluster, bool east);
+	void LinkCluster(int cluster);
+	void CollectClusterNodes(int cluster, std::vector<int>& out) const;
+	// breadth-first flood fill from p, confined to its cluster
+	void FloodCluster(const SearchmapPoint& p, const Region& bounds);
+	unsigned int FillDistance(const SearchmapPoint& p, const Region& bounds) const;
+};
+
+}
+
+#endif
@@ -41,6 +41,7 @@
 #include "GameData.h"
 #include "Interface.h"
 #include "Map.h"
+#include "PathClusterGraph.h"
 #include "RNG.h"
 
 #include "Scriptable/Actor.h"
@@ -61,6 +62,74 @@ constexpr std::array<float_t, RAND_DEGREES_OF_FREEDOM> dxRand { { 0.000, -0.383,
 // Sines
 constexpr std::array<float_t, RAND_DEGREES_OF_FREEDOM> dyRand { { 1.000, 0.924, 0.707, 0.383, 0.000, -0.383, -0.707, -0.924, -1.000, -0.924, -0.707, -0.383, 0.000, 0.383, 0.707, 0.924 } };
 
+// Scratch state for Map::FindPath, reused between searches, so steady state
+// pathing doesn't allocate. Instead of clearing full-map arrays for every
+// search, each cell is stamped with the generation that last touched it and
+// anything with an older stamp reads as unvisited.
+class PathFinderWorkspace {
+	struct Cell {
+		uint32_t stamp = 0;
+		uint32_t closedStamp = 0;
+		NavmapPoint parent;
+		unsigned short dist = 0;
+	};
+
+	std::vector<Cell> cells;
+	uint32_t generation = 0;
+
+	Cell& Touch(int idx)
+	{
+		Cell& cell = cells[idx];
+		if (cell.stamp != generation) {
+			cell.stamp = generation;
+			cell.parent = Point(0, 0);
+			cell.dist = std::numeric_limits<unsigned short>::max();
+		}
+		return cell;
+	}
+
+public:
+	FibonacciHeap<PQNode> open;
+
+	void Reset(const Size& mapSize)
+	{
+		open.clear();
+		size_t area = mapSize.Area();
+		if (cells.size() < area) {
+			cells.resize(area);
+		}
+
+		generation++;
+		if (generation == 0) {
+			// wrapped around, so old stamps could look current again
+			for (Cell& cell : cells) {
+				cell.stamp = cell.closedStamp = 0;
+			}
+			generation = 1;
+		}
+	}
+
+	bool IsClosed(int idx) const { return cells[idx].closedStamp == generation; }
+	void Close(int idx) { cells[idx].closedStamp = generation; }
+
+	NavmapPoint GetParent(int idx) const
+	{
+		const Cell& cell = cells[idx];
+		return cell.stamp == generation ? cell.parent : Point(0, 0);
+	}
+	void SetParent(int idx, const NavmapPoint& parent) { Touch(idx).parent = parent; }
+
+	unsigned short GetDist(int idx) const
+	{
+		const Cell& cell = cells[idx];
+		return cell.stamp == generation ? cell.dist : std::numeric_limits<unsigned short>::max();
+	}
+	void SetDist(int idx, unsigned short dist) { Touch(idx).dist = dist; }
+
+	// clusters a hierarchical search is confined to
+	std::vector<uint8_t> corridor;
+};
+
 // Find the best path of limited length that brings us the farthest from d
 Path Map::RunAway(const Point& s, const Point& d, int maxPathLength, bool backAway, const Actor* caller) const
 {
@@ -220,6 +289,22 @@ PathNode Map::GetLineEnd(const Point& p, int steps, orient_t orient) const
 	return lineEnd;
 }
 
+void Map::SetHierarchicalPathfinding(bool enable)
+{
+	if (enable) {
+		clusterGraph = std::make_unique<PathClusterGraph>(tileProps);
+	} else {
+		clusterGraph.reset();
+	}
+}
+
+void Map::SearchMapChanged(const SearchmapPoint& p) const
+{
+	if (clusterGraph) {
+		clusterGraph->Invalidate(p);
+	}
+}
+
 // Find a path from start to goal, ending at the specified distance from the
 // target (the goal must be in sight of the end, if PF_SIGHT is specified)
 Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned int minDistance, int flags, const Actor* caller) const
@@ -259,14 +344,20 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 	if (!mapSize.PointInside(smptSource)) return {};
 
 	// Initialize data structures
-	FibonacciHeap<PQNode> open;
-	std::vector<bool> isClosed(mapSize.Area(), false);
-	std::vector<NavmapPoint> parents(mapSize.Area(), Point(0, 0));
-	std::vector<unsigned short> distFromStart(mapSize.Area(), std::numeric_limits<unsigned short>::max());
-	distFromStart[smptSource.y * mapSize.w + smptSource.x] = 0;
-	parents[smptSource.y * mapSize.w + smptSource.x] = nmptSource;
+	static thread_local PathFinderWorkspace workspace;
+	workspace.Reset(mapSize);
+	FibonacciHeap<PQNode>& open = workspace.open;
+	workspace.SetDist(smptSource.y * mapSize.w + smptSource.x, 0);
+	workspace.SetParent(smptSource.y * mapSize.w + smptSource.x, nmptSource);
 	open.emplace(PQNode(nmptSource, 0));
 	bool foundPath = false;
+
+	// for long searches, first find a corridor of clusters on the abstract graph
+	// and only refine that, see PathClusterGraph
+	const std::vector<uint8_t>* corridor = nullptr;
+	if (clusterGraph && !(flags & PF_NO_CLUSTERS) && clusterGraph->IsLongRange(smptSource, smptDest) && clusterGraph->FindCorridor(smptSource, smptDest, workspace.corridor)) {
+		corridor = &workspace.corridor;
+	}
 	static bool usePlainThetaStar = gamedata->GetMiscRule("LAZY_THETA_STAR") == 0;
 	unsigned int squaredMinDist = minDistance * minDistance;
 
@@ -283,7 +374,7 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 		int crossProduct = std::abs(xDist * dyCross - yDist * dxCross) >> 3;
 		double distance = std::hypot(xDist, yDist);
 		double heuristic = HEURISTIC_WEIGHT * (distance + crossProduct);
-		double estDist = distFromStart[smptChildIdx] + heuristic;
+		double estDist = workspace.GetDist(smptChildIdx) + heuristic;
 		return estDist;
 	};
 
@@ -292,7 +383,7 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 		open.pop();
 		SearchmapPoint smptCurrent { nmptCurrent };
 		int smptCurrentIdx = smptCurrent.y * mapSize.w + smptCurrent.x;
-		if (parents[smptCurrentIdx].IsZero()) {
+		if (workspace.GetParent(smptCurrentIdx).IsZero()) {
 			continue;
 		}
 
@@ -301,7 +392,7 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 			foundPath = true;
 			break;
 		} else if (minDistance &&
-			   parents[smptCurrentIdx] != nmptCurrent &&
+			   workspace.GetParent(smptCurrentIdx) != nmptCurrent &&
 			   SquaredDistance(nmptCurrent, nmptDest) < squaredMinDist &&
 			   (!(flags & PF_SIGHT) || IsVisibleLOS(smptCurrent, smptDest0, caller))) { // FIXME: should probably be smptDest
 			smptDest = smptCurrent;
@@ -309,16 +400,17 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 			foundPath = true;
 			break;
 		}
-		isClosed[smptCurrentIdx] = true;
+		workspace.Close(smptCurrentIdx);
 
 		for (size_t i = 0; i < DEGREES_OF_FREEDOM; i++) {
 			NavmapPoint nmptChild(nmptCurrent.x + 16 * dxAdjacent[i], nmptCurrent.y + 12 * dyAdjacent[i]);
 			SearchmapPoint smptChild { nmptChild };
 			// Outside map
 			if (smptChild.x < 0 || smptChild.y < 0 || smptChild.x >= mapSize.w || smptChild.y >= mapSize.h) continue;
+			if (corridor && !clusterGraph->InCorridor(*corridor, smptChild)) continue;
 			// Already visited
 			int smptChildIdx = smptChild.y * mapSize.w + smptChild.x;
-			if (isClosed[smptChildIdx]) continue;
+			if (workspace.IsClosed(smptChildIdx)) continue;
 
 			PathMapFlags childBlockStatus;
 			if (size > 2) {
@@ -347,46 +439,46 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 			}
 
 			SearchmapPoint smptCurrent2 { nmptCurrent };
-			NavmapPoint nmptParent = parents[smptCurrent2.y * mapSize.w + smptCurrent2.x];
+			NavmapPoint nmptParent = workspace.GetParent(smptCurrent2.y * mapSize.w + smptCurrent2.x);
 			SearchmapPoint smptParent { nmptParent };
-			unsigned short oldDist = distFromStart[smptChildIdx];
+			unsigned short oldDist = workspace.GetDist(smptChildIdx);
 
 			if (usePlainThetaStar) {
 				// Theta-star path if there is LOS
 				if (IsWalkableTo(nmptParent, nmptChild, actorsAreBlocking, caller)) {
-					unsigned short newDist = distFromStart[smptParent.y * mapSize.w + smptParent.x] + Distance(smptParent, smptChild);
+					unsigned short newDist = workspace.GetDist(smptParent.y * mapSize.w + smptParent.x) + Distance(smptParent, smptChild);
 					if (newDist < oldDist) {
-						parents[smptChildIdx] = nmptParent;
-						distFromStart[smptChildIdx] = newDist;
+						workspace.SetParent(smptChildIdx, nmptParent);
+						workspace.SetDist(smptChildIdx, newDist);
 					}
 					// Fall back to A-star path
 				} else {
-					unsigned short newDist = distFromStart[smptCurrent2.y * mapSize.w + smptCurrent2.x] + Distance(smptCurrent2, smptChild);
+					unsigned short newDist = workspace.GetDist(smptCurrent2.y * mapSize.w + smptCurrent2.x) + Distance(smptCurrent2, smptChild);
 					if (newDist < oldDist) {
-						parents[smptChildIdx] = nmptCurrent;
-						distFromStart[smptChildIdx] = newDist;
+						workspace.SetParent(smptChildIdx, nmptCurrent);
+						workspace.SetDist(smptChildIdx, newDist);
 					}
 				}
 
-				if (distFromStart[smptChildIdx] < oldDist) {
+				if (workspace.GetDist(smptChildIdx) < oldDist) {
 					PQNode newNode(nmptChild, getHeuristic(smptChild, smptChildIdx));
 					open.emplace(newNode);
 				}
 			} else {
 				// Lazy Theta star*
-				unsigned short newDist = distFromStart[smptParent.y * mapSize.w + smptParent.x] + Distance(smptParent, smptChild);
+				unsigned short newDist = workspace.GetDist(smptParent.y * mapSize.w + smptParent.x) + Distance(smptParent, smptChild);
 				if (newDist < oldDist) {
-					parents[smptChildIdx] = nmptParent;
-					distFromStart[smptChildIdx] = newDist;
+					workspace.SetParent(smptChildIdx, nmptParent);
+					workspace.SetDist(smptChildIdx, newDist);
 				}
 
-				if (distFromStart[smptChildIdx] < oldDist) {
+				if (workspace.GetDist(smptChildIdx) < oldDist) {
 					// Theta-star path if there is LOS
 					// so far the searchmap grid appears too coarse to play on, see #2261
 					//if (!IsWalkableTo(smptParent, smptChild, actorsAreBlocking, caller)) {
 					if (!IsWalkableTo(nmptParent, nmptChild, actorsAreBlocking, caller)) {
 						// Fall back to A-star path
-						distFromStart[smptChildIdx] = std::numeric_limits<unsigned short>::max();
+						workspace.SetDist(smptChildIdx, std::numeric_limits<unsigned short>::max());
 						// Find already visited neighbour with shortest: path from start + path to child
 						for (size_t j = 0; j < DEGREES_OF_FREEDOM; j++) {
 							NavmapPoint nmptVis(nmptChild.x + 16 * dxAdjacent[j], nmptChild.y + 12 * dyAdjacent[j]);
@@ -394,16 +486,16 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 							// Outside map
 							if (smptVis.x < 0 || smptVis.y < 0 || smptVis.x >= mapSize.w || smptVis.y >= mapSize.h) continue;
 							// Only consider already visited
-							if (!isClosed[smptVis.y * mapSize.w + smptVis.x]) continue;
+							if (!workspace.IsClosed(smptVis.y * mapSize.w + smptVis.x)) continue;
 
-							unsigned short oldVisDist = distFromStart[smptChildIdx];
-							newDist = distFromStart[smptVis.y * mapSize.w + smptVis.x] + Distance(smptVis, smptChild);
+							unsigned short oldVisDist = workspace.GetDist(smptChildIdx);
+							newDist = workspace.GetDist(smptVis.y * mapSize.w + smptVis.x) + Distance(smptVis, smptChild);
 							if (newDist < oldVisDist) {
-								parents[smptChildIdx] = nmptVis;
-								distFromStart[smptChildIdx] = newDist;
+								workspace.SetParent(smptChildIdx, nmptVis);
+								workspace.SetDist(smptChildIdx, newDist);
 							}
 						}
-						if (distFromStart[smptChildIdx] >= oldDist) continue;
+						if (workspace.GetDist(smptChildIdx) >= oldDist) continue;
 					}
 
 					PQNode newNode(nmptChild, getHeuristic(smptChild, smptChildIdx));
@@ -418,8 +510,8 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 		NavmapPoint nmptCurrent = nmptDest;
 		NavmapPoint nmptParent;
 		SearchmapPoint smptCurrent { nmptCurrent };
-		while (!resultPath || nmptCurrent != parents[smptCurrent.y * mapSize.w + smptCurrent.x]) {
-			nmptParent = parents[smptCurrent.y * mapSize.w + smptCurrent.x];
+		while (!resultPath || nmptCurrent != workspace.GetParent(smptCurrent.y * mapSize.w + smptCurrent.x)) {
+			nmptParent = workspace.GetParent(smptCurrent.y * mapSize.w + smptCurrent.x);
 			PathNode newStep { nmptCurrent, S };
 			// movement in general allows characters to walk backwards given that
 			// the destination is behind the character (within a threshold), and
@@ -438,6 +530,9 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 			smptCurrent = SearchmapPoint(nmptCurrent);
 		}
 		return resultPath;
+	} else if (corridor) {
+		// the corridor ignores actors and creature size, so retry without it if it was too tight
+		return FindPath(s, d, size, minDistance, flags | PF_NO_CLUSTERS, caller);
 	} else if (InDebugMode(DebugMode::PATHFINDER)) {
 		if (caller) {
 			Log(DEBUG, "FindPath", "Pathing failed for {}", fmt::WideToChar { caller->GetShortName() });
@@ -135,7 +135,8 @@ enum {
 	PF_SIGHT = 1,
 	PF_BACKAWAY = 2,
 	PF_ACTORS_ARE_BLOCKING = 4,
-	PF_PRECISE = 8  // TBC: use optimal pathfinding (no heuristic weight)
+	PF_PRECISE = 8, // TBC: use optimal pathfinding (no heuristic weight)
+	PF_NO_CLUSTERS = 16 // search the whole map, even if a cluster graph is available
 };
 
 
@@ -45,6 +45,8 @@ private:
 
 public:
 	static RNG& getInstance();
+	// for reproducible runs, see the RandomSeed setting
+	void Seed(uint32_t seed) { engine.seed(seed); }
 
 	/**
 	 * It is possible to generate random numbers from [-min, +/-max].
@@ -102,9 +102,65 @@ bool ResourceManager::AddSource(const path_t& path, const std::string& descripti
 	} else {
 		searchPath.push_back(source);
 	}
+	InvalidateIndex();
 	return true;
 }
 
+void ResourceManager::InvalidateIndex()
+{
+	std::lock_guard<std::mutex> guard(indexLock);
+	index.clear();
+	liveSources.clear();
+	for (size_t i = 0; i < searchPath.size(); ++i) {
+		if (!searchPath[i]->HasFixedContents()) {
+			liveSources.push_back(i);
+		}
+	}
+}
+
+template<typename HAS>
+size_t ResourceManager::Locate(StringView resname, const path_t& ext, SClass_ID keyType, HAS&& has) const
+{
+	// every source ignores the case of the name
+	std::string key;
+	key.reserve(resname.length() + ext.length() + 8);
+	for (char c : resname) {
+		key.push_back(char(tolower(c)));
+	}
+	key.push_back('.');
+	key += ext;
+	key.push_back('.');
+	key += std::to_string(keyType);
+
+	size_t winner = searchPath.size();
+	std::unique_lock<std::mutex> guard(indexLock);
+	const auto lookup = index.find(key);
+	if (lookup != index.cend()) {
+		winner = lookup->second;
+		guard.unlock();
+	} else {
+		guard.unlock();
+		for (size_t i = 0; i < searchPath.size(); ++i) {
+			if (searchPath[i]->HasFixedContents() && has(*searchPath[i])) {
+				winner = i;
+				break;
+			}
+		}
+		guard.lock();
+		index.emplace(std::move(key), winner);
+		guard.unlock();
+	}
+
+	// the others still get their say if they come first
+	for (size_t i : liveSources) {
+		if (i >= winner) break;
+		if (has(*searchPath[i])) {
+			return i;
+		}
+	}
+	return winner;
+}
+
 static void PrintPossibleFiles(std::string& buffer, StringView ResRef, const TypeID* type)
 {
 	const std::vector<ResourceDesc>& types = PluginMgr::Get()->GetResourceDesc(type);
@@ -125,11 +181,11 @@ bool ResourceManager::Exists(StringView ResRef, SClass_ID type, bool silent) con
 {
 	if (ResRef.empty())
 		return false;
-	// TODO: check various caches
-	for (const auto& path : searchPath) {
-		if (path->HasResource(ResRef, type)) {
-			return true;
-		}
+	size_t found = Locate(ResRef, TypeExt(type), type, [&](ResourceSource& source) {
+		return source.HasResource(ResRef, type);
+	});
+	if (found < searchPath.size()) {
+		return true;
 	}
 	if (!silent) {
 		Log(WARNING, "ResourceManager", "'{}.{}' not found...",
@@ -142,13 +198,13 @@ bool ResourceManager::Exists(StringView ResRef, const TypeID* type, bool silent)
 {
 	if (ResRef[0] == '\0')
 		return false;
-	// TODO: check various caches
 	const std::vector<ResourceDesc>& types = PluginMgr::Get()->GetResourceDesc(type);
 	for (const auto& type2 : types) {
-		for (const auto& path : searchPath) {
-			if (path->HasResource(ResRef, type2)) {
-				return true;
-			}
+		size_t found = Locate(ResRef, type2.GetExt(), type2.GetKeyType(), [&](ResourceSource& source) {
+			return source.HasResource(ResRef, type2);
+		});
+		if (found < searchPath.size()) {
+			return true;
 		}
 	}
 	if (!silent) {
@@ -163,7 +219,11 @@ DataStream* ResourceManager::GetResourceStream(StringView ResRef, SClass_ID type
 {
 	if (ResRef.empty())
 		return nullptr;
-	for (const auto& path : searchPath) {
+	size_t found = Locate(ResRef, TypeExt(type), type, [&](ResourceSource& source) {
+		return source.HasResource(ResRef, type);
+	});
+	for (size_t i = found; i < searchPath.size(); ++i) {
+		const auto& path = searchPath[i];
 		DataStream* ds = path->GetResource(ResRef, type);
 		if (ds) {
 			if (!silent) {
@@ -193,7 +253,12 @@ ResourceHolder<Resource> ResourceManager::GetResource(StringView ResRef, const T
 	}
 
 	for (const auto& type2 : types2) {
-		for (const auto& path : searchPath) {
+		size_t found = Locate(ResRef, type2.GetExt(), type2.GetKeyType(), [&](ResourceSource& source) {
+			return source.HasResource(ResRef, type2);
+		});
+		// keep looking further if the found one is broken
+		for (size_t i = found; i < searchPath.size(); ++i) {
+			const auto& path = searchPath[i];
 			DataStream* str = path->GetResource(ResRef, type2);
 			if (!str) continue;
 
@@ -30,6 +30,9 @@
 #include "System/VFS.h"
 
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace GemRB {
@@ -49,6 +52,8 @@ public:
 	 * @param[in] type Plugin type used for source.
 	 **/
 	bool AddSource(const path_t& path, const std::string& description, PluginID type, int flags = 0);
+	/** Forgets all remembered lookups, for when the contents of a source changed */
+	void InvalidateIndex();
 
 	/** returns true if resource exists */
 	bool Exists(const String& resRef, SClass_ID type, bool silent = false) const;
@@ -67,7 +72,18 @@ private:
 	/** Returns Resource object associated to given resource */
 	ResourceHolder<Resource> GetResource(StringView resname, const TypeID* type, bool silent = false, ieWord prefferedType = 0) const;
 
+	/** Returns the index of the first source in searchPath having the resource, or its size if none */
+	template<typename HAS>
+	size_t Locate(StringView resname, const path_t& ext, SClass_ID keyType, HAS&& has) const;
+
 	std::vector<PluginHolder<ResourceSource>> searchPath;
+	// winning source among the ones with fixed contents, for every resource asked
+	// for so far; misses are remembered too, as searchPath.size()
+	mutable std::unordered_map<std::string, size_t> index;
+	// the ResourcePrefetcher looks things up from its own thread
+	mutable std::mutex indexLock;
+	// sources that always have to be asked, like the cache directory
+	std::vector<size_t> liveSources;
 };
 
 }
@@ -0,0 +1,270 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "ResourcePrefetcher.h"
+
+#include "Map.h"
+#include "ResourceManager.h"
+
+#include "Logging/Logging.h"
+#include "Streams/DataStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace GemRB {
+
+// offsets into the ARE and WED formats, see AREImporter and WEDImporter
+static constexpr strpos_t ARE_ACTORS = 0x54;
+static constexpr strpos_t ARE_AMBIENTS = 0x82;
+static constexpr strpos_t ARE_SCRIPT = 0x94;
+static constexpr strpos_t ARE_ANIMATIONS = 0xac;
+static constexpr strpos_t ARE_ACTOR_SIZE = 0x110;
+static constexpr strpos_t ARE_AMBIENT_SIZE = 0xd4;
+static constexpr strpos_t ARE_ANIMATION_SIZE = 0x4c;
+static constexpr strpos_t WED_OVERLAY_SIZE = 0x18;
+static constexpr ieWord MAX_AMBIENT_SOUNDS = 10;
+
+ResourcePrefetcher::ResourcePrefetcher(const ResourceManager& resources) noexcept
+	: resources(resources)
+{
+}
+
+ResourcePrefetcher::~ResourcePrefetcher()
+{
+	Stop();
+}
+
+void ResourcePrefetcher::Stop()
+{
+	{
+		std::lock_guard<std::mutex> guard(queueLock);
+		stopping = true;
+		queue.clear();
+	}
+	wakeUp.notify_one();
+	if (worker.joinable()) {
+		worker.join();
+	}
+}
+
+void ResourcePrefetcher::PrefetchArea(const ResRef& area, bool urgent)
+{
+	if (area.IsEmpty()) return;
+
+	{
+		std::lock_guard<std::mutex> guard(queueLock);
+		if (stopping) return;
+		if (std::find(done.begin(), done.end(), area) != done.end()) return;
+
+		auto queued = std::find(queue.begin(), queue.end(), area);
+		if (queued != queue.end()) {
+			if (!urgent) return;
+			queue.erase(queued);
+		}
+		if (urgent) {
+			queue.push_front(area);
+		} else {
+			queue.push_back(area);
+		}
+		if (queue.size() > MAX_QUEUED) {
+			queue.pop_back();
+		}
+
+		if (!worker.joinable()) {
+			worker = std::thread(&ResourcePrefetcher::Run, this);
+		}
+	}
+	wakeUp.notify_one();
+}
+
+void ResourcePrefetcher::Run()
+{
+	while (true) {
+		ResRef area;
+		{
+			std::unique_lock<std::mutex> guard(queueLock);
+			wakeUp.wait(guard, [this]() { return stopping || !queue.empty(); });
+			if (stopping) return;
+			area = queue.front();
+			queue.pop_front();
+			// remember it right away, the main thread may ask again meanwhile
+			done.push_back(area);
+			if (done.size() > MAX_REMEMBERED) {
+				done.pop_front();
+			}
+		}
+
+		WarmArea(area);
+		++areaCount;
+	}
+}
+
+DataStream* ResourcePrefetcher::Fetch(const ResRef& resRef, SClass_ID type)
+{
+	if (resRef.IsEmpty() || IsStar(resRef) || stopping) return nullptr;
+
+	DataStream* stream = resources.GetResourceStream(resRef, type, true);
+	if (!stream) return nullptr;
+
+	char buffer[16384];
+	strpos_t remains = stream->Remains();
+	while (remains && !stopping) {
+		strpos_t len = std::min<strpos_t>(remains, sizeof(buffer));
+		if (stream->Read(buffer, len) != strret_t(len)) break;
+		remains -= len;
+	}
+	stream->Rewind();
+	++resourceCount;
+	return stream;
+}
+
+void ResourcePrefetcher::Warm(const ResRef& resRef, SClass_ID type)
+{
+	delete Fetch(resRef, type);
+}
+
+void ResourcePrefetcher::WarmArea(const ResRef& area)
+{
+	DataStream* are = Fetch(area, IE_ARE_CLASS_ID);
+	if (!are) return;
+
+	char signature[8];
+	are->Read(signature, 8);
+	strpos_t bigHeader = 0;
+	if (strncmp(signature, "AREAV9.1", 8) == 0) {
+		bigHeader = 16;
+	} else if (strncmp(signature, "AREAV1.0", 8) != 0) {
+		delete are;
+		return;
+	}
+
+	std::vector<std::pair<ResRef, SClass_ID>> wanted;
+	auto want = [&wanted](const ResRef& resRef, SClass_ID type) {
+		if (resRef.IsEmpty() || IsStar(resRef)) return;
+		std::pair<ResRef, SClass_ID> entry(resRef, type);
+		if (std::find(wanted.begin(), wanted.end(), entry) == wanted.end()) {
+			wanted.push_back(entry);
+		}
+	};
+
+	ResRef wedRef;
+	are->ReadResRef(wedRef);
+
+	ieDword actorOffset;
+	ieWord actorCount;
+	are->Seek(ARE_ACTORS + bigHeader, GEM_STREAM_START);
+	are->ReadDword(actorOffset);
+	are->ReadWord(actorCount);
+
+	ieWord ambientCount;
+	ieDword ambientOffset;
+	are->Seek(ARE_AMBIENTS + bigHeader, GEM_STREAM_START);
+	are->ReadWord(ambientCount);
+	are->ReadDword(ambientOffset);
+
+	ResRef script;
+	are->Seek(ARE_SCRIPT + bigHeader, GEM_STREAM_START);
+	are->ReadResRef(script);
+	want(script, IE_BCS_CLASS_ID);
+
+	ieDword animCount;
+	ieDword animOffset;
+	are->Seek(ARE_ANIMATIONS + bigHeader, GEM_STREAM_START);
+	are->ReadDword(animCount);
+	are->ReadDword(animOffset);
+
+	for (ieWord i = 0; i < actorCount && !stopping; ++i) {
+		ieDword flags;
+		ieDword creOffset;
+		ResRef creRef;
+		strpos_t actor = actorOffset + i * ARE_ACTOR_SIZE;
+		are->Seek(actor + 0x28, GEM_STREAM_START);
+		are->ReadDword(flags);
+		are->Seek(actor + 0x80, GEM_STREAM_START);
+		are->ReadResRef(creRef);
+		are->ReadDword(creOffset);
+		// embedded ones come with the area
+		if (creOffset == 0 || (flags & AF_CRE_NOT_LOADED)) {
+			want(creRef, IE_CRE_CLASS_ID);
+		}
+	}
+
+	for (ieWord i = 0; i < ambientCount && !stopping; ++i) {
+		ResRef sounds[MAX_AMBIENT_SOUNDS];
+		ieWord soundCount;
+		are->Seek(ambientOffset + i * ARE_AMBIENT_SIZE + 0x30, GEM_STREAM_START);
+		for (auto& sound : sounds) {
+			are->ReadResRef(sound);
+		}
+		are->ReadWord(soundCount);
+		for (ieWord j = 0; j < std::min(soundCount, MAX_AMBIENT_SOUNDS); ++j) {
+			want(sounds[j], IE_WAV_CLASS_ID);
+		}
+	}
+
+	for (ieDword i = 0; i < animCount && !stopping; ++i) {
+		ResRef bam;
+		are->Seek(animOffset + i * ARE_ANIMATION_SIZE + 0x28, GEM_STREAM_START);
+		are->ReadResRef(bam);
+		want(bam, IE_BAM_CLASS_ID);
+	}
+	delete are;
+
+	// the tilesets are the bulk of it
+	DataStream* wed = Fetch(wedRef, IE_WED_CLASS_ID);
+	if (wed) {
+		char wedSignature[8];
+		ieDword overlayCount;
+		ieDword overlayOffset;
+		wed->Read(wedSignature, 8);
+		wed->ReadDword(overlayCount);
+		wed->Seek(4, GEM_CURRENT_POS);
+		wed->ReadDword(overlayOffset);
+		if (strncmp(wedSignature, "WED V1.3", 8) == 0) {
+			for (ieDword i = 0; i < overlayCount; ++i) {
+				ResRef tileset;
+				wed->Seek(overlayOffset + i * WED_OVERLAY_SIZE + 4, GEM_STREAM_START);
+				wed->ReadResRef(tileset);
+				want(tileset, IE_TIS_CLASS_ID);
+			}
+		}
+		delete wed;
+	}
+
+	// the search, light and height maps, in whichever format the game has
+	for (const char* suffix : { "SR", "LM", "HT" }) {
+		ResRef bitmap;
+		bitmap.Format("{:.6}{}", wedRef, suffix);
+		DataStream* stream = Fetch(bitmap, IE_BMP_CLASS_ID);
+		if (!stream) {
+			stream = Fetch(bitmap, IE_PNG_CLASS_ID);
+		}
+		delete stream;
+	}
+
+	for (const auto& entry : wanted) {
+		if (stopping) break;
+		Warm(entry.first, entry.second);
+	}
+	Log(DEBUG, "ResourcePrefetcher", "Prefetched {} resources for {}.", wanted.size(), area);
+}
+
+}
@@ -0,0 +1,87 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef RESOURCEPREFETCHER_H
+#define RESOURCEPREFETCHER_H
+
+#include "exports.h"
+
+#include "Resource.h"
+#include "SClassID.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace GemRB {
+
+class DataStream;
+class ResourceManager;
+
+// Reads the files an area will need on a background thread, before it gets
+// loaded for real: the ARE and WED, the tilesets, the creatures not stored in
+// the area, the area animations, ambient sounds and the search, light and
+// height maps. Nothing gets parsed for the game, the point is to have the
+// compressed archives already in the cache and the rest in the OS file cache,
+// so the synchronous load on the main thread doesn't wait for the disk.
+class GEM_EXPORT ResourcePrefetcher {
+public:
+	explicit ResourcePrefetcher(const ResourceManager& resources) noexcept;
+	ResourcePrefetcher(const ResourcePrefetcher&) = delete;
+	~ResourcePrefetcher();
+	ResourcePrefetcher& operator=(const ResourcePrefetcher&) = delete;
+
+	// urgent requests are for areas the party is heading to and jump the queue,
+	// the rest are guesses and get dropped first when too many pile up
+	void PrefetchArea(const ResRef& area, bool urgent);
+	void Stop();
+
+	size_t GetAreaCount() const { return areaCount; }
+	size_t GetResourceCount() const { return resourceCount; }
+
+private:
+	static constexpr size_t MAX_QUEUED = 8;
+	// areas done recently, so hovering over an exit doesn't read them again
+	static constexpr size_t MAX_REMEMBERED = 16;
+
+	const ResourceManager& resources;
+	std::thread worker;
+	std::mutex queueLock;
+	std::condition_variable wakeUp;
+	std::deque<ResRef> queue;
+	std::deque<ResRef> done;
+	std::atomic<bool> stopping { false };
+	std::atomic<size_t> areaCount { 0 };
+	std::atomic<size_t> resourceCount { 0 };
+
+	void Run();
+	void WarmArea(const ResRef& area);
+	// reads the whole resource and returns it rewound, if found
+	DataStream* Fetch(const ResRef& resRef, SClass_ID type);
+	void Warm(const ResRef& resRef, SClass_ID type);
+};
+
+}
+
+#endif
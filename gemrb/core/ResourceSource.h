@@ -42,6 +42,8 @@ public:
 	virtual bool HasResource(StringView resname, const ResourceDesc& type) = 0;
 	virtual DataStream* GetResource(StringView resname, SClass_ID type) = 0;
 	virtual DataStream* GetResource(StringView resname, const ResourceDesc& type) = 0;
+	/* true if the answers can't change after Open, so the ResourceManager may remember them */
+	virtual bool HasFixedContents() const { return false; }
 	const std::string& GetDescription() const { return description; }
 
 protected:
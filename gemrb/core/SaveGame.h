@@ -27,6 +27,8 @@
 
 #include "System/VFS.h"
 
+#include <ctime>
+
 namespace GemRB {
 
 class ImageMgr;
@@ -37,7 +39,7 @@ public:
 	static const TypeID ID;
 
 public:
-	SaveGame(path_t path, const path_t& name, const ResRef& prefix, std::string slotname, int pCount, int saveID);
+	SaveGame(path_t path, const path_t& name, const ResRef& prefix, std::string slotname, int pCount, int saveID, time_t date);
 
 	int GetPortraitCount() const
 	{
@@ -81,6 +83,8 @@ private:
 	ResRef Prefix;
 	std::string Date;
 	mutable std::string GameDate;
+	// bg1 shows the chapter too, it is kept for when the date is asked for again
+	mutable int Chapter = -1;
 	std::string SlotName;
 	int PortraitCount;
 	int SaveID;
@@ -0,0 +1,173 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "SaveGameIndex.h"
+
+#include "Logging/Logging.h"
+#include "Streams/FileStream.h"
+
+#include <cstdio>
+
+namespace GemRB {
+
+SaveGameIndex::SaveGameIndex(path_t file) noexcept
+	: file(std::move(file))
+{
+}
+
+bool SaveGameIndex::IsFresh(int64_t recorded, int64_t checked, int64_t current)
+{
+	return recorded == current && recorded < checked;
+}
+
+bool SaveGameIndex::Load()
+{
+	slots.clear();
+	dirTime = 0;
+	dirChecked = 0;
+	dirty = false;
+
+	FileStream stream;
+	if (!FileExists(file) || !stream.Open(file)) {
+		return false;
+	}
+
+	std::string line;
+	int version = 0;
+	if (stream.ReadLine(line) == DataStream::Error || sscanf(line.c_str(), "GemRB save index %d", &version) != 1 || version != VERSION) {
+		Log(DEBUG, "SaveGameIndex", "Ignoring outdated or broken index {}.", file);
+		return false;
+	}
+
+	long long listed = 0;
+	long long listChecked = 0;
+	if (stream.ReadLine(line) == DataStream::Error || sscanf(line.c_str(), "dir %lld %lld", &listed, &listChecked) != 2) {
+		return false;
+	}
+	dirTime = listed;
+	dirChecked = listChecked;
+
+	while (stream.ReadLine(line) != DataStream::Error) {
+		long long slotTime = 0;
+		long long checked = 0;
+		long long previewTime = 0;
+		int portraits = 0;
+		int valid = 0;
+		int nameStart = 0;
+		if (sscanf(line.c_str(), "%lld %lld %lld %d %d %n", &slotTime, &checked, &previewTime, &portraits, &valid, &nameStart) != 5 || !nameStart) {
+			continue;
+		}
+
+		Slot& slot = slots[line.substr(nameStart)];
+		slot.dirTime = slotTime;
+		slot.checked = checked;
+		slot.previewTime = previewTime;
+		slot.portraits = portraits;
+		slot.valid = valid != 0;
+	}
+	return true;
+}
+
+bool SaveGameIndex::Store()
+{
+	if (!dirty) return true;
+
+	std::string contents = fmt::format("GemRB save index {}\ndir {} {}\n", VERSION, dirTime, dirChecked);
+	for (const auto& slot : slots) {
+		contents += fmt::format("{} {} {} {} {} {}\n", slot.second.dirTime, slot.second.checked,
+					slot.second.previewTime, slot.second.portraits, int(slot.second.valid), slot.first);
+	}
+
+	FileStream stream;
+	if (!stream.Create(file) || stream.Write(contents.c_str(), contents.length()) != strret_t(contents.length())) {
+		// not fatal, the slots just get checked again next time
+		Log(DEBUG, "SaveGameIndex", "Unable to write {}.", file);
+		return false;
+	}
+	dirty = false;
+	return true;
+}
+
+bool SaveGameIndex::ListingIsFresh(int64_t current) const
+{
+	return IsFresh(dirTime, dirChecked, current);
+}
+
+void SaveGameIndex::SetListing(int64_t current, int64_t now)
+{
+	if (dirTime == current && dirChecked == now) return;
+	dirTime = current;
+	dirChecked = now;
+	dirty = true;
+}
+
+void SaveGameIndex::InvalidateListing()
+{
+	if (!dirTime && !dirChecked) return;
+	dirTime = 0;
+	dirChecked = 0;
+	dirty = true;
+}
+
+std::vector<std::string> SaveGameIndex::GetSlotNames() const
+{
+	std::vector<std::string> names;
+	names.reserve(slots.size());
+	for (const auto& slot : slots) {
+		names.push_back(slot.first);
+	}
+	return names;
+}
+
+const SaveGameIndex::Slot* SaveGameIndex::Lookup(const std::string& slotname, int64_t current) const
+{
+	auto it = slots.find(slotname);
+	if (it == slots.end() || !IsFresh(it->second.dirTime, it->second.checked, current)) {
+		return nullptr;
+	}
+	return &it->second;
+}
+
+void SaveGameIndex::Update(const std::string& slotname, const Slot& slot)
+{
+	slots[slotname] = slot;
+	dirty = true;
+}
+
+void SaveGameIndex::Invalidate(const std::string& slotname)
+{
+	if (slots.erase(slotname)) {
+		dirty = true;
+	}
+}
+
+void SaveGameIndex::Retain(const std::set<std::string>& slotnames)
+{
+	for (auto it = slots.begin(); it != slots.end();) {
+		if (slotnames.count(it->first)) {
+			++it;
+		} else {
+			it = slots.erase(it);
+			dirty = true;
+		}
+	}
+}
+
+}
@@ -0,0 +1,85 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef SAVEGAMEINDEX_H
+#define SAVEGAMEINDEX_H
+
+#include "exports.h"
+
+#include "System/VFS.h"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace GemRB {
+
+// Remembers what SaveGameIterator found out about each save slot, in a small
+// text file next to the save directory, so the slots only need to be checked
+// again once their directories change. Timestamps that fall in the same second
+// as the check that recorded them can't be trusted, since a later change in
+// that second would go unnoticed, so such records are always redone.
+class GEM_EXPORT SaveGameIndex {
+public:
+	struct Slot {
+		int64_t dirTime = 0; // modification time of the slot directory
+		int64_t checked = 0; // when the slot was looked at
+		int64_t previewTime = 0; // of the preview bmp, shown as the save date
+		int portraits = 0;
+		bool valid = false; // false for directories that aren't usable saves
+	};
+
+	explicit SaveGameIndex(path_t file) noexcept;
+
+	const path_t& GetFile() const { return file; }
+	bool Load();
+	// writes the file, if anything changed since it was loaded or written
+	bool Store();
+
+	// true if the slot names are still those of the directory with this mtime
+	bool ListingIsFresh(int64_t dirTime) const;
+	void SetListing(int64_t dirTime, int64_t now);
+	void InvalidateListing();
+	std::vector<std::string> GetSlotNames() const;
+
+	// returns the record if the slot directory still has this mtime
+	const Slot* Lookup(const std::string& slotname, int64_t dirTime) const;
+	void Update(const std::string& slotname, const Slot& slot);
+	void Invalidate(const std::string& slotname);
+	// forgets the slots that are gone
+	void Retain(const std::set<std::string>& slotnames);
+
+private:
+	static constexpr int VERSION = 1;
+
+	path_t file;
+	int64_t dirTime = 0;
+	int64_t dirChecked = 0;
+	std::map<std::string, Slot> slots;
+	bool dirty = false;
+
+	static bool IsFresh(int64_t recorded, int64_t checked, int64_t current);
+};
+
+}
+
+#endif
@@ -53,7 +53,7 @@ namespace GemRB {
 const TypeID SaveGame::ID = { "SaveGame" };
 
 /** Extract date from save game ds into Date. */
-static std::string ParseGameDate(DataStream* ds)
+static std::string ParseGameDate(DataStream* ds, int& chapterOut)
 {
 	char Signature[8];
 	ieDword GameTime;
@@ -81,7 +81,7 @@ static std::string ParseGameDate(DataStream* ds)
 			ds->Read(&chapter, 1);
 		}
 
-		SetTokenAsString("CHAPTER0", chapter);
+		chapterOut = chapter;
 	}
 	delete ds;
 
@@ -124,21 +124,13 @@ static std::string ParseGameDate(DataStream* ds)
 	}
 }
 
-SaveGame::SaveGame(path_t path, const path_t& name, const ResRef& prefix, std::string slotname, int pCount, int saveID)
+SaveGame::SaveGame(path_t path, const path_t& name, const ResRef& prefix, std::string slotname, int pCount, int saveID, time_t date)
 	: Path(std::move(path)), Prefix(prefix), SlotName(std::move(slotname))
 {
 	static const auto DATE_FMT = FMT_STRING("{:%a %Od %b %T %EY}");
 	PortraitCount = pCount;
 	SaveID = saveID;
-	struct stat my_stat;
-	path_t nPath = PathJoinExt(Path, Prefix, "bmp");
-	memset(&my_stat, 0, sizeof(my_stat));
-	if (stat(nPath.c_str(), &my_stat)) {
-		Log(ERROR, "SaveGameIterator", "Stat call failed, using dummy time!");
-		Date = fmt::format(DATE_FMT, fmt::localtime(0));
-	} else {
-		Date = fmt::format(DATE_FMT, fmt::localtime(my_stat.st_mtime));
-	}
+	Date = fmt::format(DATE_FMT, fmt::localtime(date));
 	manager.AddSource(Path, name, PLUGIN_RESOURCE_DIRECTORY);
 	Name = StringFromUtf8(name);
 }
@@ -182,7 +174,11 @@ DataStream* SaveGame::GetSave() const
 const std::string& SaveGame::GetGameDate() const
 {
 	if (GameDate.empty())
-		GameDate = ParseGameDate(GetGame());
+		GameDate = ParseGameDate(GetGame(), Chapter);
+	// the token is shared by all saves, so set it again for each one shown
+	if (Chapter >= 0) {
+		SetTokenAsString("CHAPTER0", Chapter);
+	}
 	return GameDate;
 }
 
@@ -272,6 +268,46 @@ static bool IsSaveGameSlot(const path_t& Path, const path_t& slotname)
 	return true;
 }
 
+static int CountPortraits(const path_t& path)
+{
+	int count = 0;
+	DirectoryIterator dir(path);
+	if (!dir) {
+		return count;
+	}
+	do {
+		if (strnicmp(dir.GetName().c_str(), "PORTRT", 6) == 0)
+			count++;
+	} while (++dir);
+	return count;
+}
+
+SaveGameIndex::Slot SaveGameIterator::CheckSlot(const path_t& path, const std::string& slotname, int64_t dirTime)
+{
+	SaveGameIndex::Slot slot;
+	slot.dirTime = dirTime;
+	slot.checked = time(nullptr);
+	slot.valid = IsSaveGameSlot(path, slotname);
+	if (!slot.valid) {
+		return slot;
+	}
+
+	path_t slotPath = PathJoin(path, slotname);
+	slot.portraits = CountPortraits(slotPath);
+
+	uint64_t size = 0;
+	if (!FileStats(PathJoinExt(slotPath, core->GameNameResRef, "bmp"), size, slot.previewTime)) {
+		Log(ERROR, "SaveGameIterator", "Stat call failed, using dummy time!");
+		slot.previewTime = 0;
+	}
+	return slot;
+}
+
+SaveGameIterator::~SaveGameIterator() noexcept
+{
+	previews.Stop();
+}
+
 bool SaveGameIterator::RescanSaveGames()
 {
 	// delete old entries
@@ -279,35 +315,85 @@ bool SaveGameIterator::RescanSaveGames()
 
 	path_t Path = PathJoin(core->config.SavePath, SaveDir());
 
-	DirectoryIterator dir(Path);
-	// create the save game directory at first access
-	if (!dir) {
-		if (!MakeDirectories(Path)) {
-			Log(ERROR, "SaveGameIterator", "Unable to create save game directory '{}'", Path);
-			return false;
-		}
-		dir.Rewind();
-	}
-	if (!dir) { //If we cannot open the Directory
-		return false;
+	// the expansions have their own save directory, so their own index
+	path_t indexFile = PathJoin(core->config.SavePath, fmt::format("gemrb-{}.idx", SaveDir()));
+	if (!index || index->GetFile() != indexFile) {
+		index = std::make_unique<SaveGameIndex>(indexFile);
+		index->Load();
+		builtSaves.clear();
 	}
 
 	std::set<std::string> slots;
-	dir.SetFlags(DirectoryIterator::Directories);
-	do {
-		const path_t& name = dir.GetName();
-		if (IsSaveGameSlot(Path, name)) {
-			slots.emplace(name);
+	int64_t dirTime = 0;
+	if (DirStats(Path, dirTime) && index->ListingIsFresh(dirTime)) {
+		for (auto& name : index->GetSlotNames()) {
+			slots.emplace(std::move(name));
 		}
-	} while (++dir);
+	} else {
+		DirectoryIterator dir(Path);
+		// create the save game directory at first access
+		if (!dir) {
+			if (!MakeDirectories(Path)) {
+				Log(ERROR, "SaveGameIterator", "Unable to create save game directory '{}'", Path);
+				return false;
+			}
+			dir.Rewind();
+		}
+		if (!dir) { //If we cannot open the Directory
+			return false;
+		}
+
+		dir.SetFlags(DirectoryIterator::Directories);
+		do {
+			slots.emplace(dir.GetName());
+		} while (++dir);
+
+		if (DirStats(Path, dirTime)) {
+			index->SetListing(dirTime, time(nullptr));
+		}
+	}
+	index->Retain(slots);
 
+	std::map<std::string, Holder<SaveGame>> oldSaves;
+	oldSaves.swap(builtSaves);
 	for (const auto& slot : slots) {
-		auto saveGame = BuildSaveGame(slot);
+		int64_t slotTime = 0;
+		if (!DirStats(PathJoin(Path, slot), slotTime)) {
+			index->Invalidate(slot);
+			continue;
+		}
+
+		SaveGameIndex::Slot checked;
+		const SaveGameIndex::Slot* record = index->Lookup(slot, slotTime);
+		if (!record) {
+			checked = CheckSlot(Path, slot, slotTime);
+			index->Update(slot, checked);
+			record = &checked;
+			// don't reuse anything built from what was there before
+			auto old = oldSaves.find(slot);
+			if (old != oldSaves.end()) {
+				previews.Forget(old->second.get());
+				oldSaves.erase(old);
+			}
+		}
+		if (!record->valid) {
+			continue;
+		}
+
+		auto old = oldSaves.find(slot);
+		Holder<SaveGame> saveGame = old != oldSaves.end() ? old->second : BuildSaveGame(slot, *record);
 		if (saveGame) {
 			save_slots.push_back(saveGame);
+			builtSaves.emplace(slot, std::move(saveGame));
+		}
+	}
+	for (const auto& old : oldSaves) {
+		if (!builtSaves.count(old.first)) {
+			previews.Forget(old.second.get());
 		}
 	}
 
+	index->Store();
 	return true;
 }
 
@@ -329,9 +415,18 @@ Holder<SaveGame> SaveGameIterator::GetSaveGame(const String& name)
 	return NULL;
 }
 
-Holder<SaveGame> SaveGameIterator::BuildSaveGame(std::string slotname)
+Holder<Sprite2D> SaveGameIterator::GetPreview(const Holder<SaveGame>& save) const
+{
+	return previews.GetPreview(save_slots, save);
+}
+
+Holder<Sprite2D> SaveGameIterator::GetPortrait(const Holder<SaveGame>& save, int idx) const
+{
+	return previews.GetPortrait(save_slots, save, idx);
+}
+
+Holder<SaveGame> SaveGameIterator::BuildSaveGame(std::string slotname, const SaveGameIndex::Slot& slot)
 {
-	int prtrt = 0;
 	//lets leave space for the filenames
 	path_t Path = PathJoin(core->config.SavePath, SaveDir(), slotname);
 
@@ -340,16 +435,15 @@ Holder<SaveGame> SaveGameIterator::BuildSaveGame(std::string slotname)
 
 	sscanf(slotname.c_str(), SAVEGAME_DIRECTORY_MATCHER, &savegameNumber, savegameName);
 
-	DirectoryIterator dir(Path);
-	if (!dir) {
-		return NULL;
-	}
-	do {
-		if (strnicmp(dir.GetName().c_str(), "PORTRT", 6) == 0)
-			prtrt++;
-	} while (++dir);
+	return MakeHolder<SaveGame>(Path, savegameName, core->GameNameResRef, std::move(slotname), slot.portraits, savegameNumber, time_t(slot.previewTime));
+}
 
-	return MakeHolder<SaveGame>(Path, savegameName, core->GameNameResRef, std::move(slotname), prtrt, savegameNumber);
+void SaveGameIterator::InvalidateSlot(const std::string& slotname) const
+{
+	if (!index) return;
+	index->Invalidate(slotname);
+	index->InvalidateListing();
+	index->Store();
 }
 
 void SaveGameIterator::PruneQuickSave(StringView folder) const
@@ -380,6 +474,7 @@ void SaveGameIterator::PruneQuickSave(StringView folder) const
 	if (hole < size) {
 		//prune second path
 		std::string from = FormatQuickSavePath(myslots[hole]);
+		InvalidateSlot(fmt::format("{:09d}-{}", myslots[hole], folder));
 		myslots.erase(myslots.begin() + hole);
 		DelTree(from, false);
 		rmdir(from.c_str());
@@ -389,6 +484,8 @@ void SaveGameIterator::PruneQuickSave(StringView folder) const
 	for (size_t i = size; i > 0; i--) {
 		std::string from = FormatQuickSavePath(myslots[i]);
 		std::string to = FormatQuickSavePath(myslots[i] + 1);
+		InvalidateSlot(fmt::format("{:09d}-{}", myslots[i], folder));
+		InvalidateSlot(fmt::format("{:09d}-{}", myslots[i] + 1, folder));
 		int errnum = rename(from.c_str(), to.c_str());
 		if (errnum) {
 			error("SaveGameIterator", "Rename error {} when pruning quicksaves!", errnum);
@@ -618,6 +715,7 @@ int SaveGameIterator::CreateSaveGame(int index, bool mqs) const
 		DeleteSaveGame(save);
 		break;
 	}
+	InvalidateSlot(fmt::format("{:09d}-{}", index, slotname));
 	path_t Path;
 	if (!CreateSavePath(Path, index, slotname)) {
 		displaymsg->DisplayMsgCentered(HCStrings::CantSave, FT_ANY, GUIColors::XPCHANGE);
@@ -697,6 +795,7 @@ int SaveGameIterator::CreateSaveGame(Holder<SaveGame> save, StringView slotname,
 		}
 	}
 
+	InvalidateSlot(fmt::format("{:09d}-{}", index, slotname));
 	path_t Path;
 	if (!CreateSavePath(Path, index, slotname)) {
 		displaymsg->DisplayMsgCentered(HCStrings::CantSave, FT_ANY, GUIColors::XPCHANGE);
@@ -721,6 +820,8 @@ void SaveGameIterator::DeleteSaveGame(const Holder<SaveGame>& game) const
 
 	DelTree(game->GetPath(), false); // remove all files from folder
 	RemoveDirectory(game->GetPath());
+	previews.Forget(game.get());
+	InvalidateSlot(game->GetSlotName());
 }
 
 }
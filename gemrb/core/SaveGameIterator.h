@@ -24,7 +24,11 @@
 #include "exports.h"
 
 #include "SaveGame.h"
+#include "SaveGameIndex.h"
+#include "SaveGamePreviews.h"
 
+#include <map>
+#include <memory>
 #include <vector>
 
 namespace GemRB {
@@ -35,21 +39,30 @@ class GEM_EXPORT SaveGameIterator {
 private:
 	using charlist = std::vector<Holder<SaveGame>>;
 	charlist save_slots;
+	// kept between scans, so unchanged slots aren't checked and built again
+	std::unique_ptr<SaveGameIndex> index;
+	std::map<std::string, Holder<SaveGame>> builtSaves;
+	mutable SaveGamePreviews previews;
 
 public:
 	SaveGameIterator() noexcept = default;
-	~SaveGameIterator() noexcept = default;
+	~SaveGameIterator() noexcept;
 	const charlist& GetSaveGames();
 	void DeleteSaveGame(const Holder<SaveGame>&) const;
 	int CreateSaveGame(Holder<SaveGame> save, const String& slotname, bool force = false) const;
 	int CreateSaveGame(Holder<SaveGame>, StringView slotname, bool force = false) const;
 	int CreateSaveGame(int index, bool mqs = false) const;
 	Holder<SaveGame> GetSaveGame(const String& slotname);
+	// these also start decoding the images of the saves around it in the list
+	Holder<Sprite2D> GetPreview(const Holder<SaveGame>& save) const;
+	Holder<Sprite2D> GetPortrait(const Holder<SaveGame>& save, int idx) const;
 
 private:
 	bool RescanSaveGames();
-	static Holder<SaveGame> BuildSaveGame(std::string slotname);
+	static Holder<SaveGame> BuildSaveGame(std::string slotname, const SaveGameIndex::Slot& slot);
+	static SaveGameIndex::Slot CheckSlot(const path_t& path, const std::string& slotname, int64_t dirTime);
 	void PruneQuickSave(StringView folder) const;
+	void InvalidateSlot(const std::string& slotname) const;
 };
 
 }
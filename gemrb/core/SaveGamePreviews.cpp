@@ -0,0 +1,188 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "SaveGamePreviews.h"
+
+#include <algorithm>
+
+namespace GemRB {
+
+SaveGamePreviews::~SaveGamePreviews()
+{
+	Stop();
+}
+
+void SaveGamePreviews::Stop()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+		queue.clear();
+	}
+	wakeUp.notify_one();
+	if (worker.joinable()) {
+		worker.join();
+	}
+}
+
+void SaveGamePreviews::Decode(Images& images)
+{
+	images.preview = images.save->GetPreview();
+	int count = images.save->GetPortraitCount();
+	images.portraits.resize(std::max(count, 0));
+	for (int i = 0; i < count; ++i) {
+		images.portraits[i] = images.save->GetPortrait(i);
+	}
+}
+
+SaveGamePreviews::ImagesPtr SaveGamePreviews::Enqueue(const Holder<SaveGame>& save, bool front)
+{
+	const SaveGame* key = save.get();
+	auto it = cache.find(key);
+	if (it != cache.end()) {
+		lru.remove(key);
+		lru.push_back(key);
+		return it->second;
+	}
+
+	auto images = std::make_shared<Images>();
+	images->save = save;
+	cache.emplace(key, images);
+	lru.push_back(key);
+	if (front) {
+		queue.push_front(images);
+	} else {
+		queue.push_back(images);
+	}
+	return images;
+}
+
+void SaveGamePreviews::Evict()
+{
+	while (cache.size() > MAX_CACHED && !lru.empty()) {
+		const SaveGame* key = lru.front();
+		lru.pop_front();
+		auto it = cache.find(key);
+		// a queued one just won't be decoded; a busy one is dropped by the worker
+		auto queued = std::find(queue.begin(), queue.end(), it->second);
+		if (queued != queue.end()) {
+			queue.erase(queued);
+		}
+		cache.erase(it);
+	}
+}
+
+SaveGamePreviews::ImagesPtr SaveGamePreviews::Fetch(const SaveList& saves, const Holder<SaveGame>& save)
+{
+	std::unique_lock<std::mutex> guard(lock);
+
+	auto pos = std::find(saves.begin(), saves.end(), save);
+	if (pos != saves.end() && !stopping) {
+		size_t idx = pos - saves.begin();
+		size_t first = idx > RADIUS ? idx - RADIUS : 0;
+		size_t last = std::min(idx + RADIUS, saves.size() - 1);
+		for (size_t i = first; i <= last; ++i) {
+			if (i != idx) Enqueue(saves[i], false);
+		}
+		if (!worker.joinable()) {
+			worker = std::thread(&SaveGamePreviews::Run, this);
+		}
+	}
+
+	// last, so it is the most recently used one
+	ImagesPtr images = Enqueue(save, true);
+	Evict();
+
+	if (!images->ready && !images->decoding) {
+		// no point in waiting for the worker to get to it
+		auto queued = std::find(queue.begin(), queue.end(), images);
+		if (queued != queue.end()) {
+			queue.erase(queued);
+		}
+		images->decoding = true;
+		guard.unlock();
+		Decode(*images);
+		guard.lock();
+		images->decoding = false;
+		images->ready = true;
+	}
+	decoded.wait(guard, [&images]() { return images->ready; });
+	guard.unlock();
+
+	wakeUp.notify_one();
+	return images;
+}
+
+Holder<Sprite2D> SaveGamePreviews::GetPreview(const SaveList& saves, const Holder<SaveGame>& save)
+{
+	if (!save) return nullptr;
+	return Fetch(saves, save)->preview;
+}
+
+Holder<Sprite2D> SaveGamePreviews::GetPortrait(const SaveList& saves, const Holder<SaveGame>& save, int index)
+{
+	if (!save) return nullptr;
+
+	ImagesPtr images = Fetch(saves, save);
+	if (index < 0 || size_t(index) >= images->portraits.size()) {
+		return nullptr;
+	}
+	return images->portraits[index];
+}
+
+void SaveGamePreviews::Forget(const SaveGame* save)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	auto it = cache.find(save);
+	if (it == cache.end()) return;
+
+	auto queued = std::find(queue.begin(), queue.end(), it->second);
+	if (queued != queue.end()) {
+		queue.erase(queued);
+	}
+	lru.remove(save);
+	cache.erase(it);
+}
+
+void SaveGamePreviews::Run()
+{
+	while (true) {
+		ImagesPtr images;
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wakeUp.wait(guard, [this]() { return stopping || !queue.empty(); });
+			if (stopping) return;
+			images = queue.front();
+			queue.pop_front();
+			images->decoding = true;
+		}
+
+		Decode(*images);
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			images->decoding = false;
+			images->ready = true;
+		}
+		decoded.notify_all();
+	}
+}
+
+}
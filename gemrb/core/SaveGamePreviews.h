@@ -0,0 +1,94 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef SAVEGAMEPREVIEWS_H
+#define SAVEGAMEPREVIEWS_H
+
+#include "exports.h"
+
+#include "SaveGame.h"
+#include "Sprite2D.h"
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace GemRB {
+
+// The load and save screens ask for the preview and portraits of one save
+// after the other as their lists scroll, so whenever a save is asked for, the
+// ones around it in the list get decoded on a background thread. Only the
+// images of the recently asked saves are kept.
+class GEM_EXPORT SaveGamePreviews {
+public:
+	using SaveList = std::vector<Holder<SaveGame>>;
+
+	SaveGamePreviews() noexcept = default;
+	SaveGamePreviews(const SaveGamePreviews&) = delete;
+	~SaveGamePreviews();
+	SaveGamePreviews& operator=(const SaveGamePreviews&) = delete;
+
+	Holder<Sprite2D> GetPreview(const SaveList& saves, const Holder<SaveGame>& save);
+	Holder<Sprite2D> GetPortrait(const SaveList& saves, const Holder<SaveGame>& save, int index);
+	// drops the images of this save, for when it gets deleted or replaced
+	void Forget(const SaveGame* save);
+	void Stop();
+
+private:
+	// how many saves to each side of the asked one get decoded
+	static constexpr size_t RADIUS = 6;
+	static constexpr size_t MAX_CACHED = 4 * RADIUS;
+
+	struct Images {
+		Holder<SaveGame> save;
+		Holder<Sprite2D> preview;
+		std::vector<Holder<Sprite2D>> portraits;
+		bool ready = false;
+		bool decoding = false;
+	};
+	using ImagesPtr = std::shared_ptr<Images>;
+
+	std::mutex lock;
+	std::condition_variable wakeUp;
+	std::condition_variable decoded;
+	std::unordered_map<const SaveGame*, ImagesPtr> cache;
+	std::list<const SaveGame*> lru; // the front is the least recently used
+	std::deque<ImagesPtr> queue;
+	std::thread worker;
+	bool stopping = false;
+
+	// returns the decoded images of the save, after queueing its neighbours
+	ImagesPtr Fetch(const SaveList& saves, const Holder<SaveGame>& save);
+	// these expect the lock to be held
+	ImagesPtr Enqueue(const Holder<SaveGame>& save, bool front);
+	void Evict();
+
+	static void Decode(Images& images);
+	void Run();
+};
+
+}
+
+#endif
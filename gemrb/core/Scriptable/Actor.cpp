@@ -46,6 +46,7 @@
 #include "ScriptedAnimation.h"
 #include "Spell.h"
 #include "Sprite2D.h"
+#include "StatCache.h"
 #include "StringMgr.h"
 #include "TableMgr.h"
 #include "damages.h"
@@ -582,6 +583,8 @@ void Actor::SetCircleSize()
 	int csize = Clamp(anims->GetCircleSize(), 1, MAX_CIRCLE_SIZE) - 1;
 	int selectedIdx = (normalIdx == 0) ? 3 : normalIdx;
 	SetCircle(anims->GetCircleSize(), oscillationFactor, color, core->GroundCircles[csize][normalIdx], core->GroundCircles[csize][selectedIdx]);
+	// a bigger circle reaches further, so the area needs to know
+	if (area) area->ActorMoved(this);
 }
 
 Color Actor::GetCircleColor()
@@ -2532,6 +2535,9 @@ bool Actor::SetStat(unsigned int StatIndex, stat_t Value, int pcf)
 		return false;
 	}
 	Value = ClampStat(StatIndex, Value);
+	if (StatWrites) {
+		StatWrites->set(StatIndex);
+	}
 
 	unsigned int previous = GetSafeStat(StatIndex);
 	if (Modified[StatIndex] != Value) {
@@ -2548,6 +2554,11 @@ bool Actor::SetStat(unsigned int StatIndex, stat_t Value, int pcf)
 	return true;
 }
 
+bool Actor::HasPostChangeFunction(unsigned int StatIndex)
+{
+	return StatIndex < MAX_STATS && post_change_functions[StatIndex];
+}
+
 /** Returns a Stat Base Value */
 ieDword Actor::GetBase(unsigned int StatIndex) const
 {
@@ -2754,7 +2765,14 @@ void Actor::RefreshEffects(bool first, const stats_t& previous)
 		}
 	}
 
-	fxqueue.ApplyAllEffects(this);
+	if (core->config.IncrementalEffects) {
+		if (!statCache) {
+			statCache = std::make_unique<StatCache>();
+		}
+		statCache->Apply(this, core->config.VerifyIncrementalEffects);
+	} else {
+		fxqueue.ApplyAllEffects(this);
+	}
 
 	const Game* game = core->GetGame();
 	if (previous[IE_PUPPETID]) {
@@ -4614,6 +4632,23 @@ hitsound:
 	PlayHitSound(resdata, damagetype, false);
 }
 
+// walk sounds come in variants, told apart by a suffix
+static ResRef WalkSoundVariant(const ResRef& base, int variant)
+{
+	ResRef sound = base;
+	char suffix = 0;
+	/* IWD1, HOW, IWD2 sometimes append numbers here, not letters. */
+	if (core->HasFeature(GFFlags::SOUNDFOLDERS) && base.BeginsWith("FS_")) {
+		suffix = char(variant + 0x31);
+	} else if (variant) {
+		suffix = char(variant + 0x60); // 'a'-'g'
+	}
+	if (base.length() < 8 && suffix != 0) {
+		sound.Format("{:.8}{}", base, suffix);
+	}
+	return sound;
+}
+
 void Actor::PlayWalkSound()
 {
 	tick_t thisTime = GetMilliseconds();
@@ -4627,18 +4662,7 @@ void Actor::PlayWalkSound()
 	if (Sound.IsEmpty()) Sound = walkSound;
 	if (Sound.IsEmpty() || IsStar(Sound)) return;
 
-	ResRef soundBase = Sound;
-	char suffix = 0;
-	uint8_t l = Sound.length();
-	/* IWD1, HOW, IWD2 sometimes append numbers here, not letters. */
-	if (core->HasFeature(GFFlags::SOUNDFOLDERS) && Sound.BeginsWith("FS_")) {
-		suffix = char(chosenWalkSnd + 0x31);
-	} else if (chosenWalkSnd) {
-		suffix = char(chosenWalkSnd + 0x60); // 'a'-'g'
-	}
-	if (l < 8 && suffix != 0) {
-		Sound.Format("{:.8}{}", soundBase, suffix);
-	}
+	Sound = WalkSoundVariant(Sound, chosenWalkSnd);
 
 	tick_t len = 0;
 	SFXChannel channel = InParty ? SFXChannel::WalkChar : SFXChannel::WalkMonster;
@@ -4646,6 +4670,22 @@ void Actor::PlayWalkSound()
 	Timers.nextWalkSound = ieDword(thisTime + len);
 }
 
+void Actor::ListWalkSounds(std::vector<ResRef>& sounds) const
+{
+	if (!anims || !area) return;
+	int count = anims->GetWalkSoundCount();
+	if (!count) return;
+
+	ResRef walkSound = anims->GetWalkSound();
+	ResRef base = area->ResolveTerrainSound(walkSound, Pos);
+	if (base.IsEmpty()) base = walkSound;
+	if (base.IsEmpty() || IsStar(base)) return;
+
+	for (int variant = 0; variant < count; ++variant) {
+		sounds.push_back(WalkSoundVariant(base, variant));
+	}
+}
+
 // damage types in weapon headers:
 // 0 none
 // 1 DAMAGE_PIERCING
@@ -4959,6 +4999,9 @@ std::string Actor::dump() const
 	AppendFormat(buffer, "Visualrange:{} (Explorer: {})\n", Modified[IE_VISUALRANGE], Modified[IE_EXPLORE]);
 	AppendFormat(buffer, "Fatigue: {} (current: {})   Luck: {}\n", BaseStats[IE_FATIGUE], Modified[IE_FATIGUE], Modified[IE_LUCK]);
 	AppendFormat(buffer, "Movement rate: {} (current: {})\n\n", BaseStats[IE_MOVEMENTRATE], Modified[IE_MOVEMENTRATE]);
+	if (statCache) {
+		AppendFormat(buffer, "Effect refreshes: {} effects applied, {} skipped\n\n", statCache->GetApplied(), statCache->GetSkipped());
+	}
 
 	//this works for both level slot style
 	AppendFormat(buffer, "Levels (average: {}):\n", GetXPLevel(true));
@@ -5416,6 +5459,7 @@ void Actor::Resurrect(const Point& destPoint)
 
 		if (value > 0) {
 			game->kaputz[DeathVar] = value - 1;
+			Game::VariablesChanged();
 		}
 		// not bothering with checking actor->SetDeathVar, since the SetAt nocreate parameter is true
 	} else if (!core->HasFeature(GFFlags::HAS_KAPUTZ)) {
@@ -5426,6 +5470,7 @@ void Actor::Resurrect(const Point& destPoint)
 		auto lookup = game->locals.find(DeathVar);
 		if (lookup != game->locals.cend()) {
 			lookup->second = 0;
+			Game::VariablesChanged();
 		}
 	}
 
@@ -5494,6 +5539,7 @@ static void UpdateOrCreateVariable(ieVarsMap& vars, const ieVariable& key, ieDwo
 	} else if (!nocreate) {
 		vars[key] = value;
 	}
+	Game::VariablesChanged();
 }
 
 static void IncrementOrCreateVariable(ieVarsMap& vars, const ieVariable& key, ieDword value)
@@ -5504,6 +5550,7 @@ static void IncrementOrCreateVariable(ieVarsMap& vars, const ieVariable& key, ie
 	} else if (!nocreate) {
 		vars[key] = value;
 	}
+	Game::VariablesChanged();
 }
 
 bool Actor::ProcessKillXP(const Actor* killerActor, bool grantXP)
@@ -12175,7 +12222,8 @@ void Actor::PlayArmorSound() const
 
 	const ResRef armorSound = GetArmorSound();
 	if (!armorSound.IsEmpty()) {
-		core->GetAudioDrv()->Play(armorSound, SFXChannel::Armor, Pos, GEM_SND_SPATIAL);
+		// it just accompanies the movement, so don't hold up the tick for the decoding
+		core->GetAudioDrv()->PlayAsync(armorSound, SFXChannel::Armor, Pos, GEM_SND_SPATIAL);
 	}
 }
 
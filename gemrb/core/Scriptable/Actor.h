@@ -42,6 +42,7 @@
 #include "Video/Video.h"
 
 #include <array>
+#include <bitset>
 #include <map>
 #include <set>
 #include <vector>
@@ -54,6 +55,7 @@ class CharAnimations;
 class DataFileMgr;
 class Map;
 class ScriptedAnimation;
+class StatCache;
 class ToHitStats;
 struct PolymorphCache;
 
@@ -462,6 +464,8 @@ public:
 	stats_t BaseStats {};
 	stats_t Modified {};
 	stat_t* PrevStats = nullptr;
+	// set by StatCache while it wants to know which stats an effect writes
+	std::bitset<MAX_STATS>* StatWrites = nullptr;
 	ieByteSigned DeathCounters[4] {}; // PST specific (good, law, lady, murder)
 
 	ResRef BardSong; //custom bard song (updated by fx)
@@ -514,6 +518,8 @@ public:
 	bool Spawned = false; // has been created by a spawn point
 
 	EffectQueue fxqueue;
+	// only used with the IncrementalEffects option
+	std::unique_ptr<StatCache> statCache;
 
 	vvcDict vfxDict;
 	vvcSet vfxQueue = vvcSet(VVCSort); // sorted so we can distinguish effects infront and behind
@@ -665,6 +671,8 @@ public:
 	stat_t GetSafeStat(unsigned int StatIndex) const;
 	/** Sets a Stat Value (unsaved) */
 	bool SetStat(unsigned int StatIndex, stat_t Value, int pcf);
+	/** Returns true if changing the stat has side effects */
+	static bool HasPostChangeFunction(unsigned int StatIndex);
 	/** Returns a Stat Base Value */
 	ieDword GetBase(unsigned int StatIndex) const;
 	/** Sets a Base Stat Value */
@@ -784,6 +792,8 @@ public:
 	void DisplayCombatFeedback(unsigned int damage, int resisted, int damagetype, const Scriptable* hitter);
 	/* play a random footstep sound */
 	void PlayWalkSound();
+	/* collects the walk sounds it would use at its current position */
+	void ListWalkSounds(std::vector<ResRef>& sounds) const;
 	/* play the proper hit sound (in pst) */
 	void PlayHitSound(const DataFileMgr* resdata, int damagetype, bool suffix) const;
 	void PlaySwingSound(const WeaponInfo& wi) const;
@@ -74,6 +74,7 @@ void Door::ImpedeBlocks(const std::vector<SearchmapPoint>& points, PathMapFlags
 	for (const SearchmapPoint& point : points) {
 		PathMapFlags tmp = area->tileProps.QuerySearchMap(point) & PathMapFlags::NOTDOOR;
 		area->tileProps.PaintSearchMap(point, tmp | value);
+		area->SearchMapChanged(point);
 	}
 }
 
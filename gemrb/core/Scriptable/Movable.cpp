@@ -402,10 +402,8 @@ void Movable::DoStep(unsigned int walkScale, ieDword time)
 		}
 	}
 	
-	Pos.x += dx;
-	Pos.y += dy;
+	SetPos(Point(Pos.x + dx, Pos.y + dy));
 	oldPos = Pos;
-	SMPos = SearchmapPoint(Pos);
 	if (actor && blocksSearch) {
 		auto flag = actor->IsPartyMember() ? PathMapFlags::PC : PathMapFlags::NPC;
 		area->tileProps.PaintSearchMap(SMPos, circleSize, flag);
@@ -149,6 +149,19 @@ void Scriptable::SetMap(Map* map)
 		error("Scriptable", "Invalid map set!");
 	}
 	area = map;
+	// the actor may have been moved while it was not attached yet
+	if (Type == ST_ACTOR && area) {
+		area->ActorMoved(static_cast<Actor*>(this));
+	}
+}
+
+void Scriptable::SetPos(const NavmapPoint& pos)
+{
+	Pos = pos;
+	SMPos = SearchmapPoint(pos);
+	if (Type == ST_ACTOR && area) {
+		area->ActorMoved(static_cast<Actor*>(this));
+	}
 }
 
 //ai is nonzero if this is an actor currently in the party
@@ -424,11 +424,7 @@ public:
 	ieDword GetLocal(const ieVariable& key, ieDword fallback) const;
 	int DecreaseActionState();
 	virtual std::string dump() const = 0;
-	void SetPos(const NavmapPoint& pos)
-	{
-		Pos = pos;
-		SMPos = SearchmapPoint(pos);
-	};
+	void SetPos(const NavmapPoint& pos);
 
 private:
 	/* used internally to handle start of spellcasting */
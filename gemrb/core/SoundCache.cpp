@@ -0,0 +1,289 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "SoundCache.h"
+
+#include "GameData.h"
+#include "SoundMgr.h"
+
+#include "Logging/Logging.h"
+
+#include <algorithm>
+
+namespace GemRB {
+
+SoundCache::SoundCache(size_t budget, unsigned int workerCount)
+	: budget(budget), workerCount(std::max(workerCount, 1U))
+{
+}
+
+SoundCache::~SoundCache()
+{
+	Stop();
+}
+
+void SoundCache::Stop()
+{
+	std::deque<std::shared_ptr<Job>> abandoned;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+		abandoned.swap(queue);
+	}
+	wakeUp.notify_all();
+	for (auto& worker : workers) {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+	workers.clear();
+
+	// don't leave anyone waiting for them
+	for (const auto& job : abandoned) {
+		job->promise.set_value(nullptr);
+	}
+}
+
+std::string SoundCache::MakeKey(StringView resRef)
+{
+	std::string key(resRef.c_str(), resRef.length());
+	StringToLower(key);
+	return key;
+}
+
+SoundCache::Sound SoundCache::Decode(const std::string& resRef, bool silent)
+{
+	ResourceHolder<SoundMgr> acm = gamedata->GetResourceHolder<SoundMgr>(resRef, silent);
+	if (!acm) {
+		return nullptr;
+	}
+
+	int channels = acm->get_channels();
+	int samplerate = acm->get_samplerate();
+	int numSamples = acm->get_length();
+	if (channels <= 0 || samplerate <= 0 || numSamples < 0) {
+		Log(ERROR, "SoundCache", "Invalid sound format in {}!", resRef);
+		return nullptr;
+	}
+
+	auto sound = std::make_shared<DecodedSound>();
+	sound->channels = channels;
+	sound->samplerate = samplerate;
+	sound->samples.resize(numSamples);
+	int read = acm->read_samples(sound->samples.data(), numSamples);
+	sound->samples.resize(std::max(read, 0));
+	sound->samples.shrink_to_fit();
+	// the length is what the header claims, like the drivers always did
+	sound->length = ((numSamples / channels) * 1000) / samplerate;
+	return sound;
+}
+
+SoundCache::Future SoundCache::Request(StringView resRef, bool urgent)
+{
+	std::string key = MakeKey(resRef);
+	std::shared_ptr<Job> job;
+	Future future;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		auto it = entries.find(key);
+		if (it != entries.end()) {
+			Touch(it->second);
+			if (urgent) {
+				auto queued = Unqueue(key);
+				if (queued) queue.push_front(std::move(queued));
+			}
+			return it->second.future;
+		}
+
+		job = std::make_shared<Job>();
+		job->key = key;
+		job->id = ++nextID;
+		future = Insert(key, job).future;
+
+		if (!stopping) {
+			if (urgent) {
+				queue.push_front(job);
+			} else {
+				queue.push_back(job);
+			}
+			// the workers are only started once there's something to do
+			if (workers.size() < workerCount) {
+				workers.emplace_back(&SoundCache::Run, this);
+			}
+			job = nullptr;
+		}
+	}
+
+	if (job) {
+		Finish(job, Decode(key, false));
+	} else {
+		wakeUp.notify_one();
+	}
+	return future;
+}
+
+SoundCache::Sound SoundCache::Get(StringView resRef)
+{
+	std::string key = MakeKey(resRef);
+	std::shared_ptr<Job> job;
+	Future future;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		auto it = entries.find(key);
+		if (it != entries.end()) {
+			Entry& entry = it->second;
+			Touch(entry);
+			future = entry.future;
+			if (entry.ready) {
+				++hits;
+			} else {
+				++misses;
+				// waiting for the workers to get to it would only be slower
+				job = Unqueue(key);
+			}
+		} else {
+			++misses;
+			job = std::make_shared<Job>();
+			job->key = key;
+			job->id = ++nextID;
+			future = Insert(key, job).future;
+		}
+	}
+
+	if (job) {
+		Finish(job, Decode(key, false));
+	}
+	return future.get();
+}
+
+void SoundCache::Preload(const std::vector<ResRef>& resRefs)
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (stopping) return;
+	}
+
+	for (const auto& resRef : resRefs) {
+		if (resRef.IsEmpty() || IsStar(resRef)) continue;
+		Request(resRef, false);
+	}
+}
+
+void SoundCache::Clear()
+{
+	std::deque<std::shared_ptr<Job>> abandoned;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		abandoned.swap(queue);
+		entries.clear();
+		lru.clear();
+		used = 0;
+	}
+
+	for (const auto& job : abandoned) {
+		job->promise.set_value(nullptr);
+	}
+}
+
+size_t SoundCache::GetSize() const
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return used;
+}
+
+SoundCache::Entry& SoundCache::Insert(const std::string& key, const std::shared_ptr<Job>& job)
+{
+	Entry& entry = entries[key];
+	entry.future = job->promise.get_future().share();
+	entry.id = job->id;
+	entry.lru = lru.insert(lru.end(), key);
+	Evict();
+	return entry;
+}
+
+void SoundCache::Touch(Entry& entry)
+{
+	lru.splice(lru.end(), lru, entry.lru);
+}
+
+void SoundCache::Evict()
+{
+	auto it = lru.begin();
+	while ((used > budget || entries.size() > MAX_ENTRIES) && it != lru.end()) {
+		auto found = entries.find(*it);
+		// the size of pending sounds isn't known yet, so leave them be
+		if (!found->second.ready) {
+			++it;
+			continue;
+		}
+
+		// anyone still playing it keeps their own reference
+		used -= found->second.size;
+		entries.erase(found);
+		it = lru.erase(it);
+		++evictions;
+	}
+}
+
+std::shared_ptr<SoundCache::Job> SoundCache::Unqueue(const std::string& key)
+{
+	auto it = std::find_if(queue.begin(), queue.end(), [&key](const std::shared_ptr<Job>& job) {
+		return job->key == key;
+	});
+	if (it == queue.end()) return nullptr;
+
+	auto job = *it;
+	queue.erase(it);
+	return job;
+}
+
+void SoundCache::Finish(const std::shared_ptr<Job>& job, const Sound& sound)
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		auto it = entries.find(job->key);
+		// it could have been cleared and requested again meanwhile
+		if (it != entries.end() && it->second.id == job->id) {
+			it->second.ready = true;
+			it->second.size = sound ? sound->GetSize() : 0;
+			used += it->second.size;
+			Evict();
+		}
+	}
+	job->promise.set_value(sound);
+}
+
+void SoundCache::Run()
+{
+	while (true) {
+		std::shared_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wakeUp.wait(guard, [this]() { return stopping || !queue.empty(); });
+			if (stopping) return;
+			job = queue.front();
+			queue.pop_front();
+		}
+
+		Finish(job, Decode(job->key, true));
+	}
+}
+
+}
@@ -0,0 +1,138 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef SOUNDCACHE_H
+#define SOUNDCACHE_H
+
+#include "exports.h"
+#include "globals.h"
+
+#include "Resource.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace GemRB {
+
+// a fully decoded sound resource, as the SoundMgr plugins return it
+struct GEM_EXPORT DecodedSound {
+	std::vector<short> samples; // 16 bit, interleaved
+	int channels = 0;
+	int samplerate = 0;
+	tick_t length = 0; // in milliseconds
+
+	size_t GetFrames() const { return channels ? samples.size() / channels : 0; }
+	size_t GetSize() const { return samples.size() * sizeof(short); }
+};
+
+// Decoded sounds shared by the audio drivers, so the decoding doesn't have to
+// be repeated and can happen on a few worker threads instead of in Play. The
+// cache is bounded by the total size of the samples it holds and drops the
+// least recently used sounds first; the drivers only keep their device side
+// buffers for the sounds they have actually played.
+class GEM_EXPORT SoundCache {
+public:
+	using Sound = std::shared_ptr<const DecodedSound>;
+	using Future = std::shared_future<Sound>;
+
+	static constexpr size_t DEFAULT_BUDGET = 64 * 1024 * 1024;
+	static constexpr unsigned int DEFAULT_WORKERS = 2;
+
+	explicit SoundCache(size_t budget = DEFAULT_BUDGET, unsigned int workerCount = DEFAULT_WORKERS);
+	SoundCache(const SoundCache&) = delete;
+	~SoundCache();
+	SoundCache& operator=(const SoundCache&) = delete;
+
+	// queues the sound for decoding, unless it is cached or on its way already
+	// urgent requests jump ahead of the preloads
+	Future Request(StringView resRef, bool urgent = true);
+	// returns the decoded sound or nullptr if it can't be loaded; when the
+	// sound is still queued, it gets decoded on the calling thread instead
+	Sound Get(StringView resRef);
+	// decodes the sounds in the background, behind any urgent requests
+	void Preload(const std::vector<ResRef>& resRefs);
+	void Clear();
+	void Stop();
+
+	size_t GetBudget() const { return budget; }
+	size_t GetSize() const;
+	uint64_t GetHits() const { return hits; }
+	uint64_t GetMisses() const { return misses; }
+	uint64_t GetEvictions() const { return evictions; }
+
+private:
+	// also bounds the failed lookups, which don't count towards the budget
+	static constexpr size_t MAX_ENTRIES = 1024;
+
+	struct Job {
+		std::string key;
+		uint64_t id = 0;
+		std::promise<Sound> promise;
+	};
+
+	struct Entry {
+		Future future;
+		uint64_t id = 0;
+		size_t size = 0;
+		bool ready = false;
+		std::list<std::string>::iterator lru;
+	};
+
+	size_t budget;
+	unsigned int workerCount;
+	mutable std::mutex lock;
+	std::condition_variable wakeUp;
+	std::unordered_map<std::string, Entry> entries;
+	std::list<std::string> lru; // the front is the least recently used
+	std::deque<std::shared_ptr<Job>> queue;
+	std::vector<std::thread> workers;
+	size_t used = 0;
+	uint64_t nextID = 0;
+	bool stopping = false;
+	std::atomic<uint64_t> hits { 0 };
+	std::atomic<uint64_t> misses { 0 };
+	std::atomic<uint64_t> evictions { 0 };
+
+	static std::string MakeKey(StringView resRef);
+	static Sound Decode(const std::string& resRef, bool silent);
+
+	// these expect the lock to be held
+	Entry& Insert(const std::string& key, const std::shared_ptr<Job>& job);
+	void Touch(Entry& entry);
+	void Evict();
+	std::shared_ptr<Job> Unqueue(const std::string& key);
+
+	void Finish(const std::shared_ptr<Job>& job, const Sound& sound);
+	void Run();
+};
+
+}
+
+#endif
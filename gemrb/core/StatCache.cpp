@@ -0,0 +1,204 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "StatCache.h"
+
+#include "EffectQueue.h"
+
+#include "Logging/Logging.h"
+
+namespace GemRB {
+
+// skipping an effect would also skip the post change function calls it triggers
+static bool HasPostChangeWrites(const StatCache::statmask_t& writes)
+{
+	static const StatCache::statmask_t pcfStats = []() {
+		StatCache::statmask_t mask;
+		for (unsigned int stat = 0; stat < MAX_STATS; ++stat) {
+			mask[stat] = Actor::HasPostChangeFunction(stat);
+		}
+		return mask;
+	}();
+	return (writes & pcfStats).any();
+}
+
+StatCache::Record::Record(const Effect& fx)
+	: opcode(fx.Opcode), param1(fx.Parameter1), param2(fx.Parameter2), timing(fx.TimingMode)
+{}
+
+bool StatCache::Record::Matches(const Effect& fx) const
+{
+	return opcode == fx.Opcode && param1 == fx.Parameter1 && param2 == fx.Parameter2 && timing == fx.TimingMode;
+}
+
+void StatCache::Apply(Actor* actor, bool verify)
+{
+	current.clear();
+	bool statOnly = true;
+	auto it = actor->fxqueue.GetFirstEffect();
+	while (Effect* fx = actor->fxqueue.GetNextEffect(it)) {
+		// these are skipped by ApplyEffect anyway
+		if (fx->TimingMode == FX_DURATION_JUST_EXPIRED) continue;
+		if (!EffectQueue::IsStatOnly(*fx)) {
+			statOnly = false;
+			break;
+		}
+		current.push_back(fx);
+	}
+
+	if (!statOnly) {
+		valid = false;
+		applied += actor->fxqueue.GetEffectsCount();
+		actor->fxqueue.ApplyAllEffects(actor);
+		return;
+	}
+
+	if (!valid || !ApplyIncremental(actor)) {
+		ApplyFull(actor);
+		return;
+	}
+
+	if (verify) {
+		Verify(actor);
+	}
+}
+
+void StatCache::Trace(Actor* actor, Effect* fx, statmask_t& writes)
+{
+	writes.reset();
+	actor->StatWrites = &writes;
+	actor->fxqueue.ApplyEffect(actor, fx, 0);
+	actor->StatWrites = nullptr;
+}
+
+// same as EffectQueue::ApplyAllEffects, since the queue only holds stat only
+// effects, but also notes which stats each of them wrote
+void StatCache::ApplyFull(Actor* actor)
+{
+	input = actor->Modified;
+	base = actor->BaseStats;
+	records.clear();
+	valid = true;
+	for (Effect* fx : current) {
+		records.emplace_back(*fx);
+		Trace(actor, fx, records.back().writes);
+		if (HasPostChangeWrites(records.back().writes)) {
+			valid = false;
+		}
+	}
+	applied += current.size();
+	output = actor->Modified;
+}
+
+bool StatCache::ApplyIncremental(Actor* actor)
+{
+	// the unchanged effects at both ends of the queue keep their results
+	size_t prefix = 0;
+	size_t oldCount = records.size();
+	size_t newCount = current.size();
+	while (prefix < oldCount && prefix < newCount && records[prefix].Matches(*current[prefix])) {
+		++prefix;
+	}
+	size_t suffix = 0;
+	while (suffix < oldCount - prefix && suffix < newCount - prefix && records[oldCount - 1 - suffix].Matches(*current[newCount - 1 - suffix])) {
+		++suffix;
+	}
+
+	statmask_t dirty;
+	for (unsigned int stat = 0; stat < MAX_STATS; ++stat) {
+		if (actor->Modified[stat] != input[stat] || actor->BaseStats[stat] != base[stat]) {
+			dirty.set(stat);
+		}
+	}
+	for (size_t i = prefix; i < oldCount - suffix; ++i) {
+		dirty |= records[i].writes;
+	}
+
+	// find out what the new effects write by applying them to scratch stats
+	std::vector<Record> added;
+	stats_t starting = actor->Modified;
+	for (size_t i = prefix; i < newCount - suffix; ++i) {
+		added.emplace_back(*current[i]);
+		Trace(actor, current[i], added.back().writes);
+		actor->Modified = starting;
+		if (HasPostChangeWrites(added.back().writes)) {
+			return false;
+		}
+		dirty |= added.back().writes;
+	}
+
+	if (!added.empty() || oldCount != newCount) {
+		records.erase(records.begin() + prefix, records.begin() + (oldCount - suffix));
+		records.insert(records.begin() + prefix, added.begin(), added.end());
+	}
+
+	// effects writing any of the dirty stats need a replay, which makes the rest of their stats dirty too
+	std::vector<bool> replay(newCount, false);
+	bool grown = true;
+	while (grown) {
+		grown = false;
+		for (size_t i = 0; i < newCount; ++i) {
+			if (replay[i] || !(records[i].writes & dirty).any()) continue;
+			replay[i] = true;
+			dirty |= records[i].writes;
+			grown = true;
+		}
+	}
+
+	input = actor->Modified;
+	base = actor->BaseStats;
+	for (unsigned int stat = 0; stat < MAX_STATS; ++stat) {
+		if (!dirty[stat]) {
+			actor->Modified[stat] = output[stat];
+		}
+	}
+	for (size_t i = 0; i < newCount; ++i) {
+		if (replay[i]) {
+			Trace(actor, current[i], records[i].writes);
+			++applied;
+		} else {
+			++skipped;
+		}
+	}
+	output = actor->Modified;
+	return true;
+}
+
+void StatCache::Verify(Actor* actor)
+{
+	stats_t incremental = actor->Modified;
+	actor->Modified = input;
+	actor->fxqueue.ApplyAllEffects(actor);
+
+	for (unsigned int stat = 0; stat < MAX_STATS; ++stat) {
+		if (incremental[stat] == actor->Modified[stat]) continue;
+
+		std::string opcodes;
+		for (const Record& record : records) {
+			if (record.writes[stat]) {
+				AppendFormat(opcodes, " {}", record.opcode);
+			}
+		}
+		error("StatCache", "Incremental refresh of {} differs in stat {}: {} instead of {}, written by opcodes:{}",
+		      fmt::WideToChar { actor->GetName() }, stat, incremental[stat], actor->Modified[stat], opcodes);
+	}
+}
+
+}
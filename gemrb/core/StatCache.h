@@ -0,0 +1,86 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef STATCACHE_H
+#define STATCACHE_H
+
+#include "exports.h"
+
+#include "Scriptable/Actor.h"
+
+#include <bitset>
+#include <vector>
+
+namespace GemRB {
+
+// Remembers what an actor's effects did to its stats during the last refresh,
+// together with the stats each of them wrote, so the next refresh only has to
+// replay the effects touching stats that could have changed: stats whose
+// starting values differ and stats written by added or removed effects.
+// This only works while every queued effect belongs to an EFFECT_STAT_ONLY
+// opcode and no written stat has a post change function, otherwise the whole
+// queue gets applied like before.
+class GEM_EXPORT StatCache {
+public:
+	using stats_t = Actor::stats_t;
+	using statmask_t = std::bitset<MAX_STATS>;
+
+	// replaces EffectQueue::ApplyAllEffects in Actor::RefreshEffects
+	// with verify set, the full queue is also applied and the results compared
+	void Apply(Actor* actor, bool verify);
+
+	// how many effects had to be applied and how many could be skipped
+	uint64_t GetApplied() const { return applied; }
+	uint64_t GetSkipped() const { return skipped; }
+
+private:
+	struct Record {
+		// the fields the stat only opcodes depend on
+		ieDword opcode = 0;
+		ieDword param1 = 0;
+		ieDword param2 = 0;
+		ieWord timing = 0;
+		statmask_t writes;
+
+		explicit Record(const Effect& fx);
+		bool Matches(const Effect& fx) const;
+	};
+
+	std::vector<Record> records;
+	stats_t input {};
+	stats_t base {};
+	stats_t output {};
+	bool valid = false;
+
+	uint64_t applied = 0;
+	uint64_t skipped = 0;
+
+	// reused between calls
+	std::vector<Effect*> current;
+
+	void ApplyFull(Actor* actor);
+	bool ApplyIncremental(Actor* actor);
+	void Trace(Actor* actor, Effect* fx, statmask_t& writes);
+	void Verify(Actor* actor);
+};
+
+}
+
+#endif
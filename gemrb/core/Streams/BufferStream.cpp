@@ -0,0 +1,76 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "BufferStream.h"
+
+#include "errors.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace GemRB {
+
+BufferStream::BufferStream(std::vector<char>& buffer)
+	: buffer(buffer)
+{
+	size = buffer.size();
+}
+
+strret_t BufferStream::Read(void* dest, strpos_t len)
+{
+	if (Pos + len > size) {
+		return Error;
+	}
+	memcpy(dest, buffer.data() + Pos, len);
+	Pos += len;
+	return len;
+}
+
+strret_t BufferStream::Write(const void* src, strpos_t len)
+{
+	if (Pos + len > buffer.size()) {
+		buffer.resize(Pos + len);
+	}
+	memcpy(buffer.data() + Pos, src, len);
+	Pos += len;
+	size = std::max(size, Pos);
+	return len;
+}
+
+stroff_t BufferStream::Seek(stroff_t pos, strpos_t startpos)
+{
+	switch (startpos) {
+		case GEM_CURRENT_POS:
+			pos += Pos;
+			break;
+		case GEM_STREAM_END:
+			pos += size;
+			break;
+		default:
+			break;
+	}
+	if (pos < 0 || strpos_t(pos) > size) {
+		return InvalidPos;
+	}
+	Pos = pos;
+	return GEM_OK;
+}
+
+}
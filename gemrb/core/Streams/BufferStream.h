@@ -0,0 +1,48 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef BUFFERSTREAM_H
+#define BUFFERSTREAM_H
+
+#include "exports.h"
+
+#include "DataStream.h"
+
+#include <vector>
+
+namespace GemRB {
+
+// Stream over a caller owned buffer that grows as it is written to, for
+// (de)compressing into memory, so it can be done off the main thread.
+class GEM_EXPORT BufferStream final : public DataStream {
+private:
+	std::vector<char>& buffer;
+
+public:
+	explicit BufferStream(std::vector<char>& buffer);
+
+	strret_t Read(void* dest, strpos_t len) override;
+	strret_t Write(const void* src, strpos_t len) override;
+	stroff_t Seek(stroff_t pos, strpos_t startpos) override;
+};
+
+}
+
+#endif
@@ -22,6 +22,8 @@
 #include "Interface.h"
 #include "PluginMgr.h"
 
+#include "MurmurHash.h"
+
 #include "Logging/Logging.h"
 #include "Streams/FileStream.h"
 #if defined(SUPPORTS_MEMSTREAM)
@@ -29,6 +31,10 @@
 #endif
 #include "System/VFS.h"
 
+#include <cinttypes>
+#include <cstdio>
+#include <vector>
+
 namespace GemRB {
 
 DataStream* CacheCompressedStream(DataStream* stream, const path_t& filename, int length, bool overwrite)
@@ -56,4 +62,100 @@ DataStream* CacheCompressedStream(DataStream* stream, const path_t& filename, in
 #endif
 }
 
+struct CacheSource {
+	uint64_t size = 0;
+	int64_t mtime = 0;
+	uint32_t hash = 0;
+};
+
+static path_t CacheSourcePath(const path_t& cachedPath)
+{
+	return cachedPath + ".src";
+}
+
+static uint32_t HashFile(const path_t& path)
+{
+	FileStream* file = FileStream::OpenFile(path);
+	if (!file) {
+		return 0;
+	}
+
+	MurmurHash3_32 hasher;
+	std::vector<uint32_t> buffer(16384);
+	strpos_t remains = file->Size();
+	while (remains) {
+		strpos_t len = std::min<strpos_t>(remains, buffer.size() * sizeof(uint32_t));
+		buffer[(len - 1) / sizeof(uint32_t)] = 0; // pad the tail
+		if (file->Read(buffer.data(), len) != strret_t(len)) {
+			break;
+		}
+		for (size_t i = 0; i < (len + sizeof(uint32_t) - 1) / sizeof(uint32_t); ++i) {
+			hasher.Feed(buffer[i]);
+		}
+		remains -= len;
+	}
+	delete file;
+
+	return hasher.GetHash().value;
+}
+
+static bool ReadCacheSource(const path_t& cachedPath, CacheSource& source)
+{
+	FileStream* file = FileStream::OpenFile(CacheSourcePath(cachedPath));
+	if (!file) {
+		return false;
+	}
+
+	char line[64] {};
+	file->Read(line, std::min<strpos_t>(file->Size(), sizeof(line) - 1));
+	delete file;
+
+	return sscanf(line, "%" SCNu64 " %" SCNd64 " %" SCNu32, &source.size, &source.mtime, &source.hash) == 3;
+}
+
+static void WriteCacheSource(const path_t& cachedPath, const CacheSource& source)
+{
+	FileStream out;
+	if (!out.Create(CacheSourcePath(cachedPath))) {
+		Log(WARNING, "FileCache", "Cannot write {}.", CacheSourcePath(cachedPath));
+		return;
+	}
+	std::string line = fmt::format("{} {} {}\n", source.size, source.mtime, source.hash);
+	out.Write(line.c_str(), line.length());
+}
+
+bool CacheEntryIsFresh(const path_t& cachedPath, const path_t& sourcePath)
+{
+	CacheSource recorded;
+	if (!FileExists(cachedPath) || !ReadCacheSource(cachedPath, recorded)) {
+		return false;
+	}
+
+	CacheSource current;
+	if (!FileStats(sourcePath, current.size, current.mtime) || current.size != recorded.size) {
+		return false;
+	}
+	if (current.mtime == recorded.mtime) {
+		return true;
+	}
+
+	// only the time changed (a copy or reinstall), so check the contents
+	current.hash = HashFile(sourcePath);
+	if (current.hash != recorded.hash) {
+		return false;
+	}
+	WriteCacheSource(cachedPath, current);
+	return true;
+}
+
+void CacheEntrySetSource(const path_t& cachedPath, const path_t& sourcePath)
+{
+	CacheSource source;
+	if (!FileStats(sourcePath, source.size, source.mtime)) {
+		return;
+	}
+	source.hash = HashFile(sourcePath);
+	WriteCacheSource(cachedPath, source);
+}
+
 }
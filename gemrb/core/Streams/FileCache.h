@@ -25,6 +25,13 @@ namespace GemRB {
 
 GEM_EXPORT DataStream* CacheCompressedStream(DataStream* stream, const path_t& filename, int length = 0, bool overwrite = false);
 
+// Cache entries built from a file can remember its size, modification time and
+// a hash of its contents, so they get rebuilt when the file changes between runs.
+// The entry is fresh if it exists, its source was recorded and the source either
+// still has the same size and time or just got touched without changing.
+GEM_EXPORT bool CacheEntryIsFresh(const path_t& cachedPath, const path_t& sourcePath);
+GEM_EXPORT void CacheEntrySetSource(const path_t& cachedPath, const path_t& sourcePath);
+
 }
 
 #endif
@@ -39,6 +39,10 @@ public:
 	strret_t Read(void* dest, strpos_t length) override;
 	strret_t Write(const void* src, strpos_t length) override;
 	strret_t Seek(stroff_t pos, strpos_t startpos) override;
+
+	// direct view of the contents for readers that want to skip the copies
+	// there is none for encrypted data, since that needs to go through Read
+	const char* GetData() const noexcept { return Encrypted ? nullptr : data; }
 };
 
 }
@@ -79,6 +79,8 @@ public:
 	virtual ieStrRef UpdateString(ieStrRef strref, const String& text) = 0;
 	virtual bool HasAltTLK() const = 0;
 	virtual ieStrRef GetNextStrRef() const = 0;
+	/** human readable lookup cache statistics, if there is a cache */
+	virtual std::string GetCacheStats() const { return {}; }
 };
 
 }
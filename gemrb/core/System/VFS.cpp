@@ -298,6 +298,61 @@ std::tm* FileModificationTime(const path_t& path)
 #endif
 }
 
+/** Fetches the size and modification time of a regular file */
+bool FileStats(const path_t& path, uint64_t& size, int64_t& mtime)
+{
+#ifdef WIN32
+	auto buffer = StringFromUtf8(path.c_str());
+	auto wideChars = reinterpret_cast<const wchar_t*>(buffer.c_str());
+
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesEx(wideChars, GetFileExInfoStandard, &data) || (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+		return false;
+	}
+
+	size = (uint64_t(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+	// from 100ns intervals since 1601 to seconds since the unix epoch
+	uint64_t ticks = (uint64_t(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+	mtime = int64_t(ticks / 10000000) - 11644473600LL;
+#else
+	struct stat buf;
+	if (stat(path.c_str(), &buf) < 0 || !S_ISREG(buf.st_mode)) {
+		return false;
+	}
+
+	size = uint64_t(buf.st_size);
+	mtime = int64_t(buf.st_mtime);
+#endif
+
+	return true;
+}
+
+bool DirStats(const path_t& path, int64_t& mtime)
+{
+#ifdef WIN32
+	auto buffer = StringFromUtf8(path.c_str());
+	auto wideChars = reinterpret_cast<const wchar_t*>(buffer.c_str());
+
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesEx(wideChars, GetFileExInfoStandard, &data) || !(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+		return false;
+	}
+
+	// from 100ns intervals since 1601 to seconds since the unix epoch
+	uint64_t ticks = (uint64_t(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+	mtime = int64_t(ticks / 10000000) - 11644473600LL;
+#else
+	struct stat buf;
+	if (stat(path.c_str(), &buf) < 0 || !S_ISDIR(buf.st_mode)) {
+		return false;
+	}
+
+	mtime = int64_t(buf.st_mtime);
+#endif
+
+	return true;
+}
+
 void PathAppend(path_t& target, const path_t& name)
 {
 	if (name.empty()) {
@@ -626,6 +681,17 @@ bool RemoveDirectory(const path_t& path)
 #endif
 }
 
+bool RenameFile(const path_t& from, const path_t& to)
+{
+#ifdef WIN32
+	auto wideFrom = StringFromUtf8(from);
+	auto wideTo = StringFromUtf8(to);
+	return MoveFileExW(reinterpret_cast<const wchar_t*>(wideFrom.c_str()), reinterpret_cast<const wchar_t*>(wideTo.c_str()), MOVEFILE_REPLACE_EXISTING);
+#else
+	return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
 DirectoryIterator::DirectoryIterator(path_t path)
 	: Path(std::move(FixPath(path)))
 {
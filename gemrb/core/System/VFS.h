@@ -80,6 +80,9 @@ GEM_EXPORT path_t& ResolveFilePath(path_t& FilePath);
 
 GEM_EXPORT bool DirExists(const path_t& path);
 GEM_EXPORT bool FileExists(const path_t& path);
+// mtime is in seconds since the epoch on all platforms
+GEM_EXPORT bool FileStats(const path_t& path, uint64_t& size, int64_t& mtime);
+GEM_EXPORT bool DirStats(const path_t& path, int64_t& mtime);
 
 // when case sensitivity is enabled dir will be transformed to fit the case of the actual items composing the path
 GEM_EXPORT path_t& ResolveCase(path_t& dir);
@@ -154,6 +157,8 @@ void munmap(void* start, size_t);
 
 GEM_EXPORT bool RemoveDirectory(const path_t& path);
 GEM_EXPORT bool UnlinkFile(const path_t& path);
+// replaces the target in one step, if it exists
+GEM_EXPORT bool RenameFile(const path_t& from, const path_t& to);
 
 class GEM_EXPORT DirectoryIterator {
 public:
@@ -0,0 +1,188 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "TickBenchmark.h"
+
+#include "Game.h"
+#include "Map.h"
+
+#include "GameScript/GameScript.h"
+#include "Logging/Logging.h"
+#include "Scriptable/Actor.h"
+#include "Streams/DataStream.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace GemRB {
+
+static std::string NextToken(const std::string& line, size_t& pos)
+{
+	size_t start = line.find_first_not_of(' ', pos);
+	if (start == std::string::npos) {
+		pos = line.size();
+		return {};
+	}
+	size_t end = line.find(' ', start);
+	if (end == std::string::npos) end = line.size();
+	pos = end;
+	return line.substr(start, end - start);
+}
+
+bool TickBenchmark::LoadReplay(DataStream& stream)
+{
+	replay.clear();
+	nextAction = 0;
+
+	std::string line;
+	int lineNo = 0;
+	while (stream.ReadLine(line) != DataStream::Error) {
+		++lineNo;
+		size_t pos = line.find('#');
+		if (pos != std::string::npos) line.resize(pos);
+
+		pos = 0;
+		std::string tick = NextToken(line, pos);
+		if (tick.empty()) continue;
+
+		ReplayAction entry;
+		char* end = nullptr;
+		entry.tick = static_cast<uint32_t>(strtoul(tick.c_str(), &end, 10));
+		entry.actor = NextToken(line, pos);
+		size_t actionStart = line.find_first_not_of(' ', pos);
+		if (*end || entry.actor.empty() || actionStart == std::string::npos) {
+			Log(ERROR, "Benchmark", "Malformed replay line {}: {}", lineNo, line);
+			replay.clear();
+			return false;
+		}
+		entry.action = line.substr(actionStart);
+		entry.action.erase(entry.action.find_last_not_of(' ') + 1);
+		replay.push_back(std::move(entry));
+	}
+
+	// the file doesn't have to be ordered, but actions on the same tick keep their order
+	std::stable_sort(replay.begin(), replay.end(), [](const ReplayAction& a, const ReplayAction& b) {
+		return a.tick < b.tick;
+	});
+	return true;
+}
+
+static Actor* FindReplayActor(const Game& game, const std::string& name)
+{
+	char* end = nullptr;
+	unsigned long slot = strtoul(name.c_str(), &end, 10);
+	if (!*end) {
+		return game.FindPC(static_cast<unsigned int>(slot));
+	}
+
+	ieVariable scriptName = MakeVariable(name);
+	Actor* actor = game.FindPC(scriptName);
+	if (actor) return actor;
+
+	const Map* area = game.GetCurrentArea();
+	return area ? area->GetActor(scriptName, 0) : nullptr;
+}
+
+int TickBenchmark::Inject(const Game& game, uint32_t tick)
+{
+	int count = 0;
+	for (; nextAction < replay.size() && replay[nextAction].tick <= tick; ++nextAction) {
+		const ReplayAction& entry = replay[nextAction];
+		Actor* actor = FindReplayActor(game, entry.actor);
+		if (!actor) {
+			Log(WARNING, "Benchmark", "Tick {}: no actor called {}, skipping {}", tick, entry.actor, entry.action);
+			continue;
+		}
+		Action* action = GenerateAction(entry.action);
+		if (!action) {
+			Log(WARNING, "Benchmark", "Tick {}: invalid action {}", tick, entry.action);
+			continue;
+		}
+		// like a command given from the GUI
+		actor->CommandActor(action);
+		++count;
+	}
+	return count;
+}
+
+void TickBenchmark::AddTick(const FrameProfiler::Frame& frame)
+{
+	for (auto phase : EnumIterator<ProfilePhase>()) {
+		uint32_t time = frame.phases[phase];
+		phases[phase].total += time;
+		phases[phase].max = std::max(phases[phase].max, time);
+	}
+	++ticks;
+}
+
+void TickBenchmark::LogReport(FrameProfiler::Clock::duration elapsed, Hash state) const
+{
+	double seconds = std::chrono::duration<double>(elapsed).count();
+	double rate = seconds > 0 ? ticks / seconds : 0.0;
+	Log(MESSAGE, "Benchmark", "Ran {} ticks in {:.3f}s: {:.1f} ticks/s", ticks, seconds, rate);
+
+	for (auto phase : EnumIterator<ProfilePhase>()) {
+		const PhaseStats& stats = phases[phase];
+		if (!stats.total) continue;
+		double average = ticks ? double(stats.total) / ticks : 0.0;
+		Log(MESSAGE, "Benchmark", "{}: {:.1f} us/tick on average, {} us at most, {:.3f}s in total",
+		    FrameProfiler::GetPhaseName(phase), average, stats.max, stats.total / 1000000.0);
+	}
+	Log(MESSAGE, "Benchmark", "Final state hash: {:08x}", state.value);
+}
+
+Hash TickBenchmark::StateHash(const Game& game)
+{
+	Hasher hasher;
+	auto feedRef = [&hasher](const ResRef& ref) {
+		for (char c : ref) {
+			hasher.Feed(static_cast<uint8_t>(c));
+		}
+	};
+
+	hasher.Feed(game.GameTime);
+	hasher.Feed(game.PartyGold);
+	hasher.Feed(game.Reputation);
+	feedRef(game.CurrentArea);
+
+	for (size_t i = 0; i < game.GetLoadedMapCount(); ++i) {
+		const Map* map = game.GetMap(static_cast<unsigned int>(i));
+		feedRef(map->GetScriptRef());
+
+		int count = map->GetActorCount(true);
+		hasher.Feed(count);
+		for (int j = 0; j < count; ++j) {
+			const Actor* actor = map->GetActor(j, true);
+			hasher.Feed(actor->GetGlobalID());
+			hasher.Feed(actor->Pos.x);
+			hasher.Feed(actor->Pos.y);
+			hasher.Feed(actor->GetOrientation());
+			for (Actor::stat_t stat : actor->BaseStats) {
+				hasher.Feed(stat);
+			}
+			for (Actor::stat_t stat : actor->Modified) {
+				hasher.Feed(stat);
+			}
+		}
+	}
+	return hasher.GetHash();
+}
+
+}
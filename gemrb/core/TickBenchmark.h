@@ -0,0 +1,78 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef TICKBENCHMARK_H
+#define TICKBENCHMARK_H
+
+#include "exports.h"
+
+#include "FrameProfiler.h"
+#include "MurmurHash.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GemRB {
+
+class DataStream;
+class Game;
+
+// Bookkeeping for the simulation benchmark (see the BenchmarkTicks setting
+// and Interface::RunBenchmark): the replayed actions, the timings of the
+// simulated ticks and a hash of the final game state.
+class GEM_EXPORT TickBenchmark {
+public:
+	struct ReplayAction {
+		uint32_t tick = 0; // counted from the start of the benchmark
+		std::string actor; // party slot (1-6) or scripting name
+		std::string action; // in the usual script syntax
+	};
+
+	struct PhaseStats {
+		uint64_t total = 0; // microseconds
+		uint32_t max = 0;
+	};
+
+	// one action per line: "<tick> <actor> <action>", # starts a comment
+	bool LoadReplay(DataStream& stream);
+	const std::vector<ReplayAction>& GetReplay() const { return replay; }
+	// hands the due actions to their actors, returns how many were used
+	int Inject(const Game& game, uint32_t tick);
+
+	void AddTick(const FrameProfiler::Frame& frame);
+	uint32_t GetTicks() const { return ticks; }
+	const PhaseStats& GetPhase(ProfilePhase phase) const { return phases[phase]; }
+	void LogReport(FrameProfiler::Clock::duration elapsed, Hash state) const;
+
+	// covers the game time and gold, plus the position and stats of every
+	// actor in the loaded areas, so any change in the simulation shows
+	static Hash StateHash(const Game& game);
+
+private:
+	std::vector<ReplayAction> replay;
+	size_t nextAction = 0;
+	uint32_t ticks = 0;
+	EnumArray<ProfilePhase, PhaseStats> phases;
+};
+
+}
+
+#endif
@@ -24,6 +24,8 @@
 #include "GlobalTimer.h"
 #include "Interface.h"
 
+#include "Logging/Logging.h"
+
 namespace GemRB {
 
 TileOverlay::TileOverlay(Size size) noexcept
@@ -35,6 +37,142 @@ void TileOverlay::AddTile(Tile&& tile)
 	tiles.push_back(std::move(tile));
 }
 
+bool TileOverlay::IsStaticTile(const Tile& tile) const
+{
+	// doors switch to the second animation, so only single animation tiles qualify
+	if (tile.GetAnimation(1)) return false;
+
+	const Animation* anim = tile.GetAnimation(0);
+	return anim && anim->GetFrameCount() == 1;
+}
+
+bool TileOverlay::InitChunks() const
+{
+	if (!core->config.TerrainChunks || chunkTiles < 0) return false;
+	if (chunkTiles) return true;
+
+	// chunks are drawn into without the screen clip, which still limits them to the screen size
+	const Size& screen = VideoDriver->GetScreenSize();
+	int fit = std::min(std::min(screen.w, screen.h) / 64, 16);
+	if (fit < 2) {
+		chunkTiles = -1;
+		return false;
+	}
+	chunkTiles = 2;
+	while (chunkTiles * 2 <= fit) {
+		chunkTiles *= 2;
+	}
+
+	chunkGrid.w = (size.w + chunkTiles - 1) / chunkTiles;
+	chunkGrid.h = (size.h + chunkTiles - 1) / chunkTiles;
+	chunks.resize(chunkGrid.Area());
+	staticTiles.resize(tiles.size());
+	for (size_t i = 0; i < tiles.size(); ++i) {
+		staticTiles[i] = IsStaticTile(tiles[i]);
+	}
+	return true;
+}
+
+void TileOverlay::ReleaseOldestChunk() const
+{
+	Chunk* oldest = nullptr;
+	for (Chunk& chunk : chunks) {
+		// never the ones already drawn this frame
+		if (!chunk.buffer || chunk.lastUse == chunkFrame) continue;
+		if (!oldest || chunk.lastUse < oldest->lastUse) {
+			oldest = &chunk;
+		}
+	}
+
+	if (oldest) {
+		*oldest = Chunk();
+		--liveChunks;
+	}
+}
+
+bool TileOverlay::BuildChunk(Chunk& chunk, const Point& cell, BlitFlags flags, const Color& tint) const
+{
+	int x0 = cell.x * chunkTiles;
+	int y0 = cell.y * chunkTiles;
+	int x1 = std::min(x0 + chunkTiles, size.w);
+	int y1 = std::min(y0 + chunkTiles, size.h);
+
+	chunk.built = true;
+	bool anyStatic = false;
+	for (int y = y0; y < y1 && !anyStatic; ++y) {
+		for (int x = x0; x < x1; ++x) {
+			if (staticTiles[y * size.w + x]) {
+				anyStatic = true;
+				break;
+			}
+		}
+	}
+	if (!anyStatic) return true;
+
+	if (liveChunks >= MAX_CHUNKS) {
+		ReleaseOldestChunk();
+	}
+	chunk.buffer = VideoDriver->CreateBuffer(Region(0, 0, (x1 - x0) * 64, (y1 - y0) * 64), Video::BufferFormat::DISPLAY);
+	if (!chunk.buffer) return false;
+	++liveChunks;
+
+	const Region clip = VideoDriver->GetScreenClip();
+	VideoDriver->SetScreenClip(nullptr);
+	VideoDriver->PushDrawingBuffer(chunk.buffer);
+	chunk.buffer->Clear();
+	for (int y = y0; y < y1; ++y) {
+		for (int x = x0; x < x1; ++x) {
+			int idx = y * size.w + x;
+			if (!staticTiles[idx]) continue;
+
+			Animation::frame_t frame = tiles[idx].GetAnimation(0)->GetFrame(0);
+			if (frame) {
+				VideoDriver->BlitGameSprite(frame, Point((x - x0) * 64, (y - y0) * 64), flags, tint);
+			}
+		}
+	}
+	VideoDriver->PopDrawingBuffer();
+	VideoDriver->SetScreenClip(&clip);
+	return true;
+}
+
+bool TileOverlay::DrawChunks(const Region& viewport, BlitFlags flags, const Color& tint) const
+{
+	if (flags != chunkFlags || tint != chunkTint) {
+		for (Chunk& chunk : chunks) {
+			chunk = Chunk();
+		}
+		liveChunks = 0;
+		chunkFlags = flags;
+		chunkTint = tint;
+	}
+	++chunkFrame;
+
+	int edge = chunkTiles * 64;
+	int sx = std::max(viewport.x / edge, 0);
+	int sy = std::max(viewport.y / edge, 0);
+	int dx = std::min((std::max(viewport.x, 0) + viewport.w + edge - 1) / edge, chunkGrid.w);
+	int dy = std::min((std::max(viewport.y, 0) + viewport.h + edge - 1) / edge, chunkGrid.h);
+
+	for (int y = sy; y < dy; ++y) {
+		for (int x = sx; x < dx; ++x) {
+			Chunk& chunk = chunks[y * chunkGrid.w + x];
+			if (!chunk.built && !BuildChunk(chunk, Point(x, y), flags, tint)) {
+				Log(ERROR, "TileOverlay", "Unable to create a terrain chunk, drawing the tiles one by one.");
+				chunkTiles = -1;
+				chunks.clear();
+				liveChunks = 0;
+				return false;
+			}
+			chunk.lastUse = chunkFrame;
+			if (chunk.buffer) {
+				VideoDriver->BlitVideoBuffer(chunk.buffer, Point(x * edge, y * edge) - viewport.origin, BlitFlags::NONE);
+			}
+		}
+	}
+	return true;
+}
+
 void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr>& overlays, BlitFlags flags) const
 {
 	// determine which tiles are visible
@@ -50,18 +188,23 @@ void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr>& over
 		flags |= BlitFlags::COLOR_MOD;
 	}
 	const Color tintcol = globalTint ? *globalTint : Color();
+	bool chunked = InitChunks() && DrawChunks(viewport, flags, tintcol);
 
 	for (int y = sy; y < dy && y < size.h; y++) {
 		for (int x = sx; x < dx && x < size.w; x++) {
-			const Tile& tile = tiles[(y * size.w) + x];
+			int idx = y * size.w + x;
+			const Tile& tile = tiles[idx];
 
 			//draw door tiles if there are any
 			Animation* anim = tile.GetAnimation();
 			assert(anim);
 
 			// this is the base terrain tile
+			// unless it is already part of a chunk
 			Point p = Point(x * 64, y * 64) - viewport.origin;
-			VideoDriver->BlitGameSprite(anim->NextFrame(), p, flags, tintcol);
+			if (!chunked || !staticTiles[idx]) {
+				VideoDriver->BlitGameSprite(anim->NextFrame(), p, flags, tintcol);
+			}
 
 			if (!tile.om || tile.tileIndex) {
 				continue;
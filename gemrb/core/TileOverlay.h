@@ -48,6 +48,33 @@ public:
 
 	void AddTile(Tile&& tile);
 	void Draw(const Region& viewport, std::vector<TileOverlayPtr>& overlays, BlitFlags flags) const;
+
+private:
+	// Static terrain (single frame tiles that doors can't swap) is pre-composited
+	// into chunks of up to 16x16 tiles, which are built as they scroll into view
+	// and then drawn with a single blit. The chunks bake in the tint and the
+	// grey/sepia flags, so a change of either one rebuilds them.
+	struct Chunk {
+		VideoBufferPtr buffer;
+		uint32_t lastUse = 0;
+		bool built = false; // buffer stays empty if there is nothing static to draw
+	};
+	static constexpr size_t MAX_CHUNKS = 32;
+
+	mutable std::vector<Chunk> chunks;
+	mutable std::vector<bool> staticTiles;
+	mutable int chunkTiles = 0; // the edge of a chunk in tiles
+	mutable Size chunkGrid;
+	mutable size_t liveChunks = 0;
+	mutable uint32_t chunkFrame = 0;
+	mutable BlitFlags chunkFlags = BlitFlags::NONE;
+	mutable Color chunkTint;
+
+	bool IsStaticTile(const Tile& tile) const;
+	bool InitChunks() const;
+	bool DrawChunks(const Region& viewport, BlitFlags flags, const Color& tint) const;
+	bool BuildChunk(Chunk& chunk, const Point& cell, BlitFlags flags, const Color& tint) const;
+	void ReleaseOldestChunk() const;
 };
 
 }
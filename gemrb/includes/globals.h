@@ -38,6 +38,7 @@
 #include "Streams/DataStream.h"
 
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <climits>
@@ -170,8 +171,15 @@ GEM_EXPORT bool Schedule(ieDword schedule, ieDword time);
 #define SCHEDULE_MASK(time) (1 << core->Time.GetHour(time - core->Time.hour_size / 2))
 
 using tick_t = unsigned long; // milliseconds
+// headless runs replace the real clock with one that only moves when told to
+// 0 means the real one is in use
+GEM_EXPORT extern std::atomic<tick_t> ManualTime;
+
 inline tick_t GetMilliseconds()
 {
+	tick_t manual = ManualTime.load(std::memory_order_relaxed);
+	if (manual) return manual;
+
 	using namespace std::chrono;
 	return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
 }
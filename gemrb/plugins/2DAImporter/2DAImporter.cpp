@@ -30,6 +30,12 @@ static bool StringCompKey(const std::string& str, TableMgr::key_t key)
 	return stricmp(str.c_str(), key.c_str()) == 0;
 }
 
+// keys can come from fixed size buffers, but the comparison used to stop at the terminator
+static StringView TrimKey(const TableMgr::key_t& key)
+{
+	return StringView(key.c_str(), strnlen(key.c_str(), key.length()));
+}
+
 TableMgr::index_t p2DAImporter::npos = TableMgr::npos;
 
 bool p2DAImporter::Open(std::unique_ptr<DataStream> str)
@@ -67,37 +73,69 @@ bool p2DAImporter::Open(std::unique_ptr<DataStream> str)
 	if (end != std::string::npos)
 		colNames = Explode<StringView, cell_t>(StringView(line, end), ' ');
 
+	// only needed while reading, the views point into cellPool
+	std::unordered_map<StringView, cellref_t, CstrHash<>, CstrEq<>> interned;
+	auto Intern = [&](const StringView& value) -> cellref_t {
+		auto it = interned.find(value);
+		if (it != interned.end()) {
+			return it->second;
+		}
+		cellPool.emplace_back(value.c_str(), value.length());
+		cellref_t ref = static_cast<cellref_t>(cellPool.size() - 1);
+		interned.emplace(StringView(cellPool.back()), ref);
+		return ref;
+	};
+	// so QueryField can tell it apart quickly
+	defRef = Intern(StringView("*"));
+
 	rowNames.reserve(10);
-	rows.reserve(10);
+	rowStarts.reserve(11);
 	while (NextLine()) {
 		pos = line.find_first_of(' ');
 		if (pos == std::string::npos) {
 			if (line.empty()) continue;
 			// row with no data, but a valid row name (eg. first row in iwd music.2da)
 			rowNames.emplace_back(line);
-			rows.emplace_back();
+			rowStarts.push_back(cells.size());
 			continue;
 		}
 
 		rowNames.emplace_back(line.substr(0, pos));
+		rowStarts.push_back(cells.size());
 
 		auto sv = StringView(&line[pos + 1], line.length() - pos - 1);
-		rows.emplace_back(Explode<StringView, cell_t>(sv, ' ', std::max<size_t>(1, colNames.size() - 1)));
-		auto& row = rows.back();
+		auto row = Explode<StringView, StringView>(sv, ' ', std::max<size_t>(1, colNames.size() - 1));
 		// Explode may have returned trailing space as the last but empty item
 		if (!row.empty() && row.back().length() == 0) {
 			row.pop_back();
 		}
+		for (const auto& cell : row) {
+			cells.push_back(Intern(cell));
+		}
 	}
+	rowStarts.push_back(cells.size());
+
+	BuildIndex(colNames, colIndex);
+	BuildIndex(rowNames, rowIndex);
 
-	assert(rows.size() < std::numeric_limits<index_t>::max());
+	assert(rowNames.size() < std::numeric_limits<index_t>::max());
 	return true;
 }
 
+void p2DAImporter::BuildIndex(const std::vector<cell_t>& names, index_map_t& index)
+{
+	index.clear();
+	index.reserve(names.size());
+	for (index_t i = 0; i < names.size(); i++) {
+		// emplace keeps the first one, like the old linear search did
+		index.emplace(StringView(names[i]), i);
+	}
+}
+
 /** Returns the actual number of Rows in the Table */
 p2DAImporter::index_t p2DAImporter::GetRowCount() const
 {
-	return static_cast<index_t>(rows.size());
+	return static_cast<index_t>(rowNames.size());
 }
 
 p2DAImporter::index_t p2DAImporter::GetColNamesCount() const
@@ -108,25 +146,27 @@ p2DAImporter::index_t p2DAImporter::GetColNamesCount() const
 /** Returns the actual number of Columns in the Table */
 p2DAImporter::index_t p2DAImporter::GetColumnCount(index_t row) const
 {
-	if (rows.size() <= row) {
+	if (rowNames.size() <= row) {
 		return 0;
 	}
-	return static_cast<index_t>(rows[row].size());
+	return static_cast<index_t>(rowStarts[row + 1] - rowStarts[row]);
 }
 /** Returns a pointer to a zero terminated 2da element,
 	if it cannot return a value, it returns the default */
 const std::string& p2DAImporter::QueryField(index_t row, index_t column) const
 {
-	if (rows.size() <= row) {
+	if (rowNames.size() <= row) {
 		return defVal;
 	}
-	if (rows[row].size() <= column) {
+	size_t cell = rowStarts[row] + column;
+	if (cell >= rowStarts[row + 1]) {
 		return defVal;
 	}
-	if (rows[row][column] == "*") {
+	cellref_t ref = cells[cell];
+	if (ref == defRef) {
 		return defVal;
 	}
-	return rows[row][column];
+	return cellPool[ref];
 }
 
 const std::string& p2DAImporter::QueryDefault() const
@@ -136,22 +176,20 @@ const std::string& p2DAImporter::QueryDefault() const
 
 p2DAImporter::index_t p2DAImporter::GetRowIndex(const key_t& key) const
 {
-	for (index_t index = 0; index < rowNames.size(); index++) {
-		if (StringCompKey(rowNames[index], key)) {
-			return index;
-		}
+	auto it = rowIndex.find(TrimKey(key));
+	if (it == rowIndex.end()) {
+		return npos;
 	}
-	return npos;
+	return it->second;
 }
 
 p2DAImporter::index_t p2DAImporter::GetColumnIndex(const key_t& key) const
 {
-	for (index_t index = 0; index < colNames.size(); index++) {
-		if (StringCompKey(colNames[index], key)) {
-			return index;
-		}
+	auto it = colIndex.find(TrimKey(key));
+	if (it == colIndex.end()) {
+		return npos;
 	}
-	return npos;
+	return it->second;
 }
 
 const static std::string blank;
@@ -25,7 +25,11 @@
 
 #include "TableMgr.h"
 
+#include "Strings/CString.h"
+
 #include <cstring>
+#include <deque>
+#include <unordered_map>
 #include <vector>
 
 namespace GemRB {
@@ -33,16 +37,32 @@ namespace GemRB {
 class p2DAImporter : public TableMgr {
 private:
 	using cell_t = std::string;
-	using row_t = std::vector<cell_t>;
+	// index into the pool of distinct cell values
+	using cellref_t = uint32_t;
+	using index_map_t = std::unordered_map<StringView, index_t, CstrHashCI, CstrEqCI>;
 
 	std::vector<cell_t> colNames;
 	std::vector<cell_t> rowNames;
-	std::vector<row_t> rows;
+	// most cells repeat the same few values (0, *, -1, ...), so each distinct
+	// value is stored once and the rows only hold references to it
+	// a deque, since the cells are handed out by reference
+	std::deque<cell_t> cellPool;
+	std::vector<cellref_t> cells;
+	// where each row starts in cells, plus the end of the last one
+	std::vector<size_t> rowStarts;
+	cellref_t defRef = 0;
 	std::string defVal;
+	// first occurrences of the names, the views point into colNames and rowNames
+	index_map_t colIndex;
+	index_map_t rowIndex;
+
+	static void BuildIndex(const std::vector<cell_t>& names, index_map_t& index);
 
 public:
 	static index_t npos;
 
+	p2DAImporter() noexcept = default;
+	p2DAImporter(const p2DAImporter&) = delete;
 	p2DAImporter& operator=(const p2DAImporter&) = delete;
 	bool Open(std::unique_ptr<DataStream> stream) override;
 	/** Returns the actual number of Rows in the Table */
@@ -1145,8 +1145,9 @@ bool AREImporter::GetActor(DataStream* str, PluginHolder<ActorMgr> actorMgr, Map
 		return false;
 	}
 
-	map->AddActor(act, false);
+	// position first, so the area indexes the actor in the right place
 	act->SetPos(pos);
+	map->AddActor(act, false);
 	act->Destination = destination;
 	act->HomeLocation = destination;
 	act->maxWalkDistance = maxDistance;
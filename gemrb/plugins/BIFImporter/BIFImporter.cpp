@@ -25,6 +25,7 @@
 #include "PluginMgr.h"
 
 #include "Logging/Logging.h"
+#include "Streams/BufferStream.h"
 #include "Streams/FileCache.h"
 #include "Streams/FileStream.h"
 #include "Streams/SlicedStream.h"
@@ -32,8 +33,63 @@
 	#include "Streams/MappedFileMemoryStream.h"
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
 using namespace GemRB;
 
+// the cache can be filled from the warm-up thread (see KEYImporter) and the
+// prefetcher too, so each entry is checked and filled by one thread at a time,
+// while opening any other archive goes ahead
+class CacheEntryLock {
+	static std::mutex mutex;
+	static std::condition_variable released;
+	static std::unordered_set<path_t> busy;
+
+	path_t cachePath;
+
+public:
+	explicit CacheEntryLock(const path_t& cachePath)
+		: cachePath(cachePath)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		released.wait(lock, [this]() { return busy.count(this->cachePath) == 0; });
+		busy.insert(cachePath);
+	}
+
+	~CacheEntryLock()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			busy.erase(cachePath);
+		}
+		released.notify_all();
+	}
+
+	CacheEntryLock(const CacheEntryLock&) = delete;
+	CacheEntryLock& operator=(const CacheEntryLock&) = delete;
+};
+
+std::mutex CacheEntryLock::mutex;
+std::condition_variable CacheEntryLock::released;
+std::unordered_set<path_t> CacheEntryLock::busy;
+
+// BIFC blocks are separate zlib streams, so a batch of them is inflated in parallel
+static constexpr size_t BIFC_BATCH = 256;
+static constexpr unsigned int BIFC_MAX_WORKERS = 8;
+
+struct BIFCBlock {
+	std::vector<char> compressed;
+	std::vector<char> decompressed;
+	bool ok = false;
+};
+
 BIFImporter::~BIFImporter(void)
 {
 	delete stream;
@@ -59,19 +115,55 @@ DataStream* BIFImporter::DecompressBIFC(DataStream* compressed, const path_t& pa
 		Log(ERROR, "BIFImporter", "Cannot write {}.", path);
 		return NULL;
 	}
+
+	unsigned int workers = std::max(1U, std::min(std::thread::hardware_concurrency(), BIFC_MAX_WORKERS));
+	std::vector<BIFCBlock> blocks(BIFC_BATCH);
 	size_t finalsize = 0;
-	int laststep = 0;
 	while (finalsize < unCompBifSize) {
-		ieDword complen, declen;
-		compressed->ReadDword(declen);
-		compressed->ReadDword(complen);
-		if (comp->Decompress(&out, compressed, complen) != GEM_OK) {
-			return NULL;
+		// the headers have to be read in order anyway, so collect a batch first
+		size_t count = 0;
+		size_t batchSize = 0;
+		while (count < BIFC_BATCH && finalsize + batchSize < unCompBifSize) {
+			ieDword complen, declen;
+			compressed->ReadDword(declen);
+			if (compressed->ReadDword(complen) != 4 || complen > compressed->Remains()) {
+				return NULL;
+			}
+			BIFCBlock& block = blocks[count];
+			block.compressed.resize(complen);
+			if (compressed->Read(block.compressed.data(), complen) != strret_t(complen)) {
+				return NULL;
+			}
+			block.decompressed.clear();
+			batchSize += declen;
+			++count;
 		}
-		finalsize = out.GetPos();
-		if ((int) (finalsize * (10.0 / unCompBifSize)) != laststep) {
-			laststep++;
+
+		std::atomic<size_t> next { 0 };
+		auto inflateBlocks = [&]() {
+			for (size_t i = next++; i < count; i = next++) {
+				BIFCBlock& block = blocks[i];
+				BufferStream source(block.compressed);
+				BufferStream dest(block.decompressed);
+				block.ok = comp->Decompress(&dest, &source, static_cast<unsigned int>(block.compressed.size())) == GEM_OK;
+			}
+		};
+		std::vector<std::thread> helpers;
+		for (unsigned int i = 1; i < std::min<size_t>(workers, count); ++i) {
+			helpers.emplace_back(inflateBlocks);
+		}
+		inflateBlocks();
+		for (auto& helper : helpers) {
+			helper.join();
 		}
+
+		for (size_t i = 0; i < count; ++i) {
+			if (!blocks[i].ok) {
+				return NULL;
+			}
+			out.Write(blocks[i].decompressed.data(), blocks[i].decompressed.size());
+		}
+		finalsize = out.GetPos();
 	}
 	out.Close(); // This is necessary, since windows won't open the file otherwise.
 #if defined(SUPPORTS_MEMSTREAM)
@@ -89,7 +181,7 @@ DataStream* BIFImporter::DecompressBIF(DataStream* compressed, const path_t& /*p
 	compressed->ReadDword(declen);
 	compressed->ReadDword(complen);
 	Log(MESSAGE, "BIFImporter", "Decompressing {} ...", compressed->filename);
-	return CacheCompressedStream(compressed, std::string(compressed->filename), complen);
+	return CacheCompressedStream(compressed, std::string(compressed->filename), complen, true);
 }
 
 int BIFImporter::OpenArchive(const path_t& path)
@@ -97,48 +189,61 @@ int BIFImporter::OpenArchive(const path_t& path)
 	delete stream;
 	stream = nullptr;
 
-	path_t cachePath = PathJoin(core->config.CachePath, ExtractFileFromPath(path));
 	char Signature[8];
 #if defined(SUPPORTS_MEMSTREAM)
-	auto cacheStream = new MappedFileMemoryStream { cachePath.c_str() };
-
-	if (!cacheStream->isOk()) {
-		delete cacheStream;
-
-		auto file = new MappedFileMemoryStream { path };
-		if (!file->isOk()) {
-			delete file;
+	auto file = new MappedFileMemoryStream { path };
+	if (!file->isOk()) {
+		delete file;
+		return GEM_ERROR;
+	}
 #else
-	stream = FileStream::OpenFile(cachePath);
+	FileStream* file = FileStream::OpenFile(path);
+	if (!file) {
+		return GEM_ERROR;
+	}
+#endif
+	if (file->Read(Signature, 8) == GEM_ERROR) {
+		delete file;
+		return GEM_ERROR;
+	}
 
-	if (!stream) {
-		FileStream* file = FileStream::OpenFile(path);
-		if (!file) {
+	bool isBIF = strncmp(Signature, "BIF V1.0", 8) == 0;
+	bool isBIFC = strncmp(Signature, "BIFCV1.0", 8) == 0;
+	if (strncmp(Signature, "BIFFV1  ", 8) == 0) {
+		// not compressed, so the cache isn't involved
+		file->Seek(0, GEM_STREAM_START);
+		stream = file;
+	} else if (isBIF || isBIFC) {
+		path_t cachePath = PathJoin(core->config.CachePath, ExtractFileFromPath(path));
+		CacheEntryLock lock(cachePath);
+		// a leftover from a different install or an older version of the file is rebuilt
+		if (CacheEntryIsFresh(cachePath, path)) {
+#if defined(SUPPORTS_MEMSTREAM)
+			auto cacheStream = new MappedFileMemoryStream { cachePath };
+			if (cacheStream->isOk()) {
+				stream = cacheStream;
+			} else {
+				delete cacheStream;
+			}
+#else
+			stream = FileStream::OpenFile(cachePath);
 #endif
-			return GEM_ERROR;
-		}
-		if (file->Read(Signature, 8) == GEM_ERROR) {
-			delete file;
-			return GEM_ERROR;
 		}
 
-		if (strncmp(Signature, "BIF V1.0", 8) == 0) {
-			stream = DecompressBIF(file, cachePath.c_str());
-			delete file;
-		} else if (strncmp(Signature, "BIFCV1.0", 8) == 0) {
-			stream = DecompressBIFC(file, cachePath.c_str());
-			delete file;
-		} else if (strncmp(Signature, "BIFFV1  ", 8) == 0) {
-			file->Seek(0, GEM_STREAM_START);
-			stream = file;
-		} else {
-			delete file;
-			return GEM_ERROR;
+		if (!stream) {
+			if (isBIF) {
+				stream = DecompressBIF(file, cachePath);
+			} else {
+				stream = DecompressBIFC(file, cachePath);
+			}
+			if (stream) {
+				CacheEntrySetSource(cachePath, path);
+			}
 		}
-#if defined(SUPPORTS_MEMSTREAM)
+		delete file;
 	} else {
-		stream = cacheStream;
-#endif
+		delete file;
+		return GEM_ERROR;
 	}
 
 	if (!stream)
@@ -60,6 +60,8 @@ public:
 	/** returns resource */
 	DataStream* GetResource(StringView resname, SClass_ID type) override;
 	DataStream* GetResource(StringView resname, const ResourceDesc& type) override;
+	// only the listing made at Open is consulted
+	bool HasFixedContents() const override { return true; }
 };
 
 
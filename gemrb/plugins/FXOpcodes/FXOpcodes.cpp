@@ -458,19 +458,19 @@ int fx_unknown(Scriptable* Owner, Actor* target, Effect* fx); //???
 static EffectDesc effectnames[] = {
 	EffectDesc("*Crash*", fx_crash, EFFECT_NO_ACTOR, -1),
 	EffectDesc("AcidResistanceModifier", fx_acid_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("ACVsCreatureType", fx_generic_effect, 0, -1), //0xdb
+	EffectDesc("ACVsCreatureType", fx_generic_effect, EFFECT_STAT_ONLY, -1), //0xdb
 	EffectDesc("ACVsDamageTypeModifier", fx_ac_vs_damage_type_modifier, 0, -1),
 	EffectDesc("ACVsDamageTypeModifier2", fx_ac_vs_damage_type_modifier, 0, -1), // used in IWD
 	EffectDesc("AidNonCumulative", fx_set_aid_state, 0, -1),
 	EffectDesc("AIIdentifierModifier", fx_ids_modifier, 0, -1),
-	EffectDesc("AlchemyModifier", fx_alchemy_modifier, 0, -1),
-	EffectDesc("Alignment:Change", fx_alignment_change, 0, -1),
+	EffectDesc("AlchemyModifier", fx_alchemy_modifier, EFFECT_STAT_ONLY, -1),
+	EffectDesc("Alignment:Change", fx_alignment_change, EFFECT_STAT_ONLY, -1),
 	EffectDesc("Alignment:Invert", fx_alignment_invert, 0, -1),
 	EffectDesc("AlterAnimation", fx_alter_animation, EFFECT_NO_ACTOR, -1),
-	EffectDesc("AlwaysBackstab", fx_always_backstab_modifier, 0, -1),
+	EffectDesc("AlwaysBackstab", fx_always_backstab_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("AnimationIDModifier", fx_animation_id_modifier, 0, -1),
 	EffectDesc("AnimationStateChange", fx_animation_stance, 0, -1),
-	EffectDesc("AnimationOverrideData", fx_generic_effect, 0, -1),
+	EffectDesc("AnimationOverrideData", fx_generic_effect, EFFECT_STAT_ONLY, -1),
 	EffectDesc("ApplyEffect", fx_apply_effect, EFFECT_NO_ACTOR, -1),
 	EffectDesc("ApplyEffectCurse", fx_apply_effect_curse, 0, -1),
 	EffectDesc("ApplyEffectItem", fx_apply_effect_item, 0, -1),
@@ -478,13 +478,13 @@ static EffectDesc effectnames[] = {
 	EffectDesc("ApplyEffectsList", fx_add_effects_list, 0, -1),
 	EffectDesc("ApplyEffectRepeat", fx_apply_effect_repeat, 0, -1),
 	EffectDesc("CutScene2", fx_cutscene2, EFFECT_NO_ACTOR, -1),
-	EffectDesc("AttackSpeedModifier", fx_attackspeed_modifier, 0, -1),
+	EffectDesc("AttackSpeedModifier", fx_attackspeed_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("AttacksPerRoundModifier", fx_attacks_per_round_modifier, 0, -1),
-	EffectDesc("AuraCleansingModifier", fx_auracleansing_modifier, 0, -1),
-	EffectDesc("SummonDisable", fx_summon_disable, 0, -1), //unknown
-	EffectDesc("AvatarRemovalModifier", fx_avatar_removal_modifier, 0, -1),
+	EffectDesc("AuraCleansingModifier", fx_auracleansing_modifier, EFFECT_STAT_ONLY, -1),
+	EffectDesc("SummonDisable", fx_summon_disable, EFFECT_STAT_ONLY, -1), //unknown
+	EffectDesc("AvatarRemovalModifier", fx_avatar_removal_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("BackstabModifier", fx_backstab_modifier, 0, -1),
-	EffectDesc("BerserkStage1Modifier", fx_berserkstage1_modifier, 0, -1),
+	EffectDesc("BerserkStage1Modifier", fx_berserkstage1_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("BerserkStage2Modifier", fx_berserkstage2_modifier, 0, -1),
 	EffectDesc("BlessNonCumulative", fx_set_bless_state, 0, -1),
 	EffectDesc("Bounce:School", fx_bounce_school, 0, -1),
@@ -497,27 +497,27 @@ static EffectDesc effectnames[] = {
 	EffectDesc("Bounce:SpellLevelDec", fx_bounce_spelllevel_dec, 0, -1),
 	EffectDesc("Bounce:Opcode", fx_bounce_opcode, 0, -1),
 	EffectDesc("Bounce:Projectile", fx_bounce_projectile, 0, -1),
-	EffectDesc("CantUseItem", fx_generic_effect, EFFECT_NO_ACTOR, -1),
-	EffectDesc("CantUseItemType", fx_generic_effect, 0, -1),
-	EffectDesc("CanUseAnyItem", fx_can_use_any_item_modifier, 0, -1),
+	EffectDesc("CantUseItem", fx_generic_effect, EFFECT_NO_ACTOR | EFFECT_STAT_ONLY, -1),
+	EffectDesc("CantUseItemType", fx_generic_effect, EFFECT_STAT_ONLY, -1),
+	EffectDesc("CanUseAnyItem", fx_can_use_any_item_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("CastFromList", fx_select_spell, 0, -1),
 	EffectDesc("CastingGlow", fx_casting_glow, 0, -1),
 	EffectDesc("CastingGlow2", fx_casting_glow, 0, -1), //used in iwd
 	EffectDesc("CastingLevelModifier", fx_castinglevel_modifier, 0, -1),
-	EffectDesc("CastingSpeedModifier", fx_castingspeed_modifier, 0, -1),
+	EffectDesc("CastingSpeedModifier", fx_castingspeed_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("CastSpellOnCondition", fx_cast_spell_on_condition, 0, -1),
-	EffectDesc("CastSpellOnCriticalHit", fx_generic_effect, 0, -1), // aka ChangeCritical
-	EffectDesc("CastSpellOnCriticalMiss", fx_generic_effect, 0, -1),
+	EffectDesc("CastSpellOnCriticalHit", fx_generic_effect, EFFECT_STAT_ONLY, -1), // aka ChangeCritical
+	EffectDesc("CastSpellOnCriticalMiss", fx_generic_effect, EFFECT_STAT_ONLY, -1),
 	EffectDesc("ChangeBackstab", fx_change_backstab, 0, -1),
 	EffectDesc("ChangeBardSong", fx_change_bardsong, 0, -1),
-	EffectDesc("ChangeCritical", fx_generic_effect, 0, -1),
+	EffectDesc("ChangeCritical", fx_generic_effect, EFFECT_STAT_ONLY, -1),
 	EffectDesc("ChangeName", fx_change_name, 0, -1),
 	EffectDesc("ChangeWeather", fx_change_weather, EFFECT_NO_ACTOR, -1),
 	EffectDesc("ChantBadNonCumulative", fx_set_chantbad_state, 0, -1),
 	EffectDesc("ChantNonCumulative", fx_set_chant_state, 0, -1),
 	EffectDesc("ChaosShieldModifier", fx_chaos_shield_modifier, 0, -1),
 	EffectDesc("CharismaModifier", fx_charisma_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("CheckForBerserkModifier", fx_checkforberserk_modifier, 0, -1),
+	EffectDesc("CheckForBerserkModifier", fx_checkforberserk_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("ColdResistanceModifier", fx_cold_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("Color:BriefRGB", fx_brief_rgb, 0, -1),
 	EffectDesc("Color:GlowRGB", fx_glow_rgb, 0, -1),
@@ -531,7 +531,7 @@ static EffectDesc effectnames[] = {
 	EffectDesc("ControlCreature", fx_set_charmed_state, 0, -1), //0xf1 same as charm
 	EffectDesc("CreateContingency", fx_create_contingency, 0, -1),
 	EffectDesc("CriticalHitModifier", fx_critical_hit_modifier, 0, -1),
-	EffectDesc("CriticalMissModifier", fx_generic_effect, 0, -1),
+	EffectDesc("CriticalMissModifier", fx_generic_effect, EFFECT_STAT_ONLY, -1),
 	EffectDesc("CrushingResistanceModifier", fx_crushing_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("Cure:Berserk", fx_cure_berserk_state, 0, -1),
 	EffectDesc("Cure:Blind", fx_cure_blind_state, 0, -1),
@@ -563,20 +563,20 @@ static EffectDesc effectnames[] = {
 	EffectDesc("DamageAnimation", fx_damage_animation, 0, -1),
 	EffectDesc("DamageBonusModifier", fx_damage_bonus_modifier, 0, -1),
 	EffectDesc("DamageBonusModifier2", fx_damage_bonus_modifier2, 0, -1), // 49 (iwd, ee)
-	EffectDesc("DamageLuckModifier", fx_damageluck_modifier, 0, -1),
-	EffectDesc("DamageVsCreature", fx_generic_effect, 0, -1),
+	EffectDesc("DamageLuckModifier", fx_damageluck_modifier, EFFECT_STAT_ONLY, -1),
+	EffectDesc("DamageVsCreature", fx_generic_effect, EFFECT_STAT_ONLY, -1),
 	EffectDesc("Death", fx_death, 0, -1),
 	EffectDesc("Death2", fx_death, 0, -1), //(iwd2 effect)
 	EffectDesc("Death3", fx_death, 0, -1), //(iwd2 effect too, Banish)
 	EffectDesc("DetectAlignment", fx_detect_alignment, 0, -1),
-	EffectDesc("DetectIllusionsModifier", fx_detect_illusion_modifier, 0, -1),
+	EffectDesc("DetectIllusionsModifier", fx_detect_illusion_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("DexterityModifier", fx_dexterity_modifier, EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("DimensionDoor", fx_dimension_door, 0, -1),
 	EffectDesc("DisableButton", fx_disable_button, 0, -1), //sets disable button flag
-	EffectDesc("DisableChunk", fx_disable_chunk_modifier, 0, -1),
-	EffectDesc("DisableOverlay", fx_disable_overlay_modifier, 0, -1),
+	EffectDesc("DisableChunk", fx_disable_chunk_modifier, EFFECT_STAT_ONLY, -1),
+	EffectDesc("DisableOverlay", fx_disable_overlay_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("DisableCasting", fx_disable_spellcasting, 0, -1),
-	EffectDesc("DisableRest", fx_generic_effect, 0, -1),
+	EffectDesc("DisableRest", fx_generic_effect, EFFECT_STAT_ONLY, -1),
 	EffectDesc("Disintegrate", fx_disintegrate, 0, -1),
 	EffectDesc("DispelEffects", fx_dispel_effects, 0, -1),
 	EffectDesc("DispelSchool", fx_dispel_school, 0, -1),
@@ -586,16 +586,16 @@ static EffectDesc effectnames[] = {
 	EffectDesc("DisplayString", fx_display_string, 0, -1),
 	EffectDesc("DisplayEyesOverlay", fx_crash, 0, -1),
 	EffectDesc("Dither", fx_dither, 0, -1),
-	EffectDesc("DontJumpModifier", fx_dontjump_modifier, 0, -1),
+	EffectDesc("DontJumpModifier", fx_dontjump_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("DrainItems", fx_drain_items, 0, -1),
 	EffectDesc("DrainSpells", fx_drain_spells, 0, -1),
 	EffectDesc("DropWeapon", fx_drop_weapon, 0, -1),
 	EffectDesc("ElectricityResistanceModifier", fx_electricity_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("EnchantmentBonus", fx_generic_effect, 0, -1),
-	EffectDesc("EnchantmentVsCreatureType", fx_generic_effect, 0, -1),
-	EffectDesc("ExistanceDelayModifier", fx_existence_delay_modifier, 0, -1),
+	EffectDesc("EnchantmentBonus", fx_generic_effect, EFFECT_STAT_ONLY, -1),
+	EffectDesc("EnchantmentVsCreatureType", fx_generic_effect, EFFECT_STAT_ONLY, -1),
+	EffectDesc("ExistanceDelayModifier", fx_existence_delay_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("ExperienceModifier", fx_experience_modifier, 0, -1),
-	EffectDesc("ExploreModifier", fx_explore_modifier, 0, -1),
+	EffectDesc("ExploreModifier", fx_explore_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("FamiliarBond", fx_familiar_constitution_loss, 0, -1),
 	EffectDesc("FamiliarMarker", fx_familiar_marker, 0, -1),
 	EffectDesc("Farsee", fx_farsee, 0, -1),
@@ -604,26 +604,26 @@ static EffectDesc effectnames[] = {
 	EffectDesc("FindTraps", fx_find_traps, 0, -1),
 	EffectDesc("FindTrapsModifier", fx_find_traps_modifier, EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("FireResistanceModifier", fx_fire_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("FistDamageModifier", fx_fist_damage_modifier, 0, -1),
-	EffectDesc("FistHitModifier", fx_fist_to_hit_modifier, 0, -1),
+	EffectDesc("FistDamageModifier", fx_fist_damage_modifier, EFFECT_STAT_ONLY, -1),
+	EffectDesc("FistHitModifier", fx_fist_to_hit_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("FloatText", fx_floattext, 0, -1),
-	EffectDesc("ForceSurgeModifier", fx_force_surge_modifier, 0, -1),
+	EffectDesc("ForceSurgeModifier", fx_force_surge_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("ForceVisible", fx_force_visible, 0, -1), //not invisible but improved invisible
 	EffectDesc("FreeAction", fx_cure_slow_state, 0, -1),
 	EffectDesc("GenerateWish", fx_generate_wish, 0, -1),
 	EffectDesc("GoldModifier", fx_gold_modifier, 0, -1),
-	EffectDesc("HideInShadowsModifier", fx_hide_in_shadows_modifier, 0, -1),
-	EffectDesc("HLA", fx_generic_effect, 0, -1),
+	EffectDesc("HideInShadowsModifier", fx_hide_in_shadows_modifier, EFFECT_STAT_ONLY, -1),
+	EffectDesc("HLA", fx_generic_effect, EFFECT_STAT_ONLY, -1),
 	EffectDesc("HolyNonCumulative", fx_set_holy_state, 0, -1),
 	EffectDesc("Icon:Disable", fx_disable_portrait_icon, 0, -1),
 	EffectDesc("Icon:Display", fx_display_portrait_icon, 0, -1),
 	EffectDesc("Icon:Remove", fx_remove_portrait_icon, 0, -1),
 	EffectDesc("Identify", fx_identify, 0, -1),
-	EffectDesc("IgnoreDialogPause", fx_ignore_dialogpause_modifier, 0, -1),
-	EffectDesc("IgnoreReputationBreakingPoint", fx_generic_effect, 0, -1),
+	EffectDesc("IgnoreDialogPause", fx_ignore_dialogpause_modifier, EFFECT_STAT_ONLY, -1),
+	EffectDesc("IgnoreReputationBreakingPoint", fx_generic_effect, EFFECT_STAT_ONLY, -1),
 	EffectDesc("IntelligenceModifier", fx_intelligence_modifier, EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("IntoxicationModifier", fx_intoxication_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("InvisibleDetection", fx_see_invisible_modifier, 0, -1),
+	EffectDesc("InvisibleDetection", fx_see_invisible_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("Item:CreateDays", fx_create_item_days, 0, -1),
 	EffectDesc("Item:CreateInSlot", fx_create_item_in_slot, 0, -1),
 	EffectDesc("Item:CreateInventory", fx_create_inventory_item, 0, -1),
@@ -634,7 +634,7 @@ static EffectDesc effectnames[] = {
 	EffectDesc("IWDEEMonsterSummoning", fx_iwdee_monster_summoning, EFFECT_NO_ACTOR, -1),
 	EffectDesc("IWDVisualSpellHit", fx_iwd_visual_spell_hit, EFFECT_NO_ACTOR, -1),
 	EffectDesc("KillCreatureType", fx_kill_creature_type, 0, -1),
-	EffectDesc("LevelModifier", fx_level_modifier, 0, -1),
+	EffectDesc("LevelModifier", fx_level_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("LevelDrainModifier", fx_leveldrain_modifier, 0, -1),
 	EffectDesc("LoreModifier", fx_lore_modifier, EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("LuckModifier", fx_luck_modifier, EFFECT_NO_LEVEL_CHECK | EFFECT_SPECIAL_UNDO, -1),
@@ -643,19 +643,19 @@ static EffectDesc effectnames[] = {
 	EffectDesc("MagicalColdResistanceModifier", fx_magical_cold_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("MagicalFireResistanceModifier", fx_magical_fire_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("MagicalRest", fx_magical_rest, 0, -1),
-	EffectDesc("MagicDamageResistanceModifier", fx_magic_damage_resistance_modifier, 0, -1),
+	EffectDesc("MagicDamageResistanceModifier", fx_magic_damage_resistance_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("MagicResistanceModifier", fx_magic_resistance_modifier, 0, -1),
 	EffectDesc("MakeUnselectable", fx_crash, 0, -1),
 	EffectDesc("MassRaiseDead", fx_mass_raise_dead, EFFECT_NO_ACTOR, -1),
 	EffectDesc("MaximumHPModifier", fx_maximum_hp_modifier, EFFECT_DICED | EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("Maze", fx_maze, 0, -1),
-	EffectDesc("MeleeDamageModifier", fx_melee_damage_modifier, 0, -1),
-	EffectDesc("MeleeHitModifier", fx_melee_to_hit_modifier, 0, -1),
-	EffectDesc("MinimumBaseStats", fx_generic_effect, 0, -1),
-	EffectDesc("MinimumHPModifier", fx_minimum_hp_modifier, 0, -1),
+	EffectDesc("MeleeDamageModifier", fx_melee_damage_modifier, EFFECT_STAT_ONLY, -1),
+	EffectDesc("MeleeHitModifier", fx_melee_to_hit_modifier, EFFECT_STAT_ONLY, -1),
+	EffectDesc("MinimumBaseStats", fx_generic_effect, EFFECT_STAT_ONLY, -1),
+	EffectDesc("MinimumHPModifier", fx_minimum_hp_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("MiscastMagicModifier", fx_miscast_magic_modifier, 0, -1),
-	EffectDesc("MissileDamageModifier", fx_missile_damage_modifier, 0, -1),
-	EffectDesc("MissileHitModifier", fx_missile_to_hit_modifier, 0, -1),
+	EffectDesc("MissileDamageModifier", fx_missile_damage_modifier, EFFECT_STAT_ONLY, -1),
+	EffectDesc("MissileHitModifier", fx_missile_to_hit_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("MissilesResistanceModifier", fx_missiles_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("MirrorImage", fx_mirror_image, 0, -1),
 	EffectDesc("MirrorImageModifier", fx_mirror_image_modifier, 0, -1),
@@ -670,10 +670,10 @@ static EffectDesc effectnames[] = {
 	EffectDesc("MovementRateModifier3", fx_movement_modifier, 0, -1), //forced (IWD - 10a)
 	EffectDesc("MovementRateModifier4", fx_movement_modifier, 0, -1), //slow (IWD2 - 1b9)
 	EffectDesc("MoveToArea", fx_move_to_area, EFFECT_REINIT_ON_LOAD, -1), //0xba
-	EffectDesc("NoCircleState", fx_no_circle_state, 0, -1),
-	EffectDesc("NPCBump", fx_npc_bump, 0, -1),
+	EffectDesc("NoCircleState", fx_no_circle_state, EFFECT_STAT_ONLY, -1),
+	EffectDesc("NPCBump", fx_npc_bump, EFFECT_STAT_ONLY, -1),
 	EffectDesc("OffscreenAIModifier", fx_offscreenai_modifier, 0, -1),
-	EffectDesc("OffhandHitModifier", fx_left_to_hit_modifier, 0, -1),
+	EffectDesc("OffhandHitModifier", fx_left_to_hit_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("OpenLocksModifier", fx_open_locks_modifier, EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("Overlay:Entangle", fx_set_entangle_state, 0, -1),
 	EffectDesc("Overlay:Grease", fx_set_grease_state, 0, -1),
@@ -687,7 +687,7 @@ static EffectDesc effectnames[] = {
 	EffectDesc("PlayMovie", fx_play_movie, EFFECT_NO_ACTOR, -1),
 	EffectDesc("PlaySound", fx_playsound, EFFECT_NO_ACTOR, -1),
 	EffectDesc("PlayVisualEffect", fx_play_visual_effect, EFFECT_REINIT_ON_LOAD, -1),
-	EffectDesc("PoisonResistanceModifier", fx_poison_resistance_modifier, 0, -1),
+	EffectDesc("PoisonResistanceModifier", fx_poison_resistance_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("Polymorph", fx_polymorph, 0, -1),
 	EffectDesc("PortraitChange", fx_portrait_change, 0, -1),
 	EffectDesc("PowerWordKill", fx_power_word_kill, 0, -1),
@@ -695,12 +695,12 @@ static EffectDesc effectnames[] = {
 	EffectDesc("PowerWordStun", fx_power_word_stun, 0, -1),
 	EffectDesc("PriestSpellSlotsModifier", fx_bonus_priest_spells, 0, -1),
 	EffectDesc("Proficiency", fx_proficiency, 0, -1),
-	EffectDesc("Protection:Animation", fx_generic_effect, 0, -1),
+	EffectDesc("Protection:Animation", fx_generic_effect, EFFECT_STAT_ONLY, -1),
 	EffectDesc("Protection:Backstab", fx_no_backstab_modifier, 0, -1),
-	EffectDesc("Protection:Creature", fx_generic_effect, 0, -1),
-	EffectDesc("Protection:Opcode", fx_protection_opcode, 0, -1),
-	EffectDesc("Protection:Opcode2", fx_protection_opcode, 0, -1),
-	EffectDesc("Protection:Projectile", fx_protection_from_projectile, 0, -1),
+	EffectDesc("Protection:Creature", fx_generic_effect, EFFECT_STAT_ONLY, -1),
+	EffectDesc("Protection:Opcode", fx_protection_opcode, EFFECT_STAT_ONLY, -1),
+	EffectDesc("Protection:Opcode2", fx_protection_opcode, EFFECT_STAT_ONLY, -1),
+	EffectDesc("Protection:Projectile", fx_protection_from_projectile, EFFECT_STAT_ONLY, -1),
 	EffectDesc("Protection:School", fx_protection_school, 0, -1), //overlay?
 	EffectDesc("Protection:SchoolDec", fx_protection_school_dec, 0, -1), //overlay?
 	EffectDesc("Protection:SecondaryType", fx_protection_secondary_type, 0, -1), //overlay?
@@ -712,8 +712,8 @@ static EffectDesc effectnames[] = {
 	EffectDesc("Protection:SpellLevel", fx_protection_spelllevel, 0, -1), //overlay?
 	EffectDesc("Protection:SpellLevelDec", fx_protection_spelllevel_dec, 0, -1), //overlay?
 	EffectDesc("Protection:String", fx_protection_from_string, 0, -1),
-	EffectDesc("Protection:Tracking", fx_protection_from_tracking, 0, -1),
-	EffectDesc("Protection:Turn", fx_protection_from_turn, 0, -1),
+	EffectDesc("Protection:Tracking", fx_protection_from_tracking, EFFECT_STAT_ONLY, -1),
+	EffectDesc("Protection:Turn", fx_protection_from_turn, EFFECT_STAT_ONLY, -1),
 	EffectDesc("Protection:Weapons", fx_immune_to_weapon, EFFECT_NO_ACTOR | EFFECT_REINIT_ON_LOAD, -1),
 	EffectDesc("PuppetMarker", fx_puppet_marker, 0, -1),
 	EffectDesc("ProjectImage", fx_puppet_master, 0, -1),
@@ -733,14 +733,14 @@ static EffectDesc effectnames[] = {
 	EffectDesc("ReputationModifier", fx_reputation_modifier, 0, -1),
 	EffectDesc("RestoreSpells", fx_restore_spell_level, 0, -1),
 	EffectDesc("RetreatFrom2", fx_turn_undead, 0, -1),
-	EffectDesc("RightHitModifier", fx_right_to_hit_modifier, 0, -1),
-	EffectDesc("SaveBonus", fx_save_bonus, 0, -1),
-	EffectDesc("SaveVsBreathModifier", fx_save_vs_breath_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("SaveVsDeathModifier", fx_save_vs_death_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("SaveVsPolyModifier", fx_save_vs_poly_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("SaveVsSchoolModifier", fx_generic_effect, 0, -1),
-	EffectDesc("SaveVsSpellsModifier", fx_save_vs_spell_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("SaveVsWandsModifier", fx_save_vs_wands_modifier, EFFECT_SPECIAL_UNDO, -1),
+	EffectDesc("RightHitModifier", fx_right_to_hit_modifier, EFFECT_STAT_ONLY, -1),
+	EffectDesc("SaveBonus", fx_save_bonus, EFFECT_STAT_ONLY, -1),
+	EffectDesc("SaveVsBreathModifier", fx_save_vs_breath_modifier, EFFECT_SPECIAL_UNDO | EFFECT_STAT_ONLY, -1),
+	EffectDesc("SaveVsDeathModifier", fx_save_vs_death_modifier, EFFECT_SPECIAL_UNDO | EFFECT_STAT_ONLY, -1),
+	EffectDesc("SaveVsPolyModifier", fx_save_vs_poly_modifier, EFFECT_SPECIAL_UNDO | EFFECT_STAT_ONLY, -1),
+	EffectDesc("SaveVsSchoolModifier", fx_generic_effect, EFFECT_STAT_ONLY, -1),
+	EffectDesc("SaveVsSpellsModifier", fx_save_vs_spell_modifier, EFFECT_SPECIAL_UNDO | EFFECT_STAT_ONLY, -1),
+	EffectDesc("SaveVsWandsModifier", fx_save_vs_wands_modifier, EFFECT_SPECIAL_UNDO | EFFECT_STAT_ONLY, -1),
 	EffectDesc("ScreenShake", fx_screenshake, EFFECT_NO_ACTOR, -1),
 	EffectDesc("ScriptingState", fx_scripting_state, 0, -1),
 	EffectDesc("Sequencer:Activate", fx_activate_spell_sequencer, EFFECT_PRESET_TARGET, -1),
@@ -749,10 +749,10 @@ static EffectDesc effectnames[] = {
 	EffectDesc("SetAIScript", fx_set_ai_script, 0, -1),
 	EffectDesc("SetConcealment", fx_set_concealment, 0, -1),
 	EffectDesc("SetMapNote", fx_set_map_note, EFFECT_NO_ACTOR, -1),
-	EffectDesc("SetMeleeEffect", fx_generic_effect, 0, -1),
-	EffectDesc("SetRangedEffect", fx_generic_effect, 0, -1),
+	EffectDesc("SetMeleeEffect", fx_generic_effect, EFFECT_STAT_ONLY, -1),
+	EffectDesc("SetRangedEffect", fx_generic_effect, EFFECT_STAT_ONLY, -1),
 	EffectDesc("SetTrap", fx_set_area_effect, 0, -1),
-	EffectDesc("SetTrapsModifier", fx_set_traps_modifier, 0, -1),
+	EffectDesc("SetTrapsModifier", fx_set_traps_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("SevenEyes", fx_seven_eyes, 0, -1),
 	EffectDesc("SexModifier", fx_sex_modifier, 0, -1),
 	EffectDesc("SlashingResistanceModifier", fx_slashing_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
@@ -765,8 +765,8 @@ static EffectDesc effectnames[] = {
 	EffectDesc("Spell:CastPoint", fx_cast_spell_point, 0, -1),
 	EffectDesc("Spell:Learn", fx_learn_spell, 0, -1),
 	EffectDesc("Spell:Remove", fx_remove_spell, 0, -1),
-	EffectDesc("SpellFocus", fx_generic_effect, 0, -1), //to implement school specific saving throw penalty to opponent
-	EffectDesc("SpellResistance", fx_generic_effect, 0, -1), //to implement school specific saving throw bonus
+	EffectDesc("SpellFocus", fx_generic_effect, EFFECT_STAT_ONLY, -1), //to implement school specific saving throw penalty to opponent
+	EffectDesc("SpellResistance", fx_generic_effect, EFFECT_STAT_ONLY, -1), //to implement school specific saving throw bonus
 	EffectDesc("Spelltrap", fx_spelltrap, 0, -1), //overlay: spmagglo
 	EffectDesc("Stat:SetStat", fx_set_stat, 0, -1),
 	EffectDesc("State:Berserk", fx_set_berserk_state, 0, -1),
@@ -800,7 +800,7 @@ static EffectDesc effectnames[] = {
 	EffectDesc("State:Slowed", fx_set_slowed_state, 0, -1),
 	EffectDesc("State:Stun", fx_set_stun_state, 0, -1),
 	EffectDesc("StaticCharge", fx_static_charge, EFFECT_NO_LEVEL_CHECK, -1),
-	EffectDesc("StealthModifier", fx_stealth_modifier, 0, -1),
+	EffectDesc("StealthModifier", fx_stealth_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("StoneSkinModifier", fx_stoneskin_modifier, 0, -1),
 	EffectDesc("StoneSkin2Modifier", fx_golem_stoneskin_modifier, 0, -1),
 	EffectDesc("StrengthModifier", fx_strength_modifier, EFFECT_SPECIAL_UNDO, -1),
@@ -809,16 +809,16 @@ static EffectDesc effectnames[] = {
 	EffectDesc("SwapHP", fx_swap_hp, 0, -1),
 	EffectDesc("RandomTeleport", fx_teleport_field, 0, -1),
 	EffectDesc("TeleportToTarget", fx_teleport_to_target, 0, -1),
-	EffectDesc("TimelessState", fx_timeless_modifier, 0, -1),
+	EffectDesc("TimelessState", fx_timeless_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("Timestop", fx_timestop, 0, -1),
-	EffectDesc("TitleModifier", fx_title_modifier, 0, -1),
+	EffectDesc("TitleModifier", fx_title_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("ToHitModifier", fx_to_hit_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("ToHitBonusModifier", fx_to_hit_bonus_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("ToHitVsCreature", fx_generic_effect, 0, -1),
+	EffectDesc("ToHitBonusModifier", fx_to_hit_bonus_modifier, EFFECT_SPECIAL_UNDO | EFFECT_STAT_ONLY, -1),
+	EffectDesc("ToHitVsCreature", fx_generic_effect, EFFECT_STAT_ONLY, -1),
 	EffectDesc("TrackingModifier", fx_tracking_modifier, EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("TransparencyModifier", fx_transparency_modifier, 0, -1),
 	EffectDesc("TurnUndead", fx_turn_undead, 0, -1),
-	EffectDesc("TurnLevelModifier", fx_turnlevel_modifier, 0, -1),
+	EffectDesc("TurnLevelModifier", fx_turnlevel_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("UncannyDodge", fx_uncanny_dodge, 0, -1),
 	EffectDesc("Unknown", fx_unknown, EFFECT_NO_ACTOR, -1),
 	EffectDesc("Unlock", fx_knock, EFFECT_NO_ACTOR, -1), //open doors/containers
@@ -826,9 +826,9 @@ static EffectDesc effectnames[] = {
 	EffectDesc("Usability:ItemUsability", fx_item_usability, EFFECT_NO_LEVEL_CHECK, -1),
 	EffectDesc("Variable:StoreLocalVariable", fx_local_variable, 0, -1),
 	EffectDesc("VisualAnimationEffect", fx_visual_animation_effect, 0, -1), //unknown
-	EffectDesc("VisualRangeModifier", fx_visual_range_modifier, 0, -1),
+	EffectDesc("VisualRangeModifier", fx_visual_range_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("VisualSpellHit", fx_visual_spell_hit, 0, -1),
-	EffectDesc("WildSurgeModifier", fx_wild_surge_modifier, 0, -1),
+	EffectDesc("WildSurgeModifier", fx_wild_surge_modifier, EFFECT_STAT_ONLY, -1),
 	EffectDesc("WingBuffet", fx_wing_buffet, 0, -1),
 	EffectDesc("WisdomModifier", fx_wisdom_modifier, EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("WizardSpellSlotsModifier", fx_bonus_wizard_spells, 0, -1),
@@ -7316,6 +7316,7 @@ int fx_modify_global_variable(Scriptable* /*Owner*/, Actor* /*target*/, Effect*
 	} else {
 		game->locals[key] = fx->Parameter1;
 	}
+	Game::VariablesChanged();
 	return FX_NOT_APPLIED;
 }
 
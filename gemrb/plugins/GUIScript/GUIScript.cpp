@@ -26,6 +26,7 @@
 #include "DialogHandler.h"
 #include "DisplayMessage.h"
 #include "EffectQueue.h"
+#include "FrameProfiler.h"
 #include "Game.h"
 #include "GameData.h"
 #include "ImageFactory.h"
@@ -4461,7 +4462,7 @@ static PyObject* GemRB_SaveGame_GetPreview(PyObject* /*self*/, PyObject* args)
 	PARSE_ARGS(args, "O", &Slot);
 
 	Holder<SaveGame> save = CObject<SaveGame>(Slot);
-	return PyObject_FromHolder<Sprite2D>(save->GetPreview());
+	return PyObject_FromHolder<Sprite2D>(core->GetSaveGameIterator()->GetPreview(save));
 }
 
 PyDoc_STRVAR(GemRB_SaveGame_GetPortrait__doc,
@@ -4486,7 +4487,7 @@ static PyObject* GemRB_SaveGame_GetPortrait(PyObject* /*self*/, PyObject* args)
 	PARSE_ARGS(args, "Oi", &Slot, &index);
 
 	Holder<SaveGame> save = CObject<SaveGame>(Slot);
-	return PyObject_FromHolder<Sprite2D>(save->GetPortrait(index));
+	return PyObject_FromHolder<Sprite2D>(core->GetSaveGameIterator()->GetPortrait(save, index));
 }
 
 PyDoc_STRVAR(GemRB_GetGamePreview__doc,
@@ -7873,6 +7874,41 @@ static PyObject* GemRB_ConsoleWindowLog(PyObject* /*self*/, PyObject* args)
 	Py_RETURN_NONE;
 }
 
+PyDoc_STRVAR(GemRB_ProfileFrames__doc,
+	     "ProfileFrames(enable[, csvPath])\n\n"
+	     "Enable/Disable the frame profiler overlay. If csvPath is given, the recorded\n"
+	     "frame history is written there first, in microseconds.");
+
+static PyObject* GemRB_ProfileFrames(PyObject* /*self*/, PyObject* args)
+{
+	int enable = 1;
+	const char* csvPath = nullptr;
+	PARSE_ARGS(args, "i|s", &enable, &csvPath);
+
+	FrameProfiler& profiler = FrameProfiler::Get();
+	if (csvPath && !profiler.DumpCSV(csvPath)) {
+		return RuntimeError(fmt::format("Unable to write the frame profile to {}!", csvPath));
+	}
+	profiler.SetEnabled(enable);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(GemRB_GetStringCacheStats__doc,
+	     "GetStringCacheStats()\n\n"
+	     "Returns the lookup cache statistics of the loaded TLK files.");
+
+static PyObject* GemRB_GetStringCacheStats(PyObject* /*self*/, PyObject* /*args*/)
+{
+	std::string stats;
+	if (core->strings) {
+		stats = core->strings->GetCacheStats();
+	}
+	if (core->strings2 && core->strings2 != core->strings) {
+		stats += "\n" + core->strings2->GetCacheStats();
+	}
+	return PyString_FromStringObj(stats);
+}
+
 PyDoc_STRVAR(GemRB_GetCurrentArea__doc,
 	     "===== GetCurrentArea =====\n\
 \n\
@@ -12674,6 +12710,7 @@ static PyMethodDef GemRBMethods[] = {
 	METHOD(GetMemorizedSpellsCount, METH_VARARGS),
 	METHOD(GetMultiClassPenalty, METH_VARARGS),
 	METHOD(ConsoleWindowLog, METH_VARARGS),
+	METHOD(ProfileFrames, METH_VARARGS),
 	METHOD(GetModalState, METH_VARARGS),
 	METHOD(GetPartySize, METH_NOARGS),
 	METHOD(GetPCStats, METH_VARARGS),
@@ -12705,6 +12742,7 @@ static PyMethodDef GemRBMethods[] = {
 	METHOD(GetSprite, METH_VARARGS),
 	METHOD(GetSlotItem, METH_VARARGS),
 	METHOD(GetSlots, METH_VARARGS),
+	METHOD(GetStringCacheStats, METH_NOARGS),
 	METHOD(GetSystemVariable, METH_VARARGS),
 	METHOD(GetToken, METH_VARARGS),
 	METHOD(GetVar, METH_VARARGS),
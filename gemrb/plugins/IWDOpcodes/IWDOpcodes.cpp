@@ -280,15 +280,15 @@ static EffectDesc effectnames[] = {
 	EffectDesc("BeholderDispelMagic", fx_beholder_dispel_magic, 0, -1), //125
 	EffectDesc("HarpyWail", fx_harpy_wail, 0, -1), //126
 	EffectDesc("JackalWereGaze", fx_jackalwere_gaze, 0, -1), //127
-	EffectDesc("UseMagicDeviceModifier", fx_use_magic_device_modifier, 0, -1), //12a
+	EffectDesc("UseMagicDeviceModifier", fx_use_magic_device_modifier, EFFECT_STAT_ONLY, -1), //12a
 	//unhardcoded hacks for IWD2
-	EffectDesc("AnimalEmpathyModifier", fx_animal_empathy_modifier, 0, -1), //12b
-	EffectDesc("BluffModifier", fx_bluff_modifier, 0, -1), //12c
-	EffectDesc("ConcentrationModifier", fx_concentration_modifier, 0, -1), //12d
-	EffectDesc("DiplomacyModifier", fx_diplomacy_modifier, 0, -1), //12e
-	EffectDesc("IntimidateModifier", fx_intimidate_modifier, 0, -1), //12f
-	EffectDesc("SearchModifier", fx_search_modifier, 0, -1), //130
-	EffectDesc("SpellcraftModifier", fx_spellcraft_modifier, 0, -1), //131
+	EffectDesc("AnimalEmpathyModifier", fx_animal_empathy_modifier, EFFECT_STAT_ONLY, -1), //12b
+	EffectDesc("BluffModifier", fx_bluff_modifier, EFFECT_STAT_ONLY, -1), //12c
+	EffectDesc("ConcentrationModifier", fx_concentration_modifier, EFFECT_STAT_ONLY, -1), //12d
+	EffectDesc("DiplomacyModifier", fx_diplomacy_modifier, EFFECT_STAT_ONLY, -1), //12e
+	EffectDesc("IntimidateModifier", fx_intimidate_modifier, EFFECT_STAT_ONLY, -1), //12f
+	EffectDesc("SearchModifier", fx_search_modifier, EFFECT_STAT_ONLY, -1), //130
+	EffectDesc("SpellcraftModifier", fx_spellcraft_modifier, EFFECT_STAT_ONLY, -1), //131
 	//iwd2 effects
 	EffectDesc("Hopelessness", fx_hopelessness, 0, -1), //400
 	EffectDesc("ProtectionFromEvil", fx_protection_from_evil, 0, -1), //401
@@ -1876,6 +1876,7 @@ static int fx_cutscene(Scriptable* /*Owner*/, Actor* /*target*/, Effect* /*fx*/)
 	// print("fx_cutscene(%2d)", fx->Opcode);
 	Game* game = core->GetGame();
 	game->locals["GEM_ACTIVE"] = 1;
+	Game::VariablesChanged();
 	return FX_NOT_APPLIED;
 }
 
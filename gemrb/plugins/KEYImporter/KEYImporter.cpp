@@ -91,6 +91,31 @@ static void FindBIF(BIFEntry* entry)
 	Log(ERROR, "KEYImporter", "Cannot find {}...", entry->name);
 }
 
+KEYImporter::~KEYImporter()
+{
+	stopWarmUp = true;
+	if (warmUpThread.joinable()) {
+		warmUpThread.join();
+	}
+}
+
+// opening a compressed archive decompresses it into the cache, so later
+// lookups only have to map the result
+void KEYImporter::WarmUpCache()
+{
+	size_t count = 0;
+	for (const auto& bif : biffiles) {
+		if (stopWarmUp) return;
+		if (!bif.found) continue;
+
+		PluginHolder<IndexedArchive> archive = MakePluginHolder<IndexedArchive>(IE_BIF_CLASS_ID);
+		if (archive && archive->OpenArchive(bif.path) == GEM_OK) {
+			++count;
+		}
+	}
+	Log(MESSAGE, "KEYImporter", "Cache warm-up done, went through {} archives.", count);
+}
+
 bool KEYImporter::Open(const path_t& resfile, std::string desc)
 {
 	description = std::move(desc);
@@ -179,6 +204,10 @@ bool KEYImporter::Open(const path_t& resfile, std::string desc)
 
 	Log(MESSAGE, "KEYImporter", "Resources Loaded...");
 	delete f;
+
+	if (core->config.WarmUpCache && !warmUpThread.joinable()) {
+		warmUpThread = std::thread(&KEYImporter::WarmUpCache, this);
+	}
 	return true;
 }
 
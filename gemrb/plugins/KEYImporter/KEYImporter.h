@@ -28,6 +28,8 @@
 #include "Plugins/IndexedArchive.h"
 #include "System/VFS.h"
 
+#include <atomic>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -86,10 +88,20 @@ private:
 	std::vector<BIFEntry> biffiles;
 	std::unordered_map<MapKey, ieDword, MapKeyHash> resources;
 
+	// fills the BIF cache in the background (WarmUpCache)
+	std::thread warmUpThread;
+	std::atomic<bool> stopWarmUp { false };
+
 	/** Gets the stream associated to a RESKey */
 	DataStream* GetStream(const ResRef&, ieWord type);
+	void WarmUpCache();
 
 public:
+	KEYImporter() noexcept = default;
+	KEYImporter(const KEYImporter&) = delete;
+	~KEYImporter() override;
+	KEYImporter& operator=(const KEYImporter&) = delete;
+
 	bool Open(const path_t& file, std::string desc) override;
 	/* predicts the availability of a resource */
 	bool HasResource(StringView resname, SClass_ID type) override;
@@ -97,6 +109,7 @@ public:
 	/* returns resource */
 	DataStream* GetResource(StringView resname, SClass_ID type) override;
 	DataStream* GetResource(StringView resname, const ResourceDesc& type) override;
+	bool HasFixedContents() const override { return true; }
 };
 
 }
@@ -32,6 +32,7 @@ public:
 	bool HasResource(StringView resname, const ResourceDesc& type) override;
 	DataStream* GetResource(StringView resname, SClass_ID type) override;
 	DataStream* GetResource(StringView resname, const ResourceDesc& type) override;
+	bool HasFixedContents() const override { return true; }
 };
 
 }
@@ -0,0 +1,473 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "NullVideo.h"
+
+#include "ImageWriter.h"
+#include "Interface.h"
+#include "MurmurHash.h"
+#include "PluginMgr.h"
+#include "Polygon.h"
+#include "Sprite2D.h"
+
+#include "Logging/Logging.h"
+#include "Streams/FileStream.h"
+
+#include <algorithm>
+
+using namespace GemRB;
+
+NullVideoBuffer::NullVideoBuffer(const Region& r, bool rasterize, bool alpha)
+	: VideoBuffer(r), hasAlpha(alpha)
+{
+	if (rasterize) {
+		pixels.resize(r.size.Area());
+	}
+}
+
+void NullVideoBuffer::Clear(const Region& rgn)
+{
+	if (!Rasterized()) return;
+
+	Region r = rgn.Intersect(Region(Point(), rect.size));
+	for (int y = r.y; y < r.y + r.h; ++y) {
+		std::fill_n(Row(y) + r.x, r.w, Color());
+	}
+}
+
+void NullVideoBuffer::CopyPixels(const Region&, const void*, const int*, ...)
+{
+	// only movies use this and they are not worth decoding here
+}
+
+bool NullVideoBuffer::RenderOnDisplay(void* display) const
+{
+	NullVideoBuffer* target = static_cast<NullVideoBuffer*>(display);
+	if (!Rasterized() || !target->Rasterized()) return true;
+
+	Region r = rect.Intersect(Region(Point(), target->rect.size));
+	for (int y = r.y; y < r.y + r.h; ++y) {
+		const Color* src = Row(y - rect.y) + (r.x - rect.x);
+		Color* dst = target->Row(y) + r.x;
+		for (int x = 0; x < r.w; ++x) {
+			if (hasAlpha) {
+				ShaderBlend<false>(src[x], dst[x]);
+			} else {
+				dst[x] = src[x];
+			}
+		}
+	}
+	return true;
+}
+
+// mirrors the shading of the SDL 1.2 software renderer
+template<typename BLENDER>
+static void BlitPixels(Sprite2D::Iterator& it, NullVideoBuffer& target, const Region& dst, const BLENDER& blender, uint8_t alpha)
+{
+	for (int y = dst.y; y < dst.y + dst.h; ++y) {
+		Color* row = target.Row(y) + dst.x;
+		for (int x = 0; x < dst.w; ++x, ++it) {
+			Color c = it.ReadRGBA();
+			if (alpha != 255) {
+				c.a = (c.a * alpha) / 255;
+			}
+			blender(c, row[x], 0);
+		}
+	}
+}
+
+template<SHADER SHADE>
+static void BlitPixels(Sprite2D::Iterator& it, NullVideoBuffer& target, const Region& dst, BlitFlags flags, const Color& tint, uint8_t alpha)
+{
+	void (*blendFn)(const Color& src, Color& dst) = ShaderBlend<true>;
+	if (flags & BlitFlags::ADD) {
+		blendFn = ShaderAdditive;
+	} else if (flags & BlitFlags::MOD) {
+		blendFn = ShaderTint;
+	}
+
+	if (flags & BlitFlags::COLOR_MOD) {
+		RGBBlendingPipeline<SHADE == SHADER::NONE ? SHADER::TINT : SHADE, true> blender(tint, blendFn);
+		BlitPixels(it, target, dst, blender, alpha);
+	} else {
+		RGBBlendingPipeline<SHADE, true> blender(blendFn);
+		BlitPixels(it, target, dst, blender, alpha);
+	}
+}
+
+NullVideoDriver::~NullVideoDriver()
+{
+	// the game clock goes back to normal, so anything running after us still works
+	ManualTime = 0;
+
+	if (!frameCount) return;
+	Log(MESSAGE, "NullVideo", "Drew {} frames, {:.1f} draw calls and {:.1f} KiB per frame on average, at most {} and {:.1f} KiB.",
+	    frameCount, double(totals.drawCalls) / frameCount, totals.bytes / 1024.0 / frameCount,
+	    maxima.drawCalls, maxima.bytes / 1024.0);
+}
+
+int NullVideoDriver::Init()
+{
+	rasterize = core->config.NullVideoRaster;
+	dumpInterval = std::max(core->config.NullVideoDumpInterval, 0);
+	frameLimit = std::max(core->config.NullVideoFrames, 0);
+	if (dumpInterval && !rasterize) {
+		Log(WARNING, "NullVideo", "Frame dumps need NullVideoRaster, they will be empty.");
+	}
+	return GEM_OK;
+}
+
+int NullVideoDriver::CreateDriverDisplay(const char*, bool)
+{
+	screen = std::make_unique<NullVideoBuffer>(Region(Point(), screenSize), rasterize, false);
+	// from now on time only advances with the frames
+	ManualTime = GetMilliseconds();
+	return GEM_OK;
+}
+
+bool NullVideoDriver::SetFullscreenMode(bool set)
+{
+	fullscreen = set;
+	return true;
+}
+
+VideoBuffer* NullVideoDriver::NewVideoBuffer(const Region& r, BufferFormat fmt)
+{
+	bool alpha = fmt == BufferFormat::DISPLAY_ALPHA || fmt == BufferFormat::RGBA8888;
+	return new NullVideoBuffer(r, rasterize, alpha);
+}
+
+void NullVideoDriver::SwapBuffers(VideoBuffers& buffers)
+{
+	if (rasterize) {
+		screen->VideoBuffer::Clear();
+		for (const VideoBuffer* buffer : buffers) {
+			buffer->RenderOnDisplay(screen.get());
+		}
+	}
+
+	++frameCount;
+	totals.drawCalls += frame.drawCalls;
+	totals.bytes += frame.bytes;
+	maxima.drawCalls = std::max(maxima.drawCalls, frame.drawCalls);
+	maxima.bytes = std::max(maxima.bytes, frame.bytes);
+	lastFrame = frame;
+	frame = FrameStats();
+
+	if (dumpInterval && frameCount % dumpInterval == 0) {
+		DumpFrame();
+	}
+
+	// exactly one game tick per frame
+	ManualTime += 1000 / core->Time.ticksPerSec;
+}
+
+int NullVideoDriver::PollEvents()
+{
+	if (frameLimit && frameCount >= frameLimit) {
+		Log(MESSAGE, "NullVideo", "Reached the frame limit of {}.", frameLimit);
+		return GEM_ERROR;
+	}
+	return GEM_OK;
+}
+
+void NullVideoDriver::DumpFrame()
+{
+	// the hash is enough to compare runs, the images are for looking at the differences
+	Hasher hasher;
+	if (screen->Rasterized()) {
+		for (const Color& c : screen->pixels) {
+			hasher.Feed(c.r | (c.g << 8) | (c.b << 16));
+		}
+	}
+	Log(MESSAGE, "NullVideo", "Frame {}: {} draw calls, {} bytes, hash {:08x}.",
+	    frameCount, lastFrame.drawCalls, lastFrame.bytes, hasher.GetHash().value);
+
+	if (core->config.NullVideoDumpPath.empty()) return;
+
+	PluginHolder<ImageWriter> im = MakePluginHolder<ImageWriter>(PLUGIN_IMAGE_WRITER_BMP);
+	if (!im) return;
+
+	path_t name = fmt::format("frame{:06d}", frameCount);
+	FileStream out;
+	if (!out.Create(core->config.NullVideoDumpPath, name, IE_BMP_CLASS_ID)) {
+		Log(ERROR, "NullVideo", "Unable to write {} to {}!", name, core->config.NullVideoDumpPath);
+		return;
+	}
+	im->PutImage(&out, GetScreenshot(Region()));
+}
+
+NullVideoBuffer* NullVideoDriver::CurrentBuffer() const
+{
+	return static_cast<NullVideoBuffer*>(drawingBuffer);
+}
+
+void NullVideoDriver::Count(int pixels)
+{
+	++frame.drawCalls;
+	frame.bytes += uint64_t(std::max(pixels, 0)) * 4;
+}
+
+Holder<Sprite2D> NullVideoDriver::CreateSprite(const Region& rgn, void* pixels, const PixelFormat& fmt)
+{
+	// RLE data is walked by pixels, everything else by bytes
+	uint16_t pitch = fmt.RLE ? rgn.w : rgn.w * fmt.Bpp;
+	if (!pixels) {
+		// like the SDL drivers, provide a cleared image to write into
+		pixels = calloc(rgn.h, pitch);
+	}
+	return MakeHolder<Sprite2D>(rgn, pixels, fmt, pitch);
+}
+
+void NullVideoDriver::BlitSprite(const Holder<Sprite2D>& spr, const Region& src, Region dst,
+				 BlitFlags flags, Color tint)
+{
+	dst.x -= spr->Frame.x;
+	dst.y -= spr->Frame.y;
+	BlitSpriteClipped(spr, src, dst, flags, tint);
+}
+
+void NullVideoDriver::BlitGameSprite(const Holder<Sprite2D>& spr, const Point& p,
+				     BlitFlags flags, Color tint)
+{
+	if (!spr) return;
+
+	Region src(Point(), spr->Frame.size);
+	Region dst(p - spr->Frame.origin, spr->Frame.size);
+	BlitSpriteClipped(spr, src, dst, flags, tint);
+}
+
+void NullVideoDriver::BlitSpriteClipped(const Holder<Sprite2D>& spr, Region src, const Region& dst, BlitFlags flags, Color tint)
+{
+	Region clipped = ClippedDrawingRect(dst);
+	if (clipped.size.IsInvalid() || clipped.w == 0 || clipped.h == 0) return;
+	Count(clipped.size.Area());
+
+	NullVideoBuffer* target = CurrentBuffer();
+	if (!target->Rasterized()) return;
+
+	// drop the clipped off part of the source, from the other side if it is mirrored
+	bool mirrorX = (flags ^ spr->renderFlags) & BlitFlags::MIRRORX;
+	bool mirrorY = (flags ^ spr->renderFlags) & BlitFlags::MIRRORY;
+	int left = clipped.x - dst.x;
+	int right = dst.w - clipped.w - left;
+	int top = clipped.y - dst.y;
+	int bottom = dst.h - clipped.h - top;
+	src.x += mirrorX ? right : left;
+	src.y += mirrorY ? bottom : top;
+	src.w = clipped.w;
+	src.h = clipped.h;
+
+	// the iterator applies the mirroring of the sprite itself
+	IPixelIterator::Direction xdir = (flags & BlitFlags::MIRRORX) ? IPixelIterator::Reverse : IPixelIterator::Forward;
+	IPixelIterator::Direction ydir = (flags & BlitFlags::MIRRORY) ? IPixelIterator::Reverse : IPixelIterator::Forward;
+	const Sprite2D* sprite = spr.get();
+	Sprite2D::Iterator it = sprite->GetIterator(xdir, ydir, src);
+
+	flags |= spr->renderFlags & BlitFlags::BLEND_MASK;
+	uint8_t alpha = (flags & BlitFlags::ALPHA_MOD) ? tint.a : 255;
+	if (flags & BlitFlags::HALFTRANS) {
+		alpha /= 2;
+	}
+
+	if (flags & BlitFlags::GREY) {
+		BlitPixels<SHADER::GREYSCALE>(it, *target, clipped, flags, tint, alpha);
+	} else if (flags & BlitFlags::SEPIA) {
+		BlitPixels<SHADER::SEPIA>(it, *target, clipped, flags, tint, alpha);
+	} else {
+		BlitPixels<SHADER::NONE>(it, *target, clipped, flags, tint, alpha);
+	}
+}
+
+void NullVideoDriver::BlitVideoBuffer(const VideoBufferPtr& buf, const Point& p, BlitFlags flags, Color tint)
+{
+	const NullVideoBuffer* source = static_cast<const NullVideoBuffer*>(buf.get());
+	Region dst(buf->Origin() + p, buf->Size());
+	Region clipped = ClippedDrawingRect(dst);
+	if (clipped.size.IsInvalid()) return;
+	Count(clipped.size.Area());
+
+	NullVideoBuffer* target = CurrentBuffer();
+	if (!target->Rasterized() || !source->Rasterized()) return;
+
+	uint8_t alpha = (flags & BlitFlags::ALPHA_MOD) ? tint.a : 255;
+	if (flags & BlitFlags::HALFTRANS) {
+		alpha /= 2;
+	}
+	bool blend = (flags & BlitFlags::BLENDED) || alpha != 255;
+	for (int y = clipped.y; y < clipped.y + clipped.h; ++y) {
+		const Color* src = source->Row(y - dst.y) + (clipped.x - dst.x);
+		Color* row = target->Row(y) + clipped.x;
+		for (int x = 0; x < clipped.w; ++x) {
+			Color c = src[x];
+			if (flags & BlitFlags::COLOR_MOD) {
+				ShaderTint(tint, c);
+			}
+			if (blend) {
+				c.a = (c.a * alpha) / 255;
+				ShaderBlend<true>(c, row[x]);
+			} else {
+				row[x] = c;
+			}
+		}
+	}
+}
+
+Holder<Sprite2D> NullVideoDriver::GetScreenshot(Region r, const VideoBufferPtr& buf)
+{
+	const NullVideoBuffer* source = buf ? static_cast<const NullVideoBuffer*>(buf.get()) : screen.get();
+	int width = r.w ? r.w : source->Size().w;
+	int height = r.h ? r.h : source->Size().h;
+
+	uint32_t* pixels = static_cast<uint32_t*>(calloc(width * height, sizeof(uint32_t)));
+	if (source->Rasterized()) {
+		Region area = Region(r.origin, Size(width, height)).Intersect(Region(Point(), source->Size()));
+		for (int y = area.y; y < area.y + area.h; ++y) {
+			const Color* src = source->Row(y) + area.x;
+			uint32_t* dst = pixels + (y - r.y) * width + (area.x - r.x);
+			for (int x = 0; x < area.w; ++x) {
+				dst[x] = 0xff000000 | (src[x].r << 16) | (src[x].g << 8) | src[x].b;
+			}
+		}
+	}
+	return MakeHolder<Sprite2D>(Region(0, 0, width, height), pixels, PixelFormat::ARGB32Bit(), width * 4);
+}
+
+void NullVideoDriver::FillSpan(int x, int y, int w, const Color& color, BlitFlags flags)
+{
+	NullVideoBuffer* target = CurrentBuffer();
+	Region clipped = ClippedDrawingRect(Region(x, y, w, 1));
+	if (clipped.w <= 0 || clipped.h <= 0) return;
+	frame.bytes += uint64_t(clipped.w) * 4;
+	if (!target->Rasterized()) return;
+
+	Color* row = target->Row(clipped.y) + clipped.x;
+	for (int i = 0; i < clipped.w; ++i) {
+		if (flags & BlitFlags::MOD) {
+			ShaderTint(color, row[i]);
+		} else if (flags & BlitFlags::BLENDED) {
+			ShaderBlend<true>(color, row[i]);
+		} else {
+			row[i] = color;
+		}
+	}
+}
+
+void NullVideoDriver::DrawRectImp(const Region& rgn, const Color& color, bool fill, BlitFlags flags)
+{
+	++frame.drawCalls;
+	if (fill) {
+		for (int y = rgn.y; y < rgn.y + rgn.h; ++y) {
+			FillSpan(rgn.x, y, rgn.w, color, flags);
+		}
+		return;
+	}
+
+	FillSpan(rgn.x, rgn.y, rgn.w, color, flags);
+	FillSpan(rgn.x, rgn.y + rgn.h - 1, rgn.w, color, flags);
+	for (int y = rgn.y + 1; y < rgn.y + rgn.h - 1; ++y) {
+		FillSpan(rgn.x, y, 1, color, flags);
+		FillSpan(rgn.x + rgn.w - 1, y, 1, color, flags);
+	}
+}
+
+void NullVideoDriver::DrawPointImp(const BasePoint& p, const Color& color, BlitFlags flags)
+{
+	++frame.drawCalls;
+	FillSpan(p.x, p.y, 1, color, flags);
+}
+
+void NullVideoDriver::DrawPointsImp(const std::vector<BasePoint>& points, const Color& color, BlitFlags flags)
+{
+	++frame.drawCalls;
+	for (const BasePoint& p : points) {
+		FillSpan(p.x, p.y, 1, color, flags);
+	}
+}
+
+void NullVideoDriver::DrawCircleImp(const Point& origin, uint16_t r, const Color& color, BlitFlags flags)
+{
+	DrawPointsImp(PlotCircle(origin, r), color, flags);
+}
+
+void NullVideoDriver::DrawEllipseImp(const Region& rect, const Color& color, BlitFlags flags)
+{
+	DrawPointsImp(PlotEllipse(rect), color, flags);
+}
+
+void NullVideoDriver::DrawPolygonImp(const Gem_Polygon* poly, const Point& origin, const Color& color, bool fill, BlitFlags flags)
+{
+	if (!fill) {
+		// close the polygon with the first point
+		std::vector<Point> points = poly->vertices;
+		points.push_back(poly->vertices.front());
+		for (Point& p : points) {
+			p = p - poly->BBox.origin + origin;
+		}
+		DrawLinesImp(points, color, flags);
+		return;
+	}
+
+	++frame.drawCalls;
+	for (const auto& row : poly->rasterData) {
+		for (const auto& segment : row) {
+			const Point& p = segment.first + origin;
+			FillSpan(p.x, p.y, segment.second.x - segment.first.x + 1, color, flags);
+		}
+	}
+}
+
+void NullVideoDriver::DrawLineImp(const BasePoint& start, const BasePoint& end, const Color& color, BlitFlags flags)
+{
+	++frame.drawCalls;
+	// Bresenham
+	int dx = std::abs(end.x - start.x);
+	int dy = -std::abs(end.y - start.y);
+	int sx = start.x < end.x ? 1 : -1;
+	int sy = start.y < end.y ? 1 : -1;
+	int err = dx + dy;
+	BasePoint p = start;
+	while (true) {
+		FillSpan(p.x, p.y, 1, color, flags);
+		if (p.x == end.x && p.y == end.y) break;
+		int e2 = 2 * err;
+		if (e2 >= dy) {
+			err += dy;
+			p.x += sx;
+		}
+		if (e2 <= dx) {
+			err += dx;
+			p.y += sy;
+		}
+	}
+}
+
+void NullVideoDriver::DrawLinesImp(const std::vector<Point>& points, const Color& color, BlitFlags flags)
+{
+	for (size_t i = 1; i < points.size(); ++i) {
+		DrawLineImp(points[i - 1], points[i], color, flags);
+	}
+}
+
+#include "plugindef.h"
+
+GEMRB_PLUGIN(0x4E5D1D0, "Null Video Driver")
+PLUGIN_DRIVER(NullVideoDriver, "none")
+END_PLUGIN()
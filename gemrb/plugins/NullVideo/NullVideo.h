@@ -0,0 +1,125 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2026 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef NULLVIDEO_H
+#define NULLVIDEO_H
+
+#include "Video/Video.h"
+
+#include <memory>
+#include <vector>
+
+namespace GemRB {
+
+// plain memory buffer, the pixels are only allocated when the driver rasterizes
+class NullVideoBuffer : public VideoBuffer {
+public:
+	std::vector<Color> pixels;
+	bool hasAlpha;
+
+	NullVideoBuffer(const Region& r, bool rasterize, bool alpha);
+
+	Color* Row(int y) { return &pixels[y * rect.w]; }
+	const Color* Row(int y) const { return &pixels[y * rect.w]; }
+	bool Rasterized() const { return !pixels.empty(); }
+
+	void Clear(const Region& rgn) override;
+	void CopyPixels(const Region& bufDest, const void* pixelBuf, const int* pitch = nullptr, ...) override;
+	bool RenderOnDisplay(void* display) const override;
+};
+
+// Video driver without a display, for benchmarks and automated tests on
+// machines without one. Every frame advances the game clock by exactly one
+// tick, so the game runs as fast as it can and repeated runs match. Drawing
+// is either only counted or also rasterized in software, so frames can be
+// dumped and compared.
+class NullVideoDriver : public Video {
+public:
+	struct FrameStats {
+		uint32_t drawCalls = 0;
+		uint64_t bytes = 0; // written to the buffers, 4 per pixel
+	};
+
+	NullVideoDriver() noexcept = default;
+	NullVideoDriver(const NullVideoDriver&) = delete;
+	~NullVideoDriver() override;
+	NullVideoDriver& operator=(const NullVideoDriver&) = delete;
+
+	int Init() override;
+	void SetWindowTitle(const char*) override {}
+	bool SetFullscreenMode(bool set) override;
+	bool ToggleGrabInput() override { return false; }
+	void CaptureMouse(bool) override {}
+	int GetDisplayRefreshRate() const override { return 0; }
+	int GetVirtualRefreshCap() const override { return 0; }
+
+	void StartTextInput() override {}
+	void StopTextInput() override {}
+	bool InTextInput() override { return false; }
+	bool TouchInputEnabled() override { return false; }
+
+	Holder<Sprite2D> CreateSprite(const Region&, void* pixels, const PixelFormat&) override;
+	void BlitSprite(const Holder<Sprite2D>& spr, const Region& src, Region dst,
+			BlitFlags flags, Color tint = Color()) override;
+	void BlitGameSprite(const Holder<Sprite2D>& spr, const Point& p,
+			    BlitFlags flags, Color tint = Color()) override;
+	void BlitVideoBuffer(const VideoBufferPtr& buf, const Point& p, BlitFlags flags,
+			     Color tint = Color()) override;
+	Holder<Sprite2D> GetScreenshot(Region r, const VideoBufferPtr& buf = nullptr) override;
+	void SetGamma(int, int) override {}
+
+	const FrameStats& GetLastFrameStats() const { return lastFrame; }
+
+private:
+	bool rasterize = false;
+	unsigned int dumpInterval = 0;
+	unsigned int frameLimit = 0;
+	unsigned long frameCount = 0;
+	FrameStats frame;
+	FrameStats lastFrame;
+	FrameStats totals;
+	FrameStats maxima;
+	std::unique_ptr<NullVideoBuffer> screen;
+
+	VideoBuffer* NewVideoBuffer(const Region&, BufferFormat) override;
+	void SwapBuffers(VideoBuffers&) override;
+	int PollEvents() override;
+	int CreateDriverDisplay(const char* title, bool vsync) override;
+	void Wait(uint32_t) override {}
+
+	void DrawRectImp(const Region& rgn, const Color& color, bool fill, BlitFlags flags) override;
+	void DrawPointImp(const BasePoint&, const Color& color, BlitFlags flags) override;
+	void DrawPointsImp(const std::vector<BasePoint>& points, const Color& color, BlitFlags flags) override;
+	void DrawCircleImp(const Point& origin, uint16_t r, const Color& color, BlitFlags flags) override;
+	void DrawEllipseImp(const Region& rect, const Color& color, BlitFlags flags) override;
+	void DrawPolygonImp(const Gem_Polygon* poly, const Point& origin, const Color& color, bool fill, BlitFlags flags) override;
+	void DrawLineImp(const BasePoint& start, const BasePoint& end, const Color& color, BlitFlags flags) override;
+	void DrawLinesImp(const std::vector<Point>& points, const Color& color, BlitFlags flags) override;
+
+	NullVideoBuffer* CurrentBuffer() const;
+	void Count(int pixels);
+	void FillSpan(int x, int y, int w, const Color& color, BlitFlags flags);
+	void BlitSpriteClipped(const Holder<Sprite2D>& spr, Region src, const Region& dst, BlitFlags flags, Color tint);
+	void DumpFrame();
+};
+
+}
+
+#endif
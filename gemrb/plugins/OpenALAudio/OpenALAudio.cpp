@@ -334,6 +334,7 @@ bool OpenALAudioDriver::Init(void)
 	alListenerf(AL_GAIN, 1.25f);
 
 	ambim = new AmbientMgr;
+	soundCache = std::make_unique<SoundCache>();
 	return true;
 }
 
@@ -471,12 +472,12 @@ std::pair<ALuint, ALuint> OpenALAudioDriver::loadSound(StringView ResRef, tick_t
 
 	ALuint buffers[2] = { 0, 0 };
 
-	ResourceHolder<SoundMgr> acm = gamedata->GetResourceHolder<SoundMgr>(ResRef);
-	if (!acm) {
+	SoundCache::Sound sound = soundCache->Get(ResRef);
+	if (!sound) {
 		return { 0, 0 };
 	}
 
-	unsigned int channels = acm->get_channels();
+	int channels = sound->channels;
 	assert(channels <= 2);
 	bool spatialStereo = channels > 1 && spatial;
 
@@ -485,34 +486,28 @@ std::pair<ALuint, ALuint> OpenALAudioDriver::loadSound(StringView ResRef, tick_t
 		return { 0, 0 };
 	}
 
-	int samplerate = acm->get_samplerate();
-	auto numSamples = acm->get_length();
-	auto totalBytesPerChannel = numSamples * 2;
+	int samplerate = sound->samplerate;
 
 	// Positional sound doesn't work for stereo in all known implementations
 	// so make two sources and play them in parallel: https://openal.org/pipermail/openal/2016-August/000527.html
 	if (spatialStereo) {
-		std::vector<char> channel1;
-		std::vector<char> channel2;
-		channel1.resize(totalBytesPerChannel);
-		channel2.resize(totalBytesPerChannel);
-		auto actualSamples = acm->ReadSamplesIntoChannels(channel1.data(), channel2.data(), numSamples);
+		size_t frames = sound->GetFrames();
+		std::vector<short> channel1(frames);
+		std::vector<short> channel2(frames);
+		for (size_t i = 0; i < frames; ++i) {
+			channel1[i] = sound->samples[i * 2];
+			channel2[i] = sound->samples[i * 2 + 1];
+		}
 
 		auto format = GetFormatEnum(1, 16);
-		alBufferData(buffers[0], format, channel1.data(), actualSamples * 2, samplerate);
-		alBufferData(buffers[1], format, channel2.data(), actualSamples * 2, samplerate);
+		alBufferData(buffers[0], format, channel1.data(), ALsizei(frames * 2), samplerate);
+		alBufferData(buffers[1], format, channel2.data(), ALsizei(frames * 2), samplerate);
 	} else {
-		std::vector<short> memory;
-		memory.resize(totalBytesPerChannel / sizeof(short));
-
-		// multiply always with 2 because it is in 16 bits
-		unsigned int cnt1 = acm->read_samples(memory.data(), numSamples) * 2;
-		// it is always reading the stuff into 16 bits
-		alBufferData(buffers[0], GetFormatEnum(channels, 16), memory.data(), cnt1, samplerate);
+		// it is always decoded into 16 bits
+		alBufferData(buffers[0], GetFormatEnum(channels, 16), sound->samples.data(), ALsizei(sound->GetSize()), samplerate);
 	}
 
-	// Sound length in milliseconds
-	time_length = ((numSamples / channels) * 1000) / samplerate;
+	time_length = sound->length;
 
 	if (checkALError("Unable to fill buffer", ERROR)) {
 		alDeleteBuffers(spatialStereo ? 2 : 1, buffers);
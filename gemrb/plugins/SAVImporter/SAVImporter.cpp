@@ -23,9 +23,19 @@
 #include "PluginMgr.h"
 
 #include "Logging/Logging.h"
+#include "Streams/BufferStream.h"
+#include "Streams/FileStream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 using namespace GemRB;
 
+// entries are compressed in batches, so only that many are held in memory
+static constexpr size_t SAV_BATCH = 32;
+static constexpr unsigned int SAV_MAX_WORKERS = 8;
+
 int SAVImporter::DecompressSaveGame(DataStream* compressed, SaveGameAREExtractor& areExtractor)
 {
 	char Signature[8];
@@ -94,7 +104,7 @@ int SAVImporter::CreateArchive(DataStream* compressed)
 	return GEM_OK;
 }
 
-int SAVImporter::AddToSaveGame(DataStream* str, DataStream* uncompressed)
+static int WriteEntry(DataStream* str, DataStream* uncompressed, const Compressor& comp)
 {
 	size_t fnlen = uncompressed->filename.length() + 1;
 	strpos_t declen = uncompressed->Size();
@@ -107,8 +117,9 @@ int SAVImporter::AddToSaveGame(DataStream* str, DataStream* uncompressed)
 	strpos_t Pos = str->GetPos(); //storing the stream position
 	str->WriteDword(complen);
 
-	PluginHolder<Compressor> comp = MakePluginHolder<Compressor>(PLUGIN_COMPRESSION_ZLIB);
-	comp->Compress(str, uncompressed);
+	if (comp.Compress(str, uncompressed) != GEM_OK) {
+		return GEM_ERROR;
+	}
 
 	//writing compressed length (calculated)
 	strpos_t Pos2 = str->GetPos();
@@ -119,6 +130,72 @@ int SAVImporter::AddToSaveGame(DataStream* str, DataStream* uncompressed)
 	return GEM_OK;
 }
 
+int SAVImporter::AddToSaveGame(DataStream* str, DataStream* uncompressed)
+{
+	PluginHolder<Compressor> comp = MakePluginHolder<Compressor>(PLUGIN_COMPRESSION_ZLIB);
+	return WriteEntry(str, uncompressed, *comp);
+}
+
+int SAVImporter::AddToSaveGame(DataStream* str, std::vector<SaveEntry>& entries)
+{
+	PluginHolder<Compressor> comp = MakePluginHolder<Compressor>(PLUGIN_COMPRESSION_ZLIB);
+	unsigned int workers = std::max(1U, std::min(std::thread::hardware_concurrency(), SAV_MAX_WORKERS));
+	std::vector<std::vector<char>> buffers(SAV_BATCH);
+	std::vector<char> written(SAV_BATCH);
+
+	for (size_t first = 0; first < entries.size(); first += SAV_BATCH) {
+		size_t count = std::min(SAV_BATCH, entries.size() - first);
+
+		// ZLibManager::Compress keeps no state, so the workers can share it
+		std::atomic<size_t> next { 0 };
+		auto compressEntries = [&]() {
+			for (size_t i = next++; i < count; i = next++) {
+				const SaveEntry& entry = entries[first + i];
+				buffers[i].clear();
+				written[i] = false;
+				if (entry.compressed) continue;
+
+				FileStream file;
+				if (!file.Open(entry.path)) {
+					Log(ERROR, "SAVImporter", "Failed to open \"{}\".", entry.path);
+					continue;
+				}
+				BufferStream dest(buffers[i]);
+				written[i] = WriteEntry(&dest, &file, *comp) == GEM_OK;
+			}
+		};
+		std::vector<std::thread> helpers;
+		for (unsigned int i = 1; i < std::min<size_t>(workers, count); ++i) {
+			helpers.emplace_back(compressEntries);
+		}
+		compressEntries();
+		for (auto& helper : helpers) {
+			helper.join();
+		}
+
+		// the archive itself is written in order, as the batches are done
+		for (size_t i = 0; i < count; ++i) {
+			SaveEntry& entry = entries[first + i];
+			entry.offset = str->GetPos();
+			if (entry.compressed) {
+				FileStream file;
+				if (!file.Open(entry.path)) {
+					Log(ERROR, "SAVImporter", "Failed to open \"{}\".", entry.path);
+					return GEM_ERROR;
+				}
+				AddToSaveGameCompressed(str, &file);
+			} else if (!written[i]) {
+				Log(ERROR, "SAVImporter", "Failed to compress \"{}\".", entry.path);
+				return GEM_ERROR;
+			} else if (str->Write(buffers[i].data(), buffers[i].size()) != strret_t(buffers[i].size())) {
+				return GEM_ERROR;
+			}
+		}
+	}
+
+	return GEM_OK;
+}
+
 int SAVImporter::AddToSaveGameCompressed(DataStream* str, DataStream* compressed)
 {
 	using BufferT = std::array<uint8_t, 4096>;
@@ -35,6 +35,7 @@ public:
 	int DecompressSaveGame(DataStream* compressed, SaveGameAREExtractor&) override;
 	int AddToSaveGame(DataStream* str, DataStream* uncompressed) override;
 	int AddToSaveGameCompressed(DataStream* str, DataStream* compressed) override;
+	int AddToSaveGame(DataStream* str, std::vector<SaveEntry>& entries) override;
 	int CreateArchive(DataStream* compressed) override;
 };
 
@@ -106,6 +106,7 @@ bool SDLAudio::Init(void)
 	Mix_QuerySpec(&audio_rate, (Uint16*) &audio_format, &audio_channels);
 	Mix_ReserveChannels(AMBIENT_CHANNELS + 1); // for speech and ambients
 	ambim = new AmbientMgr();
+	soundCache = std::make_unique<SoundCache>();
 
 	return true;
 }
@@ -182,33 +183,24 @@ Mix_Chunk* SDLAudio::loadSound(StringView ResRef, tick_t& time_length)
 		return entry->chunk;
 	}
 
-	ResourceHolder<SoundMgr> acm = gamedata->GetResourceHolder<SoundMgr>(ResRef);
-	if (!acm) {
+	SoundCache::Sound sound = soundCache->Get(ResRef);
+	if (!sound) {
 		Log(ERROR, "SDLAudio", "Failed acm load!");
 		return chunk;
 	}
-	int cnt = acm->get_length();
-	int riff_chans = acm->get_channels();
-	int samplerate = acm->get_samplerate();
-	// Use 16-bit word for memory allocation because read_samples takes a 16 bit alignment
-	short* memory = (short*) malloc(cnt * 2);
-	//multiply always with 2 because it is in 16 bits
-	int cnt1 = acm->read_samples(memory, cnt) * 2;
+	int cnt1 = int(sound->GetSize());
 	//Sound Length in milliseconds
-	time_length = ((cnt / riff_chans) * 1000) / samplerate;
+	time_length = sound->length;
 
 	// convert our buffer, if necessary
 	SDL_AudioCVT cvt;
-	SDL_BuildAudioCVT(&cvt, AUDIO_S16SYS, riff_chans, samplerate,
+	SDL_BuildAudioCVT(&cvt, AUDIO_S16SYS, sound->channels, sound->samplerate,
 			  audio_format, audio_channels, audio_rate);
 	cvt.buf = (Uint8*) malloc(cnt1 * cvt.len_mult);
-	memcpy(cvt.buf, (char*) memory, cnt1);
+	memcpy(cvt.buf, sound->samples.data(), cnt1);
 	cvt.len = cnt1;
 	SDL_ConvertAudio(&cvt);
 
-	// free old buffer
-	free(memory);
-
 	// make SDL_mixer chunk
 	chunk = Mix_QuickLoad_RAW(cvt.buf, cvt.len * cvt.len_ratio);
 	if (!chunk) {
@@ -30,6 +30,11 @@
 #include "GUI/GameControl.h"
 #include "Logging/Logging.h"
 #include "Scriptable/Actor.h"
+#include "Streams/MemoryStream.h"
+#include "System/swab.h"
+#if defined(SUPPORTS_MEMSTREAM)
+	#include "Streams/MappedFileMemoryStream.h"
+#endif
 
 #include <tuple>
 #include <utility>
@@ -94,6 +99,10 @@ bool TLKImporter::Open(DataStream* stream)
 	}
 	delete str;
 	str = stream;
+	view = nullptr;
+	viewSize = 0;
+	entries.clear();
+	entryIndex.clear();
 	char Signature[8];
 	str->Read(Signature, 8);
 	if (strncmp(Signature, "TLK\x20V1\x20\x20", 8) != 0) {
@@ -107,6 +116,7 @@ bool TLKImporter::Open(DataStream* stream)
 		Log(ERROR, "TLKImporter", "Too many strings ({}), increase OVERRIDE_START.", StrRefCount);
 		return false;
 	}
+	MapFile();
 
 	if (GetString(ieStrRef(1)).back() == u'\n') {
 		hasEndingNewline = true;
@@ -115,6 +125,128 @@ bool TLKImporter::Open(DataStream* stream)
 	return true;
 }
 
+// the entries get looked up over and over, so instead of seeking around
+// use a direct view of the whole file if possible
+void TLKImporter::MapFile()
+{
+	const MemoryStream* mem = dynamic_cast<const MemoryStream*>(str);
+#if defined(SUPPORTS_MEMSTREAM)
+	if (!mem && !str->originalfile.empty()) {
+		auto mapped = new MappedFileMemoryStream(str->originalfile);
+		if (mapped->isOk() && mapped->Size() == str->Size()) {
+			delete str;
+			str = mapped;
+			mem = mapped;
+		} else {
+			delete mapped;
+		}
+	}
+#endif
+	if (!mem || !mem->GetData()) {
+		return;
+	}
+
+	view = mem->GetData();
+	viewSize = str->Size();
+}
+
+static inline ieDword ViewDword(const char* src)
+{
+	ieDword value;
+	memcpy(&value, src, sizeof(value));
+	if (IsBigEndian()) {
+		swabs(&value, sizeof(value));
+	}
+	return value;
+}
+
+bool TLKImporter::ReadEntry(ieStrRef strref, Entry& entry) const
+{
+	ieDword StrOffset;
+	ieDword length;
+	strpos_t pos = 18 + strpos_t(ieDword(strref)) * 0x1A;
+	if (view) {
+		if (pos + 0x1A > viewSize) {
+			return false;
+		}
+		const char* raw = view + pos;
+		memcpy(&entry.type, raw, sizeof(entry.type));
+		if (IsBigEndian()) {
+			swabs(&entry.type, sizeof(entry.type));
+		}
+		entry.sound = ResRef(raw + 2);
+		RTrim(entry.sound);
+		// volume and pitch variance fields are known to be unused at minimum in bg1
+		StrOffset = ViewDword(raw + 18);
+		length = ViewDword(raw + 22);
+	} else {
+		if (str->Seek(pos, GEM_STREAM_START) == GEM_ERROR) {
+			return false;
+		}
+		ieDword Volume, Pitch;
+		str->ReadWord(entry.type);
+		str->ReadResRef(entry.sound);
+		str->ReadDword(Volume);
+		str->ReadDword(Pitch);
+		str->ReadDword(StrOffset);
+		str->ReadDword(length);
+	}
+
+	if (!(entry.type & 1)) {
+		return true;
+	}
+
+	strpos_t textPos = strpos_t(StrOffset) + Offset;
+	if (view) {
+		if (textPos > viewSize) {
+			return false;
+		}
+		length = std::min<strpos_t>(length, viewSize - textPos);
+		entry.text = StringFromTLK(StringView(view + textPos, length));
+	} else {
+		if (str->Seek(textPos, GEM_STREAM_START) == GEM_ERROR) {
+			return false;
+		}
+		std::string mbstr(length, '\0');
+		str->Read(&mbstr[0], length);
+		entry.text = StringFromTLK(mbstr);
+	}
+	entry.hasTags = entry.text.find(u'<') != String::npos;
+	return true;
+}
+
+TLKImporter::Entry* TLKImporter::LookupEntry(ieStrRef strref)
+{
+	auto lookup = entryIndex.find(strref);
+	if (lookup != entryIndex.end()) {
+		++hits;
+		entries.splice(entries.begin(), entries, lookup->second);
+		return &lookup->second->second;
+	}
+
+	++misses;
+	Entry entry;
+	if (!ReadEntry(strref, entry)) {
+		return nullptr;
+	}
+
+	if (entries.size() >= CACHE_SIZE) {
+		entryIndex.erase(entries.back().first);
+		entries.pop_back();
+	}
+	entries.emplace_front(strref, std::move(entry));
+	entryIndex[strref] = entries.begin();
+	return &entries.front().second;
+}
+
+std::string TLKImporter::GetCacheStats() const
+{
+	uint64_t total = hits + misses;
+	unsigned int rate = total ? static_cast<unsigned int>(hits * 100 / total) : 0;
+	return fmt::format("{}: {} hits, {} misses ({}%), {} reused tag resolutions, {} entries{}",
+			   str ? str->filename : "", hits, misses, rate, resolveHits, entries.size(), view ? ", mapped" : "");
+}
+
 /* -1	 - GABBER
 		0	 - PROTAGONIST
 		1-9 - PLAYERx
@@ -339,6 +471,7 @@ String TLKImporter::GetString(ieStrRef strref, STRING_FLAGS flags)
 	bool empty = !(flags & STRING_FLAGS::ALLOW_ZERO) && !strref;
 	ieWord type;
 	ResRef SoundResRef;
+	bool resolved = false;
 
 	if (empty || strref >= ieStrRef::OVERRIDE_START || (strref >= ieStrRef::BIO_START && strref <= ieStrRef::BIO_END)) {
 		if (OverrideTLK) {
@@ -350,30 +483,29 @@ String TLKImporter::GetString(ieStrRef strref, STRING_FLAGS flags)
 		type = 0;
 		SoundResRef.Reset();
 	} else {
-		ieDword Volume, Pitch, StrOffset;
-		ieDword l;
-		if (str->Seek(18 + (ieDword(strref) * 0x1A), GEM_STREAM_START) == GEM_ERROR) {
+		Entry* entry = LookupEntry(strref);
+		if (!entry) {
 			return u"";
 		}
-		str->ReadWord(type);
-		str->ReadResRef(SoundResRef);
-		// volume and pitch variance fields are known to be unused at minimum in bg1
-		str->ReadDword(Volume);
-		str->ReadDword(Pitch);
-		str->ReadDword(StrOffset);
-		str->ReadDword(l);
+		type = entry->type;
+		SoundResRef = entry->sound;
 
-		if (type & 1) {
-			if (str->Seek(StrOffset + Offset, GEM_STREAM_START) == GEM_ERROR) {
-				return u"";
+		// without tokens the resolution doesn't depend on anything else, so it can be kept
+		if ((bool(flags & STRING_FLAGS::RESOLVE_TAGS) || (type & 4)) && !entry->hasTags) {
+			if (entry->resolvedValid) {
+				++resolveHits;
+			} else {
+				entry->resolved = ResolveTags(entry->text);
+				entry->resolvedValid = true;
 			}
-			std::string mbstr(l, '\0');
-			str->Read(&mbstr[0], l);
-			string = StringFromTLK(mbstr);
+			string = entry->resolved;
+			resolved = true;
+		} else {
+			string = entry->text;
 		}
 	}
 
-	if (bool(flags & STRING_FLAGS::RESOLVE_TAGS) || (type & 4)) {
+	if (!resolved && (bool(flags & STRING_FLAGS::RESOLVE_TAGS) || (type & 4))) {
 		string = ResolveTags(string);
 	}
 	if ((type & 2) && bool(flags & STRING_FLAGS::SOUND) && !SoundResRef.IsEmpty()) {
@@ -405,13 +537,11 @@ StringBlock TLKImporter::GetStringBlock(ieStrRef strref, STRING_FLAGS flags)
 	if (empty) {
 		return StringBlock();
 	}
-	ieWord type;
-	if (str->Seek(18 + (ieDword(strref) * 0x1A), GEM_STREAM_START) == GEM_ERROR) {
+	const Entry* entry = LookupEntry(strref);
+	if (!entry) {
 		return StringBlock();
 	}
-	str->ReadWord(type);
-	ResRef soundRef;
-	str->ReadResRef(soundRef);
+	ResRef soundRef = entry->sound;
 	return StringBlock(GetString(strref, flags), soundRef);
 }
 
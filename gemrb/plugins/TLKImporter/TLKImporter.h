@@ -26,6 +26,9 @@
 #include "StringMgr.h"
 #include "TlkOverride.h"
 
+#include <list>
+#include <unordered_map>
+
 namespace GemRB {
 
 struct gt_type {
@@ -36,7 +39,32 @@ struct gt_type {
 
 class TLKImporter : public StringMgr {
 private:
+	// decoded string table entry, shared by all the flag combinations
+	struct Entry {
+		ieWord type = 0;
+		ResRef sound;
+		String text;
+		// ResolveTags output, only kept for strings without any <TOKEN>,
+		// since the rest depend on the game state
+		String resolved;
+		bool hasTags = false;
+		bool resolvedValid = false;
+	};
+	using EntryList = std::list<std::pair<ieStrRef, Entry>>;
+
+	static constexpr size_t CACHE_SIZE = 1024;
+
 	DataStream* str = nullptr;
+	// the whole file, when it could be memory mapped
+	const char* view = nullptr;
+	strpos_t viewSize = 0;
+
+	// most recently used entries first
+	EntryList entries;
+	std::unordered_map<ieStrRef, EntryList::iterator> entryIndex;
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	uint64_t resolveHits = 0;
 
 	//Data
 	ieWord Language = 0;
@@ -62,8 +90,12 @@ public:
 	StringBlock GetStringBlock(ieStrRef strref, STRING_FLAGS flags = STRING_FLAGS::NONE) override;
 	bool HasAltTLK() const override;
 	ieStrRef GetNextStrRef() const final { return OverrideTLK->GetNextStrRef(); };
+	std::string GetCacheStats() const override;
 
 private:
+	void MapFile();
+	bool ReadEntry(ieStrRef strref, Entry& entry) const;
+	Entry* LookupEntry(ieStrRef strref);
 	/** resolves day and monthname tokens */
 	void GetMonthName(int dayandmonth);
 	String ResolveTags(const String& source);
@@ -0,0 +1,95 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "../../../core/Logging/Logger.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace GemRB {
+
+class CaptureWriter : public Logger::LogWriter {
+public:
+	std::vector<std::string> messages;
+
+	explicit CaptureWriter(LogLevel level)
+		: Logger::LogWriter(level) {}
+
+	void WriteLogMessage(const Logger::LogMessage& msg) override
+	{
+		messages.push_back(msg.owner + ": " + msg.message);
+	}
+};
+
+TEST(LoggerTest, Order)
+{
+	auto writer = std::make_shared<CaptureWriter>(DEBUG);
+	std::string longMessage(2000, 'x');
+	{
+		Logger logger({});
+		logger.AddLogWriter(writer);
+		for (int i = 0; i < 100; ++i) {
+			logger.LogMsg(MESSAGE, "Test", std::to_string(i).c_str(), Logger::MSG_STYLE);
+		}
+		logger.LogMsg(MESSAGE, "Test", longMessage.c_str(), Logger::MSG_STYLE);
+		// everything still queued gets written on the way out
+	}
+
+	ASSERT_EQ(writer->messages.size(), 101U);
+	for (int i = 0; i < 100; ++i) {
+		EXPECT_EQ(writer->messages[i], "Test: " + std::to_string(i));
+	}
+	EXPECT_EQ(writer->messages[100], "Test: " + longMessage);
+}
+
+TEST(LoggerTest, Levels)
+{
+	Logger logger({});
+	// with no writers yet, everything is kept for the first one
+	EXPECT_TRUE(logger.WantsLevel(DEBUG));
+
+	auto writer = std::make_shared<CaptureWriter>(WARNING);
+	logger.AddLogWriter(writer);
+	EXPECT_TRUE(logger.WantsLevel(ERROR));
+	EXPECT_TRUE(logger.WantsLevel(WARNING));
+	EXPECT_FALSE(logger.WantsLevel(DEBUG));
+	EXPECT_TRUE(logger.WantsLevel(INTERNAL));
+}
+
+TEST(LoggerTest, Drops)
+{
+	// nothing drains the queue without a writer
+	Logger logger({});
+	for (int i = 0; i < 5000; ++i) {
+		logger.LogMsg(DEBUG, "Test", "spam", Logger::MSG_STYLE);
+	}
+	EXPECT_EQ(logger.GetDroppedCount(), 5000U - 4096U);
+
+	auto writer = std::make_shared<CaptureWriter>(DEBUG);
+	logger.AddLogWriter(writer);
+	logger.LogMsg(FATAL, "Test", "done", Logger::MSG_STYLE);
+	// the queued ones come first, then the notice about the dropped ones
+	ASSERT_EQ(writer->messages.size(), 4096U + 2U);
+	EXPECT_EQ(writer->messages[4096], "Logger: The log queue was full, 904 messages were dropped.");
+	EXPECT_EQ(writer->messages.back(), "Test: done");
+}
+
+}
@@ -0,0 +1,87 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+
+#include "Streams/FileCache.h"
+#include "Streams/FileStream.h"
+#include "System/VFS.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+path_t getTempPath();
+
+static void WriteTestFile(const path_t& path, const std::string& contents)
+{
+	FileStream file;
+	ASSERT_TRUE(file.Create(path));
+	file.Write(contents.c_str(), contents.length());
+}
+
+static std::string ReadTestFile(const path_t& path)
+{
+	FileStream file;
+	std::string contents;
+	if (file.Open(path)) {
+		contents.resize(file.Size());
+		file.Read(&contents[0], contents.length());
+	}
+	return contents;
+}
+
+TEST(FileCacheTest, SourceValidation)
+{
+	auto sourcePath = PathJoin(getTempPath(), "test_source.bif");
+	auto cachedPath = PathJoin(getTempPath(), "test_cached.bif");
+	WriteTestFile(sourcePath, "compressed");
+	WriteTestFile(cachedPath, "decompressed");
+
+	// nothing recorded yet
+	EXPECT_FALSE(CacheEntryIsFresh(cachedPath, sourcePath));
+
+	CacheEntrySetSource(cachedPath, sourcePath);
+	EXPECT_TRUE(CacheEntryIsFresh(cachedPath, sourcePath));
+
+	// pretend the source was touched: same contents, other time
+	auto record = ReadTestFile(cachedPath + ".src");
+	uint64_t size = 0;
+	int64_t mtime = 0;
+	ASSERT_TRUE(FileStats(sourcePath, size, mtime));
+	auto hash = record.substr(record.rfind(' ') + 1);
+	WriteTestFile(cachedPath + ".src", fmt::format("{} {} {}", size, mtime - 100, hash));
+	EXPECT_TRUE(CacheEntryIsFresh(cachedPath, sourcePath));
+	EXPECT_EQ(ReadTestFile(cachedPath + ".src"), record);
+
+	// same again, but with different contents
+	WriteTestFile(cachedPath + ".src", fmt::format("{} {} {}", size, mtime - 100, 12345));
+	EXPECT_FALSE(CacheEntryIsFresh(cachedPath, sourcePath));
+
+	CacheEntrySetSource(cachedPath, sourcePath);
+	WriteTestFile(sourcePath, "recompressed");
+	EXPECT_FALSE(CacheEntryIsFresh(cachedPath, sourcePath));
+
+	UnlinkFile(cachedPath);
+	EXPECT_FALSE(CacheEntryIsFresh(cachedPath, sourcePath));
+
+	UnlinkFile(cachedPath + ".src");
+	UnlinkFile(sourcePath);
+}
+
+}
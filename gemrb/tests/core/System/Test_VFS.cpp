@@ -236,6 +236,26 @@ TEST(VFSTest, UnlinkFile)
 	EXPECT_FALSE(FileExists(umlautFilePath));
 }
 
+TEST(VFSTest, FileStats)
+{
+	auto filePath = PathJoin(getTempPath(), "test_stats.txt");
+	{
+		FileStream file;
+		file.Create(filePath);
+		file.Write("12345", 5);
+	}
+
+	uint64_t size = 0;
+	int64_t mtime = 0;
+	EXPECT_TRUE(FileStats(filePath, size, mtime));
+	EXPECT_EQ(size, 5U);
+	EXPECT_NE(mtime, 0);
+	UnlinkFile(filePath);
+
+	EXPECT_FALSE(FileStats(filePath, size, mtime));
+	EXPECT_FALSE(FileStats(getTempPath(), size, mtime));
+}
+
 path_t getTempPath()
 {
 #ifdef WIN32
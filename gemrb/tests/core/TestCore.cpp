@@ -0,0 +1,75 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "TestCore.h"
+
+#include "../../core/Game.h"
+#include "../../core/GameData.h"
+#include "../../core/Interface.h"
+#include "../../core/InterfaceConfig.h"
+#include "../../core/PluginMgr.h"
+#include "../../core/SaveGameMgr.h"
+#include "../../core/Logging/Loggers/Stdio.h"
+#include "../../core/Video/Video.h"
+
+#include <clocale>
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+static Interface* testCore = nullptr;
+
+void RequireCore()
+{
+	if (testCore) return;
+
+	setlocale(LC_ALL, "");
+#if defined(WIN32) || defined(__APPLE__)
+	const char* argv[] = { "tester", "-c", "../demo/tester.cfg" };
+#else
+	const char* argv[] = { "tester", "-c", "../../../demo/tester.cfg" };
+#endif
+	auto cfg = LoadFromArgs(3, const_cast<char**>(argv));
+	ToggleLogging(true);
+	AddLogWriter(createStdioLogWriter());
+	testCore = new Interface(std::move(cfg));
+
+	auto gamStream = gamedata->GetResourceStream("gem-demo", IE_GAM_CLASS_ID);
+	auto gamMgr = GetImporter<SaveGameMgr>(IE_GAM_CLASS_ID, gamStream);
+	core->SetGame(gamMgr->LoadGame(new Game(), 0));
+}
+
+class CoreEnvironment : public testing::Environment {
+public:
+	void TearDown() override
+	{
+		if (!testCore) return;
+
+		// cleanup to prevent a delay and crash on exit
+		delete core->GetGame();
+		core->SetGame(nullptr);
+		VideoDriver.reset();
+		delete testCore;
+		testCore = nullptr;
+	}
+};
+
+static testing::Environment* const coreEnvironment = testing::AddGlobalTestEnvironment(new CoreEnvironment());
+
+}
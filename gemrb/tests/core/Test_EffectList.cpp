@@ -0,0 +1,186 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+
+#include "../../core/EffectList.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace GemRB {
+
+static Effect MakeEffect(ieDword opcode, ieDword param1)
+{
+	Effect fx;
+	fx.Opcode = opcode;
+	fx.Parameter1 = param1;
+	return fx;
+}
+
+static std::vector<ieDword> Params(const EffectList& list)
+{
+	std::vector<ieDword> params;
+	for (const Effect& fx : list) {
+		params.push_back(fx.Parameter1);
+	}
+	return params;
+}
+
+TEST(EffectListTest, Order)
+{
+	EffectList list;
+	list.push_back(MakeEffect(1, 1));
+	list.push_back(MakeEffect(2, 2));
+	list.push_front(MakeEffect(1, 0));
+	EXPECT_EQ(Params(list), std::vector<ieDword>({ 0, 1, 2 }));
+	EXPECT_EQ(list.size(), 3U);
+
+	// like with a list, effects added to the back while iterating are visited, the front ones not
+	std::vector<ieDword> visited;
+	const Effect* first = &list.front();
+	for (const Effect& fx : list) {
+		visited.push_back(fx.Parameter1);
+		if (fx.Parameter1 == 1) {
+			list.push_back(MakeEffect(3, 3));
+			list.push_front(MakeEffect(3, 9));
+		}
+	}
+	EXPECT_EQ(visited, std::vector<ieDword>({ 0, 1, 2, 3 }));
+	// growing didn't move anything
+	EXPECT_EQ(first->Parameter1, 0U);
+	EXPECT_EQ(Params(list), std::vector<ieDword>({ 9, 0, 1, 2, 3 }));
+}
+
+TEST(EffectListTest, EraseAndCompact)
+{
+	EffectList list;
+	for (ieDword i = 0; i < 40; ++i) {
+		list.push_back(MakeEffect(i % 3, i));
+	}
+	for (auto it = list.begin(); it != list.end();) {
+		if (it->Parameter1 % 2) {
+			it = list.erase(it);
+		} else {
+			++it;
+		}
+	}
+	EXPECT_EQ(list.size(), 20U);
+	EXPECT_EQ(list.GetDeadCount(), 20U);
+
+	auto before = Params(list);
+	list.Compact();
+	EXPECT_EQ(list.GetDeadCount(), 0U);
+	EXPECT_EQ(Params(list), before);
+
+	EffectList copy = list;
+	EXPECT_EQ(Params(copy), before);
+}
+
+TEST(EffectListTest, OpcodeIndex)
+{
+	EffectList list;
+	list.push_back(MakeEffect(5, 1));
+	list.push_back(MakeEffect(7, 2));
+	list.push_back(MakeEffect(5, 3));
+	list.push_front(MakeEffect(5, 0));
+
+	std::vector<ieDword> found;
+	for (const Effect& fx : list.WithOpcode(5)) {
+		found.push_back(fx.Parameter1);
+	}
+	EXPECT_EQ(found, std::vector<ieDword>({ 0, 1, 3 }));
+	EXPECT_FALSE(list.WithOpcode(100).begin() != list.WithOpcode(100).end());
+
+	// an effect turning into another opcode moves in the index too
+	for (Effect& fx : list) {
+		if (fx.Parameter1 == 2) {
+			fx.Opcode = 5;
+			list.OpcodeChanged(&fx, 7);
+		}
+	}
+	found.clear();
+	for (const Effect& fx : list.WithOpcode(5)) {
+		found.push_back(fx.Parameter1);
+	}
+	EXPECT_EQ(found, std::vector<ieDword>({ 0, 1, 2, 3 }));
+	EXPECT_FALSE(list.WithOpcode(7).begin() != list.WithOpcode(7).end());
+
+	// dead effects are skipped
+	list.erase(list.begin());
+	found.clear();
+	for (const Effect& fx : list.WithOpcode(5)) {
+		found.push_back(fx.Parameter1);
+	}
+	EXPECT_EQ(found, std::vector<ieDword>({ 1, 2, 3 }));
+}
+
+TEST(EffectListTest, BogusOpcode)
+{
+	// opcodes are read straight from the files, so anything can show up
+	EffectList list;
+	list.push_back(MakeEffect(0xffffffff, 1));
+	list.push_back(MakeEffect(5, 2));
+	list.push_back(MakeEffect(EffectList::MAX_OPCODES, 3));
+	list.push_front(MakeEffect(0xffffffff, 0));
+	EXPECT_EQ(Params(list), std::vector<ieDword>({ 0, 1, 2, 3 }));
+
+	// they share the overflow bucket, but are still told apart
+	std::vector<ieDword> found;
+	for (const Effect& fx : list.WithOpcode(0xffffffff)) {
+		found.push_back(fx.Parameter1);
+	}
+	EXPECT_EQ(found, std::vector<ieDword>({ 0, 1 }));
+	found.clear();
+	for (const Effect& fx : list.WithOpcode(EffectList::MAX_OPCODES)) {
+		found.push_back(fx.Parameter1);
+	}
+	EXPECT_EQ(found, std::vector<ieDword>({ 3 }));
+	EXPECT_FALSE(list.WithOpcode(0xfffffffe).begin() != list.WithOpcode(0xfffffffe).end());
+
+	// moving in and out of the overflow bucket
+	for (Effect& fx : list) {
+		if (fx.Parameter1 == 1) {
+			fx.Opcode = 5;
+			list.OpcodeChanged(&fx, 0xffffffff);
+		} else if (fx.Parameter1 == 2) {
+			fx.Opcode = 0xffffffff;
+			list.OpcodeChanged(&fx, 5);
+		}
+	}
+	found.clear();
+	for (const Effect& fx : list.WithOpcode(0xffffffff)) {
+		found.push_back(fx.Parameter1);
+	}
+	EXPECT_EQ(found, std::vector<ieDword>({ 0, 2 }));
+	found.clear();
+	for (const Effect& fx : list.WithOpcode(5)) {
+		found.push_back(fx.Parameter1);
+	}
+	EXPECT_EQ(found, std::vector<ieDword>({ 1 }));
+
+	list.erase(list.begin());
+	list.Compact();
+	found.clear();
+	for (const Effect& fx : list.WithOpcode(0xffffffff)) {
+		found.push_back(fx.Parameter1);
+	}
+	EXPECT_EQ(found, std::vector<ieDword>({ 2 }));
+}
+
+}
@@ -0,0 +1,74 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "../../core/FrameProfiler.h"
+
+#include "../../core/Streams/FileStream.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace GemRB {
+
+path_t getTempPath();
+
+TEST(FrameProfilerTest, History)
+{
+	FrameProfiler& profiler = FrameProfiler::Get();
+	profiler.SetEnabled(true);
+	ResRef area = "AR0602";
+
+	for (int i = 0; i < 3; ++i) {
+		profiler.Add(ProfilePhase::DrawMap, std::chrono::microseconds(100 * (i + 1)));
+		profiler.Add(ProfilePhase::AreaScripts, std::chrono::microseconds(20), &area);
+		profiler.Add(ProfilePhase::AreaScripts, std::chrono::microseconds(30), &area);
+		profiler.EndFrame();
+	}
+
+	EXPECT_EQ(profiler.GetFrameCount(), 3U);
+	const FrameProfiler::Frame* frame = profiler.GetFrame(0);
+	ASSERT_NE(frame, nullptr);
+	EXPECT_EQ(frame->index, 2U);
+	EXPECT_EQ(frame->phases[ProfilePhase::DrawMap], 300U);
+	EXPECT_EQ(frame->phases[ProfilePhase::AreaScripts], 50U);
+	ASSERT_EQ(frame->areas.size(), 1U);
+	EXPECT_EQ(frame->areas[0].first, area);
+	EXPECT_EQ(frame->areas[0].second, 50U);
+	EXPECT_EQ(profiler.GetFrame(2)->phases[ProfilePhase::DrawMap], 100U);
+	EXPECT_EQ(profiler.GetFrame(3), nullptr);
+
+	path_t path = PathJoin(getTempPath(), "gemrb-profile.csv");
+	EXPECT_TRUE(profiler.DumpCSV(path));
+	std::unique_ptr<FileStream> csv(FileStream::OpenFile(path));
+	ASSERT_NE(csv, nullptr);
+	std::string line;
+	csv->ReadLine(line);
+	EXPECT_EQ(line, "frame,total,GameScripts,AreaScripts,GenerateQueues,UpdateFog,DrawMap,DrawFog,DrawGUI,SwapBuffers,areas");
+	csv->ReadLine(line);
+	EXPECT_EQ(line.find("0,"), 0U);
+	EXPECT_NE(line.find(",0,50,0,0,100,0,0,0,"), std::string::npos);
+	EXPECT_NE(line.find("AR0602:50"), std::string::npos);
+
+	// disabling drops the history
+	profiler.SetEnabled(false);
+	EXPECT_EQ(profiler.GetFrameCount(), 0U);
+	EXPECT_EQ(profiler.GetFrame(0), nullptr);
+}
+
+}
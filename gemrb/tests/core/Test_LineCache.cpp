@@ -0,0 +1,60 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "../../core/LineCache.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+TEST(LineCacheTest, Epochs)
+{
+	LineCache cache;
+	LineCache::Key key;
+	key.s = Point(10, 20);
+	key.d = Point(300, 40);
+	PathMapFlags result = PathMapFlags::UNMARKED;
+
+	EXPECT_FALSE(cache.Lookup(key, 1, result));
+	cache.Store(key, 1, PathMapFlags::SIDEWALL);
+	EXPECT_TRUE(cache.Lookup(key, 1, result));
+	EXPECT_EQ(result, PathMapFlags::SIDEWALL);
+
+	// a searchmap change makes the entry stale
+	EXPECT_FALSE(cache.Lookup(key, 2, result));
+
+	// the caller and the query kind are part of the key
+	LineCache::Key other = key;
+	other.size = 3;
+	EXPECT_FALSE(cache.Lookup(other, 1, result));
+	other = key;
+	other.kind = LineCache::Kind::WalkNavmap;
+	EXPECT_FALSE(cache.Lookup(other, 1, result));
+
+	EXPECT_EQ(cache.GetHits(), 1U);
+	EXPECT_EQ(cache.GetMisses(), 4U);
+	EXPECT_EQ(cache.GetHitRate(), 20U);
+
+	cache.Clear();
+	EXPECT_FALSE(cache.Lookup(key, 1, result));
+	cache.ResetStats();
+	EXPECT_EQ(cache.GetHits() + cache.GetMisses(), 0U);
+}
+
+}
@@ -20,58 +20,34 @@
 // FIXME: remove once fixed, this is excluding non-linux build bots
 #if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
 
-#include "../../core/GameData.h"
+#include "TestCore.h"
+
+#include "../../core/Game.h"
+#include "../../core/Geometry.h"
 #include "../../core/Interface.h"
-#include "../../core/InterfaceConfig.h"
-#include "../../core/Logging/Loggers/Stdio.h"
 #include "../../core/Map.h"
-#include "../../core/PluginMgr.h"
-#include "../../core/SaveGameMgr.h"
+#include "../../core/GameScript/Targets.h"
+#include "../../core/Scriptable/Actor.h"
 
+#include <algorithm>
 #include <gtest/gtest.h>
 
 namespace GemRB {
 
 class MapTest : public testing::Test {
 public:
-	static const Interface* gemrb;
 	static const Map* map;
 
 	// set up core and the first map from the demo
 	static void SetUpTestSuite()
 	{
-		setlocale(LC_ALL, "");
-#if defined(WIN32) || defined(__APPLE__)
-		const char* argv[] = { "tester", "-c", "../demo/tester.cfg" };
-#else
-		const char* argv[] = { "tester", "-c", "../../../demo/tester.cfg" };
-#endif
-		auto cfg = LoadFromArgs(3, const_cast<char**>(argv));
-		ToggleLogging(true);
-		AddLogWriter(createStdioLogWriter());
-		gemrb = new Interface(std::move(cfg));
-
-		auto gamStream = gamedata->GetResourceStream("gem-demo", IE_GAM_CLASS_ID);
-		auto gamMgr = GetImporter<SaveGameMgr>(IE_GAM_CLASS_ID, gamStream);
-		Game* game = gamMgr->LoadGame(new Game(), 0);
-		core->SetGame(game);
-
+		RequireCore();
 		ResRef mapRef { "ar0100" };
-		map = game->GetMap(mapRef, false);
-	}
-
-	static void TearDownTestSuite()
-	{
-		// cleanup to prevent a delay and crash on exit
-		delete core->GetGame();
-		core->SetGame(nullptr);
-		VideoDriver.reset();
-		delete gemrb;
+		map = core->GetGame()->GetMap(mapRef, false);
 	}
 };
 
 const Map* MapTest::map = nullptr;
-const Interface* MapTest::gemrb = nullptr;
 
 static Point badPaths[] = { Point(1270, 640), Point(1071, 699), Point(1170, 967), Point(1126, 601) };
 static Point goodPaths[] = { Point(1126, 601), Point(685, 655), Point(720, 496), Point(1056, 336) };
@@ -153,5 +129,127 @@ TEST_F(MapTest, FindPathTest)
 	EXPECT_TRUE(path);
 	EXPECT_GT(path.Size(), 1);
 }
+
+static unsigned int PathLength(const Path& path, Point from)
+{
+	unsigned int length = 0;
+	for (size_t i = 0; i < path.Size(); i++) {
+		length += Distance(from, path.GetStep(i).point);
+		from = path.GetStep(i).point;
+	}
+	return length;
+}
+
+// compare plain Theta* with the cluster graph assisted search, reporting path length and runtime
+TEST_F(MapTest, FindPathHierarchicalTest)
+{
+	constexpr int circleSize = 2;
+	Map* area = core->GetGame()->GetMap(ResRef("ar0100"), false);
+	static const Point pairs[][2] = {
+		{ badPaths[0], goodPaths[1] },
+		{ goodPaths[1], badPaths[0] },
+		{ badPaths[2], goodPaths[3] },
+		{ goodPaths[2], badPaths[0] },
+	};
+
+	for (const auto& pair : pairs) {
+		area->SetHierarchicalPathfinding(false);
+		Path plain = area->FindPath(pair[0], pair[1], circleSize);
+		area->SetHierarchicalPathfinding(true);
+		Path clustered = area->FindPath(pair[0], pair[1], circleSize);
+
+		EXPECT_EQ(bool(plain), bool(clustered));
+		if (!plain || !clustered) continue;
+
+		unsigned int plainLength = PathLength(plain, pair[0]);
+		unsigned int clusteredLength = PathLength(clustered, pair[0]);
+		EXPECT_LE(clusteredLength, plainLength * 3 / 2);
+	}
+	area->SetHierarchicalPathfinding(false);
+}
+
+// the grid backed proximity queries have to match a plain scan, including the order
+TEST_F(MapTest, ActorQueriesTest)
+{
+	Map* area = core->GetGame()->GetMap(ResRef("ar0100"), false);
+	const auto& actors = area->GetAllActors();
+	constexpr int flags = GA_NO_LOS | GA_NO_UNSCHEDULED;
+
+	for (const Point& p : goodPaths) {
+		for (unsigned int radius : { 1U, 10U, 30U, 100U }) {
+			std::vector<Actor*> expected;
+			for (auto actor : actors) {
+				if (WithinRange(actor, p, radius) && actor->ValidTarget(flags)) expected.push_back(actor);
+			}
+			EXPECT_EQ(area->GetAllActorsInRadius(p, flags, radius), expected);
+		}
+
+		Region rgn(p, Size(400, 300));
+		std::vector<Actor*> expected;
+		for (auto actor : actors) {
+			if (!actor->ValidTarget(0)) continue;
+			if (rgn.PointInside(actor->Pos) || actor->IsOver(rgn.origin)) expected.push_back(actor);
+		}
+		EXPECT_EQ(area->GetActorsInRect(rgn, 0), expected);
+	}
+
+	// moving an actor far away has to update the index
+	auto valid = std::find_if(actors.begin(), actors.end(), [](const Actor* actor) {
+		return actor->ValidTarget(0);
+	});
+	if (valid == actors.end()) return;
+	Actor* actor = *valid;
+	Point oldPos = actor->Pos;
+	Point farAway = Point(area->GetSize().w - 1, area->GetSize().h - 1);
+	actor->SetPos(farAway);
+	// library mode skips InitActors, so the actors don't know their area and can't report moves themselves
+	area->ActorMoved(actor);
+	EXPECT_EQ(area->GetActor(farAway, 0), actor);
+	EXPECT_NE(area->GetActor(oldPos, 0), actor);
+	actor->SetPos(oldPos);
+	area->ActorMoved(actor);
+	EXPECT_EQ(area->GetActor(oldPos, 0), actor);
+}
+
+// targets come out by distance, ties in the order they were added, whether picked by rank or iterated
+TEST_F(MapTest, TargetsOrderTest)
+{
+	const Map* area = core->GetGame()->GetMap(ResRef("ar0100"), false);
+	std::vector<std::pair<unsigned int, Scriptable*>> expected;
+	Targets* tgts = new Targets();
+	unsigned int i = 0;
+	for (auto actor : area->GetAllActors()) {
+		unsigned int distance = (i++ * 7) % 5;
+		tgts->AddTarget(actor, distance, 0);
+		expected.emplace_back(distance, actor);
+	}
+	std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+		return a.first < b.first;
+	});
+
+	ASSERT_EQ(tgts->Count(), expected.size());
+	for (unsigned int n = expected.size(); n--;) {
+		EXPECT_EQ(tgts->GetTarget(n, ST_ANY), expected[n].second);
+	}
+	EXPECT_EQ(tgts->GetTarget(static_cast<unsigned int>(expected.size()), ST_ACTOR), nullptr);
+	if (!expected.empty()) {
+		EXPECT_EQ(tgts->GetLastTarget(ST_ACTOR)->actor, expected.back().second);
+	}
+
+	targetlist::iterator m;
+	const targettype* tt = tgts->GetFirstTarget(m, ST_ACTOR);
+	for (const auto& entry : expected) {
+		ASSERT_NE(tt, nullptr);
+		EXPECT_EQ(tt->actor, entry.second);
+		tt = tgts->GetNextTarget(m, ST_ACTOR);
+	}
+	EXPECT_EQ(tt, nullptr);
+
+	tgts->Pop();
+	if (expected.size() > 1) {
+		EXPECT_EQ(tgts->GetTarget(0, ST_ANY), expected[1].second);
+	}
+	delete tgts;
+}
 }
 #endif
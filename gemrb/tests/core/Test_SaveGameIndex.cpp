@@ -0,0 +1,110 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "../../core/SaveGameIndex.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+path_t getTempPath();
+
+TEST(SaveGameIndexTest, Freshness)
+{
+	SaveGameIndex index(PathJoin(getTempPath(), "gemrb-fresh.idx"));
+	SaveGameIndex::Slot slot;
+	slot.dirTime = 100;
+	slot.checked = 101;
+	slot.valid = true;
+	index.Update("000000001-Test", slot);
+
+	EXPECT_NE(index.Lookup("000000001-Test", 100), nullptr);
+	// the directory changed since
+	EXPECT_EQ(index.Lookup("000000001-Test", 102), nullptr);
+	EXPECT_EQ(index.Lookup("000000002-Other", 100), nullptr);
+
+	// checked in the same second it was changed, so it can't be trusted
+	slot.checked = 100;
+	index.Update("000000001-Test", slot);
+	EXPECT_EQ(index.Lookup("000000001-Test", 100), nullptr);
+
+	EXPECT_FALSE(index.ListingIsFresh(200));
+	index.SetListing(200, 200);
+	EXPECT_FALSE(index.ListingIsFresh(200));
+	index.SetListing(200, 205);
+	EXPECT_TRUE(index.ListingIsFresh(200));
+	EXPECT_FALSE(index.ListingIsFresh(201));
+	index.InvalidateListing();
+	EXPECT_FALSE(index.ListingIsFresh(200));
+}
+
+TEST(SaveGameIndexTest, RetainAndInvalidate)
+{
+	SaveGameIndex index(PathJoin(getTempPath(), "gemrb-retain.idx"));
+	SaveGameIndex::Slot slot;
+	slot.dirTime = 1;
+	slot.checked = 2;
+	index.Update("000000001-A", slot);
+	index.Update("000000002-B", slot);
+	index.Update("000000003-C", slot);
+
+	index.Retain({ "000000001-A", "000000003-C" });
+	index.Invalidate("000000003-C");
+	auto names = index.GetSlotNames();
+	ASSERT_EQ(names.size(), 1U);
+	EXPECT_EQ(names[0], "000000001-A");
+}
+
+TEST(SaveGameIndexTest, RoundTrip)
+{
+	path_t file = PathJoin(getTempPath(), "gemrb-roundtrip.idx");
+	{
+		SaveGameIndex index(file);
+		SaveGameIndex::Slot slot;
+		slot.dirTime = 1700000000;
+		slot.checked = 1700000005;
+		slot.previewTime = 1699999999;
+		slot.portraits = 6;
+		slot.valid = true;
+		// slot names can have spaces in them
+		index.Update("000000007-My Save", slot);
+		slot.valid = false;
+		index.Update("stray dir", slot);
+		index.SetListing(1700000010, 1700000020);
+		EXPECT_TRUE(index.Store());
+	}
+
+	SaveGameIndex index(file);
+	EXPECT_TRUE(index.Load());
+	EXPECT_TRUE(index.ListingIsFresh(1700000010));
+	const SaveGameIndex::Slot* slot = index.Lookup("000000007-My Save", 1700000000);
+	ASSERT_NE(slot, nullptr);
+	EXPECT_EQ(slot->previewTime, 1699999999);
+	EXPECT_EQ(slot->portraits, 6);
+	EXPECT_TRUE(slot->valid);
+	slot = index.Lookup("stray dir", 1700000000);
+	ASSERT_NE(slot, nullptr);
+	EXPECT_FALSE(slot->valid);
+
+	SaveGameIndex missing(PathJoin(getTempPath(), "gemrb-missing.idx"));
+	EXPECT_FALSE(missing.Load());
+	EXPECT_TRUE(missing.GetSlotNames().empty());
+}
+
+}
@@ -0,0 +1,156 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "TestCore.h"
+
+#include "../../core/EffectQueue.h"
+#include "../../core/StatCache.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace GemRB {
+
+static EffectRef fx_alchemy_ref = { "AlchemyModifier", -1 };
+static EffectRef fx_castingspeed_ref = { "CastingSpeedModifier", -1 };
+static EffectRef fx_save_vs_death_ref = { "SaveVsDeathModifier", -1 };
+static EffectRef fx_save_vs_wands_ref = { "SaveVsWandsModifier", -1 };
+static EffectRef fx_save_bonus_ref = { "SaveBonus", -1 };
+
+class StatCacheTest : public testing::Test {
+protected:
+	std::unique_ptr<Actor> actor;
+	Actor::stats_t starting {};
+	StatCache cache;
+
+	static void SetUpTestSuite()
+	{
+		RequireCore();
+	}
+
+	void SetUp() override
+	{
+		actor = std::make_unique<Actor>();
+		actor->BaseStats[IE_ALCHEMY] = 10;
+		actor->BaseStats[IE_MENTALSPEED] = 4;
+		starting = actor->BaseStats;
+	}
+
+	Effect* Add(EffectRef& ref, ieDword param1, ieDword param2)
+	{
+		Effect* fx = EffectQueue::CreateEffect(ref, param1, param2, FX_DURATION_INSTANT_WHILE_EQUIPPED);
+		EXPECT_NE(fx, nullptr) << ref.Name;
+		if (!fx) return nullptr;
+		// only effects that were applied before can be skipped
+		fx->FirstApply = 0;
+		actor->fxqueue.AddEffect(fx);
+		auto it = actor->fxqueue.GetFirstEffect();
+		Effect* added = nullptr;
+		while (Effect* next = actor->fxqueue.GetNextEffect(it)) {
+			added = next;
+		}
+		return added;
+	}
+
+	// the cache has to end up with the same stats as applying the whole queue
+	void ExpectSameAsFull()
+	{
+		actor->Modified = starting;
+		cache.Apply(actor.get(), false);
+		Actor::stats_t incremental = actor->Modified;
+
+		actor->Modified = starting;
+		actor->fxqueue.ApplyAllEffects(actor.get());
+		for (unsigned int stat = 0; stat < MAX_STATS; ++stat) {
+			EXPECT_EQ(incremental[stat], actor->Modified[stat]) << "stat: " << stat;
+		}
+	}
+};
+
+TEST_F(StatCacheTest, ReplayMatchesFullRefresh)
+{
+	// the order matters, since some of them set the stat outright
+	Effect* first = Add(fx_alchemy_ref, 5, MOD_ADDITIVE);
+	Add(fx_castingspeed_ref, 2, MOD_ADDITIVE);
+	Effect* absolute = Add(fx_alchemy_ref, 20, MOD_ABSOLUTE);
+	Add(fx_castingspeed_ref, 1, MOD_ADDITIVE);
+	Add(fx_alchemy_ref, 3, MOD_ADDITIVE);
+	ExpectSameAsFull();
+	EXPECT_EQ(actor->Modified[IE_ALCHEMY], 23U);
+	EXPECT_EQ(actor->Modified[IE_MENTALSPEED], 7U);
+
+	// nothing changed, so nothing is replayed
+	uint64_t skipped = cache.GetSkipped();
+	ExpectSameAsFull();
+	EXPECT_EQ(cache.GetSkipped(), skipped + 5);
+
+	// removing one in the middle only replays the effects on its stat
+	absolute->TimingMode = FX_DURATION_JUST_EXPIRED;
+	skipped = cache.GetSkipped();
+	ExpectSameAsFull();
+	EXPECT_EQ(cache.GetSkipped(), skipped + 2);
+	EXPECT_EQ(actor->Modified[IE_ALCHEMY], 18U);
+
+	// a new one at the end, based on the base stat
+	Add(fx_castingspeed_ref, 50, MOD_PERCENT);
+	ExpectSameAsFull();
+
+	// a changed one is like removing it and adding another
+	first->Parameter1 = 7;
+	ExpectSameAsFull();
+
+	// different starting stats
+	starting[IE_ALCHEMY] = 12;
+	ExpectSameAsFull();
+	actor->BaseStats[IE_MENTALSPEED] = 8;
+	starting[IE_MENTALSPEED] = 8;
+	ExpectSameAsFull();
+	EXPECT_EQ(actor->Modified[IE_MENTALSPEED], 4U);
+}
+
+// replaying one effect makes the other stats it writes dirty too
+TEST_F(StatCacheTest, DirtyStatsSpread)
+{
+	// the bonus writes all the saves, so it links the other two
+	Add(fx_save_vs_death_ref, 2, 0);
+	Add(fx_save_bonus_ref, 1, MOD_ADDITIVE);
+	Add(fx_save_vs_wands_ref, 3, 0);
+	Add(fx_alchemy_ref, 4, MOD_ADDITIVE);
+	starting[IE_SAVEVSDEATH] = 10;
+	starting[IE_SAVEVSWANDS] = 10;
+	ExpectSameAsFull();
+
+	// only death changed, but the bonus has to be replayed and with it wands
+	uint64_t skipped = cache.GetSkipped();
+	starting[IE_SAVEVSDEATH] = 12;
+	ExpectSameAsFull();
+	EXPECT_EQ(cache.GetSkipped(), skipped + 1);
+
+	// and the other way around
+	skipped = cache.GetSkipped();
+	starting[IE_SAVEVSWANDS] = 8;
+	ExpectSameAsFull();
+	EXPECT_EQ(cache.GetSkipped(), skipped + 1);
+}
+
+}
+#endif
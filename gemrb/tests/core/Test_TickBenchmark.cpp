@@ -0,0 +1,87 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2026 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "../../core/TickBenchmark.h"
+
+#include "../../core/Streams/MemoryStream.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace GemRB {
+
+static std::unique_ptr<MemoryStream> MakeStream(const char* text)
+{
+	size_t len = strlen(text);
+	void* data = malloc(len);
+	memcpy(data, text, len);
+	return std::make_unique<MemoryStream>("replay", data, len);
+}
+
+TEST(TickBenchmarkTest, LoadReplay)
+{
+	auto stream = MakeStream("# warm up first\n"
+					 "30 1 MoveToPoint([1200.900])\n"
+					 "\n"
+					 "5\tImoen  Attack(\"Gorion\")  # tabs and comments\r\n"
+					 "30 2 Wait(1)\n");
+	TickBenchmark bench;
+	ASSERT_TRUE(bench.LoadReplay(*stream));
+
+	const auto& replay = bench.GetReplay();
+	ASSERT_EQ(replay.size(), 3U);
+	EXPECT_EQ(replay[0].tick, 5U);
+	EXPECT_EQ(replay[0].actor, "Imoen");
+	EXPECT_EQ(replay[0].action, "Attack(\"Gorion\")");
+	// same tick, so the file order is kept
+	EXPECT_EQ(replay[1].action, "MoveToPoint([1200.900])");
+	EXPECT_EQ(replay[2].actor, "2");
+}
+
+TEST(TickBenchmarkTest, MalformedReplay)
+{
+	auto stream = MakeStream("10 1 Wait(1)\nsoon 1 Wait(1)\n");
+	TickBenchmark bench;
+	EXPECT_FALSE(bench.LoadReplay(*stream));
+	EXPECT_TRUE(bench.GetReplay().empty());
+
+	auto noAction = MakeStream("10 1\n");
+	EXPECT_FALSE(bench.LoadReplay(*noAction));
+}
+
+TEST(TickBenchmarkTest, PhaseStats)
+{
+	TickBenchmark bench;
+	FrameProfiler::Frame frame;
+	frame.phases[ProfilePhase::GameScripts] = 40;
+	frame.phases[ProfilePhase::AreaScripts] = 25;
+	bench.AddTick(frame);
+	frame.phases[ProfilePhase::GameScripts] = 60;
+	bench.AddTick(frame);
+
+	EXPECT_EQ(bench.GetTicks(), 2U);
+	EXPECT_EQ(bench.GetPhase(ProfilePhase::GameScripts).total, 100U);
+	EXPECT_EQ(bench.GetPhase(ProfilePhase::GameScripts).max, 60U);
+	EXPECT_EQ(bench.GetPhase(ProfilePhase::AreaScripts).total, 50U);
+	EXPECT_EQ(bench.GetPhase(ProfilePhase::DrawMap).total, 0U);
+}
+
+}